@@ -0,0 +1,226 @@
+#include "Bench.h"
+#include <Hazelnupp/ParseResult.h>
+#include <Hazelnupp/StringTools.h>
+#include <string>
+#include <vector>
+
+using namespace Bench;
+using namespace Hazelnp;
+
+namespace
+{
+	// Numbers in every notation LexNumber() understands, and something that is no number
+	const std::string_view numbers[] = { "12345", "-0x1F", "0o17", "0b1011", "1.5e-3", "-3.14159", "billybob" };
+	constexpr std::size_t numNumbers = sizeof(numbers) / sizeof(numbers[0]);
+}
+
+void Bench::RegisterAccessorBenchmarks(Runner& runner)
+{
+	// Value accessors
+	{
+		CommandLine commandLine;
+		commandLine.Add("/usr/bin/app");
+		commandLine.Add("--int");
+		commandLine.Add("12345");
+		commandLine.Add("--float");
+		commandLine.Add("1.5e3");
+		commandLine.Add("--string");
+		commandLine.Add("billybob");
+		commandLine.Add("--list");
+		for (std::size_t i = 0; i < 64; i++)
+			commandLine.Add(std::to_string(i));
+
+		Schema schema;
+		const ParamHandle<int> handle = schema.RegisterParameter<int>("--int");
+		schema.Freeze();
+
+		ParseResult result(schema);
+		result.Parse(commandLine.Argc(), commandLine.Argv());
+
+		const std::string key = "--string";
+		const Value& integer = result["--int"];
+		const Value& floating = result["--float"];
+		const Value& string = result["--string"];
+		const Value& list = result["--list"];
+
+		runner.Run("value/get_int64", {}, 1, [&]
+			{
+				DoNotOptimize(integer.GetInt64());
+				return;
+			});
+
+		runner.Run("value/get_float64", {}, 1, [&]
+			{
+				DoNotOptimize(floating.GetFloat64());
+				return;
+			});
+
+		runner.Run("value/get_string_view", {}, 1, [&]
+			{
+				DoNotOptimize(string.GetStringView());
+				return;
+			});
+
+		runner.Run("value/get_string", {}, 1, [&]
+			{
+				DoNotOptimize(string.GetString());
+				return;
+			});
+
+		runner.Run("value/get_list", { { "elements", 64 } }, 64, [&]
+			{
+				long long int sum = 0;
+				for (const Value* element : list.GetList())
+					sum += element->GetInt64();
+
+				DoNotOptimize(sum);
+				return;
+			});
+
+		runner.Run("value/get_int_list", { { "elements", 64 } }, 64, [&]
+			{
+				long long int sum = 0;
+				for (const long long int element : list.GetIntList())
+					sum += element;
+
+				DoNotOptimize(sum);
+				return;
+			});
+
+		runner.Run("value/get_as_os_string", { { "elements", 64 } }, 64, [&]
+			{
+				DoNotOptimize(list.GetAsOsString());
+				return;
+			});
+
+		runner.Run("parseresult/lookup_by_key", {}, 1, [&]
+			{
+				DoNotOptimize(&result[key]);
+				return;
+			});
+
+		runner.Run("parseresult/lookup_by_handle", {}, 1, [&]
+			{
+				DoNotOptimize(result[handle]);
+				return;
+			});
+	}
+
+	// StringTools
+	{
+		runner.Run("stringtools/lex_number", { { "inputs", numNumbers } }, numNumbers, [&]
+			{
+				for (const std::string_view number : numbers)
+				{
+					long long int integer = 0;
+					long double floating = 0;
+					DoNotOptimize(Internal::StringTools::LexNumber(number, integer, floating));
+					DoNotOptimize(integer);
+					DoNotOptimize(floating);
+				}
+
+				return;
+			});
+
+		runner.Run("stringtools/parse_number", { { "inputs", numNumbers } }, numNumbers, [&]
+			{
+				for (const std::string_view number : numbers)
+				{
+					bool isInt = false;
+					long double value = 0;
+					DoNotOptimize(Internal::StringTools::ParseNumber(number, isInt, value));
+					DoNotOptimize(value);
+				}
+
+				return;
+			});
+
+		runner.Run("stringtools/is_numeric", { { "inputs", numNumbers } }, numNumbers, [&]
+			{
+				for (const std::string_view number : numbers)
+					DoNotOptimize(Internal::StringTools::IsNumeric(number, true));
+
+				return;
+			});
+
+		// Bulk list conversion, against converting each token on its own
+		std::vector<std::string> integerTokens;
+		std::vector<std::string> floatTokens;
+		for (std::size_t i = 0; i < 4096; i++)
+		{
+			integerTokens.push_back(std::to_string(i * 7919));
+			floatTokens.push_back(std::to_string(i * 7919) + "." + std::to_string(i % 1000));
+		}
+
+		const std::vector<std::string_view> integerViews(integerTokens.begin(), integerTokens.end());
+		const std::vector<std::string_view> floatViews(floatTokens.begin(), floatTokens.end());
+		std::vector<long long int> integers(integerViews.size());
+		std::vector<long double> floats(floatViews.size());
+
+		runner.Run("stringtools/lex_integers", { { "tokens", integerViews.size() } }, integerViews.size(), [&]
+			{
+				DoNotOptimize(Internal::StringTools::LexIntegers(integerViews.data(), integerViews.size(), integers.data()));
+				return;
+			});
+
+		runner.Run("stringtools/lex_number_integers", { { "tokens", integerViews.size() } }, integerViews.size(), [&]
+			{
+				long double floating;
+				for (std::size_t i = 0; i < integerViews.size(); i++)
+					DoNotOptimize(Internal::StringTools::LexNumber(integerViews[i], integers[i], floating));
+
+				return;
+			});
+
+		runner.Run("stringtools/lex_floats", { { "tokens", floatViews.size() } }, floatViews.size(), [&]
+			{
+				DoNotOptimize(Internal::StringTools::LexFloats(floatViews.data(), floatViews.size(), floats.data()));
+				return;
+			});
+
+		runner.Run("stringtools/lex_number_floats", { { "tokens", floatViews.size() } }, floatViews.size(), [&]
+			{
+				long long int integer;
+				for (std::size_t i = 0; i < floatViews.size(); i++)
+					DoNotOptimize(Internal::StringTools::LexNumber(floatViews[i], integer, floats[i]));
+
+				return;
+			});
+
+		std::string csv;
+		for (std::size_t i = 0; i < 64; i++)
+			csv += (i > 0 ? "," : "") + std::to_string(i);
+
+		runner.Run("stringtools/split_string", { { "fields", 64 } }, 64, [&]
+			{
+				DoNotOptimize(Internal::StringTools::SplitString(csv, ','));
+				return;
+			});
+
+		runner.Run("stringtools/split_string_by_string", { { "fields", 64 } }, 64, [&]
+			{
+				DoNotOptimize(Internal::StringTools::SplitString(csv, std::string(",")));
+				return;
+			});
+
+		runner.Run("stringtools/replace", { { "length", csv.length() } }, csv.length(), [&]
+			{
+				DoNotOptimize(Internal::StringTools::Replace(csv, ',', "; "));
+				return;
+			});
+
+		runner.Run("stringtools/to_lower", { { "length", csv.length() } }, csv.length(), [&]
+			{
+				DoNotOptimize(Internal::StringTools::ToLower(csv));
+				return;
+			});
+
+		runner.Run("stringtools/contains", { { "length", csv.length() } }, csv.length(), [&]
+			{
+				DoNotOptimize(Internal::StringTools::Contains(csv, ';'));
+				return;
+			});
+	}
+
+	return;
+}
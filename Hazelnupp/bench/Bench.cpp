@@ -0,0 +1,183 @@
+#include "Bench.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+using namespace Bench;
+
+namespace
+{
+	// A sample should take at least this long, for the clock to be precise enough
+	constexpr std::chrono::nanoseconds minSampleTime = std::chrono::microseconds(20);
+
+	constexpr std::size_t minSamples = 10;
+	constexpr std::size_t maxSamples = 100000;
+
+	// Will return the quantile q of sorted values
+	double Quantile(const std::vector<double>& sorted, double q)
+	{
+		const std::size_t index = (std::size_t)(q * (double)(sorted.size() - 1) + 0.5);
+		return sorted[std::min(index, sorted.size() - 1)];
+	}
+
+	void WriteJsonString(std::ostream& os, const std::string& str)
+	{
+		os << '"';
+		for (const char c : str)
+		{
+			if ((c == '"') || (c == '\\'))
+				os << '\\' << c;
+			else if ((unsigned char)c < 0x20)
+				os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c << std::dec << std::setfill(' ');
+			else
+				os << c;
+		}
+		os << '"';
+
+		return;
+	}
+}
+
+Runner::Runner(double minSeconds, const std::string& filter)
+	:
+	minSeconds { minSeconds },
+	filter { filter }
+{
+	return;
+}
+
+bool Runner::Matches(const std::string& name) const
+{
+	return name.find(filter) != std::string::npos;
+}
+
+const std::vector<Result>& Runner::GetResults() const
+{
+	return results;
+}
+
+void Runner::Measure(const std::string& name, const Params& params, std::size_t itemsPerOp, const std::function<void(std::size_t)>& batch)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	// Warm up, and find out how many operations make a sample measurable
+	std::size_t opsPerSample = 1;
+	while (true)
+	{
+		const Clock::time_point begin = Clock::now();
+		batch(opsPerSample);
+		const Clock::duration took = Clock::now() - begin;
+
+		if ((took >= minSampleTime) || (opsPerSample >= ((std::size_t)1 << 30)))
+			break;
+
+		opsPerSample *= 2;
+	}
+
+	// Sample
+	std::vector<double> samples;
+	const Clock::time_point start = Clock::now();
+	const Clock::duration minTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(minSeconds));
+
+	while ((samples.size() < minSamples) || ((Clock::now() - start < minTime) && (samples.size() < maxSamples)))
+	{
+		const Clock::time_point begin = Clock::now();
+		batch(opsPerSample);
+		const Clock::time_point end = Clock::now();
+
+		samples.push_back(std::chrono::duration<double, std::nano>(end - begin).count() / (double)opsPerSample);
+	}
+
+	double sum = 0;
+	for (const double sample : samples)
+		sum += sample;
+
+	std::sort(samples.begin(), samples.end());
+
+	Result result;
+	result.name = name;
+	result.params = params;
+	result.itemsPerOp = itemsPerOp;
+	result.numSamples = samples.size();
+	result.opsPerSample = opsPerSample;
+	result.minNs = samples.front();
+	result.medianNs = Quantile(samples, 0.5);
+	result.p90Ns = Quantile(samples, 0.9);
+	result.p99Ns = Quantile(samples, 0.99);
+	result.maxNs = samples.back();
+	result.meanNs = sum / (double)samples.size();
+	result.opsPerSecond = 1e9 / result.medianNs;
+	result.itemsPerSecond = result.opsPerSecond * (double)itemsPerOp;
+
+	// Progress goes to stderr, so that stdout can take the JSON
+	std::cerr << std::left << std::setw(40) << name;
+	for (const auto& param : params)
+		std::cerr << ' ' << param.first << '=' << param.second;
+	std::cerr << "   median " << result.medianNs << " ns   p99 " << result.p99Ns << " ns" << std::endl;
+
+	results.push_back(std::move(result));
+
+	return;
+}
+
+void Runner::WriteJson(std::ostream& os) const
+{
+	os << std::setprecision(6);
+
+	os << "{\n";
+	os << "  \"context\": {\n";
+#if defined(__clang__)
+	os << "    \"compiler\": \"clang " << __clang_major__ << '.' << __clang_minor__ << "\",\n";
+#elif defined(__GNUC__)
+	os << "    \"compiler\": \"gcc " << __GNUC__ << '.' << __GNUC_MINOR__ << "\",\n";
+#elif defined(_MSC_VER)
+	os << "    \"compiler\": \"msvc " << _MSC_VER << "\",\n";
+#else
+	os << "    \"compiler\": \"unknown\",\n";
+#endif
+#ifdef NDEBUG
+	os << "    \"assertions\": false,\n";
+#else
+	os << "    \"assertions\": true,\n";
+#endif
+	os << "    \"min_seconds\": " << minSeconds << "\n";
+	os << "  },\n";
+
+	os << "  \"benchmarks\": [";
+	for (std::size_t i = 0; i < results.size(); i++)
+	{
+		const Result& result = results[i];
+
+		os << (i > 0 ? ",\n" : "\n");
+		os << "    {\n";
+		os << "      \"name\": ";
+		WriteJsonString(os, result.name);
+		os << ",\n";
+
+		os << "      \"params\": {";
+		for (std::size_t j = 0; j < result.params.size(); j++)
+		{
+			os << (j > 0 ? ", " : " ");
+			WriteJsonString(os, result.params[j].first);
+			os << ": " << result.params[j].second;
+		}
+		os << (result.params.empty() ? "},\n" : " },\n");
+
+		os << "      \"items_per_op\": " << result.itemsPerOp << ",\n";
+		os << "      \"samples\": " << result.numSamples << ",\n";
+		os << "      \"ops_per_sample\": " << result.opsPerSample << ",\n";
+		os << "      \"min_ns\": " << result.minNs << ",\n";
+		os << "      \"median_ns\": " << result.medianNs << ",\n";
+		os << "      \"p90_ns\": " << result.p90Ns << ",\n";
+		os << "      \"p99_ns\": " << result.p99Ns << ",\n";
+		os << "      \"max_ns\": " << result.maxNs << ",\n";
+		os << "      \"mean_ns\": " << result.meanNs << ",\n";
+		os << "      \"ops_per_second\": " << result.opsPerSecond << ",\n";
+		os << "      \"items_per_second\": " << result.itemsPerSecond << "\n";
+		os << "    }";
+	}
+	os << (results.empty() ? "]\n" : "\n  ]\n");
+	os << "}\n";
+
+	return;
+}
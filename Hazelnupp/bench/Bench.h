@@ -0,0 +1,137 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Bench
+{
+	//! Will keep the compiler from optimizing value, and whatever computed it, away
+	template <typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+		return;
+	}
+
+	/** Owns the tokens of a command line, and provides them as argc and argv.
+	*/
+	class CommandLine
+	{
+	public:
+		//! Will append a token
+		void Add(const std::string& token)
+		{
+			tokens.push_back(token);
+			argv.push_back(tokens.back().c_str());
+			return;
+		}
+
+		int Argc() const
+		{
+			return (int)argv.size();
+		}
+
+		const char* const* Argv() const
+		{
+			return argv.data();
+		}
+
+	private:
+		//! A deque, so that adding tokens never moves the others
+		std::deque<std::string> tokens;
+		std::vector<const char*> argv;
+	};
+
+	//! What a benchmark got run with, like the amount of arguments. Counts only, to be easy to plot.
+	typedef std::vector<std::pair<std::string, std::size_t>> Params;
+
+	//! Measurements of one benchmark. Times are per operation.
+	struct Result
+	{
+		std::string name;
+		Params params;
+
+		//! How many items, like arguments or list elements, one operation processes
+		std::size_t itemsPerOp = 1;
+
+		std::size_t numSamples = 0;
+		std::size_t opsPerSample = 0;
+
+		double minNs = 0;
+		double medianNs = 0;
+		double p90Ns = 0;
+		double p99Ns = 0;
+		double maxNs = 0;
+		double meanNs = 0;
+
+		double opsPerSecond = 0;
+		double itemsPerSecond = 0;
+	};
+
+	/** Runs benchmarks, and collects their results.
+	* Each benchmark gets sampled repeatedly for at least minSeconds. A sample runs the operation as often as needed to be measurable.
+	*/
+	class Runner
+	{
+	public:
+		//! Only benchmarks whose name contains filter get run
+		Runner(double minSeconds, const std::string& filter);
+
+		//! Will measure op, if name matches the filter. itemsPerOp are used to compute the throughput.
+		template <typename Op>
+		void Run(const std::string& name, const Params& params, std::size_t itemsPerOp, Op&& op)
+		{
+			if (!Matches(name))
+				return;
+
+			Measure(name, params, itemsPerOp, [&op](std::size_t numOps)
+				{
+					for (std::size_t i = 0; i < numOps; i++)
+						op();
+
+					return;
+				});
+
+			return;
+		}
+
+		//! Will write all results as JSON
+		void WriteJson(std::ostream& os) const;
+
+		//! Returns whether or not a benchmark of this name would get run
+		bool Matches(const std::string& name) const;
+
+		const std::vector<Result>& GetResults() const;
+
+	private:
+		//! Will run batch with growing amounts of operations, until a sample takes long enough, and then sample it
+		void Measure(const std::string& name, const Params& params, std::size_t itemsPerOp, const std::function<void(std::size_t)>& batch);
+
+		double minSeconds;
+		std::string filter;
+		std::vector<Result> results;
+	};
+
+	//! Parse() throughput and latency, as argv length, schema size, list length and abbreviation count grow
+	void RegisterParseBenchmarks(Runner& runner);
+
+	//! Rendering the documentation, cached and from scratch, and documenting single parameters
+	void RegisterDocumentationBenchmarks(Runner& runner);
+
+	//! Value accessors, and the StringTools functions the parser relies on
+	void RegisterAccessorBenchmarks(Runner& runner);
+
+	//! Will replay recorded command lines. Each file holds one command line per line, with the executable first.  
+	//! Tokens are separated by whitespace, and may be quoted with "".
+	void RegisterCorpusBenchmarks(Runner& runner, const std::vector<std::string>& corpora);
+}
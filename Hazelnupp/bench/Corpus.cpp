@@ -0,0 +1,76 @@
+#include "Bench.h"
+#include <Hazelnupp/ParseResult.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace Bench;
+using namespace Hazelnp;
+
+namespace
+{
+	// Will read one command line per line. Empty lines, and lines beginning with #, are skipped.
+	std::vector<std::unique_ptr<CommandLine>> ReadCorpus(const std::string& path, std::size_t& out_numTokens)
+	{
+		std::vector<std::unique_ptr<CommandLine>> commandLines;
+		out_numTokens = 0;
+
+		std::ifstream file(path);
+		std::string line;
+		while (std::getline(file, line))
+		{
+			if ((line.empty()) || (line[0] == '#'))
+				continue;
+
+			std::unique_ptr<CommandLine> commandLine = std::make_unique<CommandLine>();
+
+			std::istringstream tokens(line);
+			std::string token;
+			while (tokens >> std::quoted(token))
+				commandLine->Add(token);
+
+			out_numTokens += commandLine->Argc();
+			commandLines.push_back(std::move(commandLine));
+		}
+
+		return commandLines;
+	}
+}
+
+void Bench::RegisterCorpusBenchmarks(Runner& runner, const std::vector<std::string>& corpora)
+{
+	for (const std::string& path : corpora)
+	{
+		const std::string name = "corpus/" + std::filesystem::path(path).stem().string();
+		if (!runner.Matches(name))
+			continue;
+
+		std::size_t numTokens = 0;
+		const std::vector<std::unique_ptr<CommandLine>> commandLines = ReadCorpus(path, numTokens);
+		if (commandLines.empty())
+		{
+			std::cerr << "Skipping empty or unreadable corpus " << path << std::endl;
+			continue;
+		}
+
+		// Real applications know their parameters, but not these. So the schema stays empty.
+		Schema schema;
+		schema.Freeze();
+		ParseResult result(schema);
+
+		// One operation replays the whole corpus
+		runner.Run(name, { { "command_lines", commandLines.size() } }, numTokens, [&]
+			{
+				for (const std::unique_ptr<CommandLine>& commandLine : commandLines)
+					result.Parse(commandLine->Argc(), commandLine->Argv());
+
+				return;
+			});
+	}
+
+	return;
+}
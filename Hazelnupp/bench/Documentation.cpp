@@ -0,0 +1,52 @@
+#include "Bench.h"
+#include <Hazelnupp/Schema.h>
+#include <string>
+
+using namespace Bench;
+using namespace Hazelnp;
+
+void Bench::RegisterDocumentationBenchmarks(Runner& runner)
+{
+	for (const std::size_t numParameters : { 16, 256, 4096 })
+	{
+		// Every parameter has a description, an abbreviation and a constraint
+		Schema schema;
+		schema.SetBriefDescription("Benchmarks the documentation.");
+		for (std::size_t i = 0; i < numParameters; i++)
+		{
+			const std::string key = "--option-" + std::to_string(i);
+			schema.RegisterDescription(key, "Does the thing number " + std::to_string(i) + ", but only if asked to do so very nicely");
+			schema.RegisterAbbreviation("-o" + std::to_string(i), key);
+			schema.RegisterConstraint(key, ParamConstraint(true, DATA_TYPE::INT, { std::to_string(i) }, false, {}));
+		}
+
+		const std::string key = "--option-" + std::to_string(numParameters / 2);
+
+		runner.Run("documentation/cached", { { "parameters", numParameters } }, numParameters, [&]
+			{
+				DoNotOptimize(schema.GenerateDocumentation().data());
+				return;
+			});
+
+		// Any change drops the cache, so this renders from scratch every time
+		for (const std::size_t width : { 0, 80 })
+		{
+			schema.SetDocumentationWidth(width);
+
+			runner.Run(width == 0 ? "documentation/render" : "documentation/render_wrapped", { { "parameters", numParameters } }, numParameters, [&]
+				{
+					schema.SetBriefDescription("Benchmarks the documentation.");
+					DoNotOptimize(schema.GenerateDocumentation().data());
+					return;
+				});
+		}
+
+		runner.Run("documentation/parameter", { { "parameters", numParameters } }, 1, [&]
+			{
+				DoNotOptimize(schema.GenerateParameterDocumentation(key));
+				return;
+			});
+	}
+
+	return;
+}
@@ -0,0 +1,264 @@
+#include "Bench.h"
+#include <Hazelnupp/ParseResult.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace Bench;
+using namespace Hazelnp;
+
+namespace
+{
+	// Will append a value of a rotating type, so that conversion gets exercised like on real command lines
+	void AddValue(CommandLine& commandLine, std::size_t i)
+	{
+		switch (i % 3)
+		{
+		case 0:
+			commandLine.Add(std::to_string(i));
+			break;
+		case 1:
+			commandLine.Add(std::to_string(i) + ".5");
+			break;
+		default:
+			commandLine.Add("value-" + std::to_string(i));
+			break;
+		}
+
+		return;
+	}
+}
+
+void Bench::RegisterParseBenchmarks(Runner& runner)
+{
+	// Argv length, against an empty schema
+	for (const std::size_t numArgs : { 8, 64, 512, 4096 })
+	{
+		CommandLine commandLine;
+		commandLine.Add("/usr/bin/app");
+		for (std::size_t i = 0; i < numArgs / 2; i++)
+		{
+			commandLine.Add("--key-" + std::to_string(i));
+			AddValue(commandLine, i);
+		}
+
+		Schema schema;
+		schema.Freeze();
+		ParseResult result(schema);
+
+		runner.Run("parse/argv_length", { { "args", numArgs } }, numArgs, [&]
+			{
+				result.Parse(commandLine.Argc(), commandLine.Argv());
+				return;
+			});
+	}
+
+	// Schema size. Every constraint enforces a type, and every eighth has a default value.
+	for (const std::size_t numConstraints : { 0, 16, 256, 4096 })
+	{
+		Schema schema;
+		for (std::size_t i = 0; i < numConstraints; i++)
+		{
+			ParamConstraint constraint = ParamConstraint::TypeSafety(DATA_TYPE::INT);
+			if (i % 8 == 7)
+				constraint.defaultValue = { std::to_string(i) };
+
+			schema.RegisterConstraint("--option-" + std::to_string(i), constraint);
+		}
+		schema.Freeze();
+
+		CommandLine commandLine;
+		commandLine.Add("/usr/bin/app");
+		for (std::size_t i = 0; i < 16; i++)
+		{
+			commandLine.Add("--option-" + std::to_string(i));
+			commandLine.Add(std::to_string(i));
+		}
+
+		ParseResult result(schema);
+
+		runner.Run("parse/schema_size", { { "constraints", numConstraints } }, 32, [&]
+			{
+				result.Parse(commandLine.Argc(), commandLine.Argv());
+				return;
+			});
+	}
+
+	// List length, eagerly and lazily converted
+	for (const bool lazy : { false, true })
+		for (const std::size_t listLength : { 1, 16, 256, 4096 })
+		{
+			CommandLine commandLine;
+			commandLine.Add("/usr/bin/app");
+			commandLine.Add("--values");
+			for (std::size_t i = 0; i < listLength; i++)
+				AddValue(commandLine, i);
+
+			Schema schema;
+			schema.Freeze();
+			ParseResult result(schema);
+			result.SetLazyConversion(lazy);
+
+			runner.Run(lazy ? "parse/list_length_lazy" : "parse/list_length", { { "elements", listLength } }, listLength, [&]
+				{
+					result.Parse(commandLine.Argc(), commandLine.Argv());
+					return;
+				});
+		}
+
+	// Homogeneous numeric lists, converted in bulk into contiguous storage
+	for (const std::size_t listLength : { 16, 256, 4096, 65536 })
+	{
+		CommandLine ints;
+		CommandLine floats;
+		ints.Add("/usr/bin/app");
+		ints.Add("--ids");
+		floats.Add("/usr/bin/app");
+		floats.Add("--coordinates");
+		for (std::size_t i = 0; i < listLength; i++)
+		{
+			ints.Add(std::to_string(i * 7919));
+			floats.Add(std::to_string(i * 7919) + ".25");
+		}
+
+		Schema schema;
+		schema.Freeze();
+		ParseResult result(schema);
+
+		runner.Run("parse/int_list", { { "elements", listLength } }, listLength, [&]
+			{
+				result.Parse(ints.Argc(), ints.Argv());
+				return;
+			});
+
+		runner.Run("parse/float_list", { { "elements", listLength } }, listLength, [&]
+			{
+				result.Parse(floats.Argc(), floats.Argv());
+				return;
+			});
+	}
+
+	// Abbreviation count
+	for (const std::size_t numAbbreviations : { 0, 16, 256, 4096 })
+	{
+		Schema schema;
+		for (std::size_t i = 0; i < numAbbreviations; i++)
+			schema.RegisterAbbreviation("-a" + std::to_string(i), "--abbreviated-" + std::to_string(i));
+		schema.Freeze();
+
+		CommandLine commandLine;
+		commandLine.Add("/usr/bin/app");
+		for (std::size_t i = 0; i < 16; i++)
+		{
+			commandLine.Add("-a" + std::to_string(i));
+			AddValue(commandLine, i);
+		}
+
+		ParseResult result(schema);
+
+		runner.Run("parse/abbreviations", { { "abbreviations", numAbbreviations } }, 32, [&]
+			{
+				result.Parse(commandLine.Argc(), commandLine.Argv());
+				return;
+			});
+	}
+
+	// Clusters of single character flags, like -ltr
+	for (const std::size_t numClusters : { 16, 256, 4096 })
+	{
+		Schema schema;
+		for (char c = 'a'; c <= 'z'; c++)
+			schema.RegisterAbbreviation(std::string("-") + c, std::string("--flag-") + c);
+		schema.Freeze();
+
+		CommandLine commandLine;
+		commandLine.Add("/usr/bin/app");
+		for (std::size_t i = 0; i < numClusters; i++)
+			commandLine.Add(std::string("-") + (char)('a' + i % 26) + (char)('a' + (i + 7) % 26) + (char)('a' + (i + 13) % 26));
+
+		ParseResult result(schema);
+
+		runner.Run("parse/clustered_flags", { { "clusters", numClusters } }, numClusters, [&]
+			{
+				result.Parse(commandLine.Argc(), commandLine.Argv());
+				return;
+			});
+	}
+
+	// Keys shortened to unique prefixes, like --verb for --verbose, against schemas knowing more and more keys
+	for (const std::size_t numKeys : { 16, 256, 4096 })
+	{
+		Schema schema;
+		for (std::size_t i = 0; i < numKeys; i++)
+			schema.RegisterConstraint("--option-" + std::to_string(i) + "-long-name", ParamConstraint());
+		schema.SetMatchUniquePrefixes(true);
+		schema.Freeze();
+
+		CommandLine commandLine;
+		commandLine.Add("/usr/bin/app");
+		for (std::size_t i = 0; i < 16; i++)
+		{
+			commandLine.Add("--option-" + std::to_string(i * numKeys / 16) + "-lo");
+			AddValue(commandLine, i);
+		}
+
+		ParseResult result(schema);
+
+		runner.Run("parse/unique_prefixes", { { "keys", numKeys } }, 32, [&]
+			{
+				result.Parse(commandLine.Argc(), commandLine.Argv());
+				return;
+			});
+	}
+
+	// Options kept in a config file, merged below an empty command line
+	for (const std::size_t numOptions : { 16, 256, 4096 })
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / ("hazelnupp_bench_" + std::to_string(numOptions) + ".ini")).string();
+		{
+			std::ofstream file(path, std::ios::binary);
+			for (std::size_t i = 0; i < numOptions; i++)
+				file << "option-" << i << " = " << ((i % 2 == 0) ? std::to_string(i) : "value-" + std::to_string(i)) << '\n';
+		}
+
+		CommandLine commandLine;
+		commandLine.Add("/usr/bin/app");
+
+		const Schema schema;
+		ParseResult result(schema);
+		result.LoadConfigFile(path);
+
+		runner.Run("parse/config_file", { { "options", numOptions } }, numOptions, [&]
+			{
+				result.Parse(commandLine.Argc(), commandLine.Argv());
+				return;
+			});
+	}
+
+	// One parameter repeated over and over, like -I of a compiler, appended to one list
+	for (const std::size_t numOccurrences : { 16, 256, 4096 })
+	{
+		Schema schema;
+		schema.RegisterAbbreviation("-I", "--include");
+		schema.RegisterConstraint("--include", ParamConstraint::RepeatPolicy(REPEAT_POLICY::APPEND));
+		schema.Freeze();
+
+		CommandLine commandLine;
+		commandLine.Add("/usr/bin/app");
+		for (std::size_t i = 0; i < numOccurrences; i++)
+		{
+			commandLine.Add("-I");
+			commandLine.Add("/usr/include/lib-" + std::to_string(i));
+		}
+
+		ParseResult result(schema);
+
+		runner.Run("parse/repeated_append", { { "occurrences", numOccurrences } }, numOccurrences * 2, [&]
+			{
+				result.Parse(commandLine.Argc(), commandLine.Argv());
+				return;
+			});
+	}
+
+	return;
+}
@@ -0,0 +1,77 @@
+#include "Bench.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace Hazelnp;
+
+int main(int argc, char** argv)
+{
+	CmdArgsInterface args;
+
+	args.SetBriefDescription("Benchmarks Hazelnupp, and writes the results as JSON.");
+
+	args.RegisterDescription("--output", "File to write the JSON results to. Defaults to stdout.");
+	args.RegisterDescription("--min-time", "Seconds to sample each benchmark for, at least.");
+	args.RegisterDescription("--filter", "Only run benchmarks whose name contains this, like parse/ or corpus/.");
+	args.RegisterDescription("--corpus", "Recorded command lines to replay. One per line. Defaults to the bundled corpora.");
+
+	args.RegisterAbbreviation("-o", "--output");
+	args.RegisterAbbreviation("-t", "--min-time");
+	args.RegisterAbbreviation("-f", "--filter");
+	args.RegisterAbbreviation("-c", "--corpus");
+
+	args.RegisterConstraint("--output", ParamConstraint::TypeSafety(DATA_TYPE::STRING));
+	args.RegisterConstraint("--min-time", ParamConstraint(true, DATA_TYPE::FLOAT, { "0.25" }, false, {}));
+	args.RegisterConstraint("--filter", ParamConstraint::TypeSafety(DATA_TYPE::STRING));
+	args.RegisterConstraint("--corpus", ParamConstraint::TypeSafety(DATA_TYPE::LIST));
+
+	args.Parse(argc, argv);
+
+	// Collect corpora
+	std::vector<std::string> corpora;
+	if (args.HasParam("--corpus"))
+	{
+		for (const Value* path : args["--corpus"].GetList())
+			corpora.push_back(path->GetString());
+	}
+#ifdef HAZELNUPP_BENCH_CORPORA
+	else if (std::filesystem::is_directory(HAZELNUPP_BENCH_CORPORA))
+	{
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(HAZELNUPP_BENCH_CORPORA))
+			if (entry.is_regular_file())
+				corpora.push_back(entry.path().string());
+
+		std::sort(corpora.begin(), corpora.end());
+	}
+#endif
+
+	Bench::Runner runner(
+		(double)args["--min-time"].GetFloat64(),
+		args.HasParam("--filter") ? args["--filter"].GetString() : ""
+	);
+
+	Bench::RegisterParseBenchmarks(runner);
+	Bench::RegisterDocumentationBenchmarks(runner);
+	Bench::RegisterAccessorBenchmarks(runner);
+	Bench::RegisterCorpusBenchmarks(runner, corpora);
+
+	// Write results
+	if (args.HasParam("--output"))
+	{
+		std::ofstream file(args["--output"].GetString());
+		runner.WriteJson(file);
+
+		if (!file)
+		{
+			std::cerr << "Unable to write " << args["--output"].GetString() << std::endl;
+			return 1;
+		}
+	}
+	else
+		runner.WriteJson(std::cout);
+
+	return 0;
+}
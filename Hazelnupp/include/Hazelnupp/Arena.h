@@ -0,0 +1,97 @@
+#pragma once
+#include <memory_resource>
+#include <cstddef>
+#include <utility>
+
+namespace Hazelnp
+{
+	namespace Internal
+	{
+		/** Internal monotonic memory resource. Memory is handed out linearly from big chunks,
+		* and only ever given back to the upstream resource all at once.
+		* Deallocations are no-ops. Objects living in an arena are never destructed!
+		* Reset() rewinds it whilst keeping its chunks, so that reusing it does not have to allocate again.
+		*/
+		class Arena : public std::pmr::memory_resource
+		{
+		public:
+			//! Will construct an arena requesting its chunks from upstream
+			explicit Arena(std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+			~Arena() override;
+
+			Arena(const Arena&) = delete;
+			Arena& operator=(const Arena&) = delete;
+
+			//! Will give all chunks back to the upstream resource.  
+			//! Everything allocated from this arena is gone afterwards.
+			void Release();
+
+			//! Will rewind the arena to its first chunk, but keep all of them for reuse.  
+			//! Everything allocated from this arena is gone afterwards.
+			void Reset();
+
+			//! Will return the total size of all chunks held
+			std::size_t GetCapacity() const;
+
+			//! Will return the upstream resource
+			std::pmr::memory_resource* GetUpstream() const;
+
+			//! Will return how many allocations this arena served since its construction.  
+			//! Only counted if instrumentation is enabled. Zero otherwise.
+			std::size_t GetNumAllocations() const;
+
+			//! Will return how many chunks this arena requested from upstream since its construction.  
+			//! Only counted if instrumentation is enabled. Zero otherwise.
+			std::size_t GetNumUpstreamAllocations() const;
+
+			//! Will construct an object of type T within this arena.  
+			//! Its destructor will never be called.
+			template <typename T, typename... Args>
+			T* New(Args&&... args)
+			{
+				return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+			}
+
+		protected:
+			void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+			void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+		private:
+			//! Header in front of each chunk
+			struct Chunk
+			{
+				Chunk* next;
+				std::size_t size;
+			};
+
+			//! Will move on to the next kept chunk big enough for minBytes, or request a new one
+			void Grow(std::size_t minBytes);
+
+			//! Will make chunk the one to allocate from
+			void Enter(Chunk* chunk);
+
+			std::pmr::memory_resource* upstream;
+
+			//! All chunks, in the order they are used
+			Chunk* chunks = nullptr;
+
+			//! The chunk currently allocated from. Chunks after it are unused since the last Reset().
+			Chunk* current = nullptr;
+
+			//! The free area of the current chunk
+			char* cursor = nullptr;
+			char* end = nullptr;
+
+			//! Size of the first chunk to request
+			static constexpr std::size_t initialChunkSize = 1024;
+
+			//! Size of the next chunk to request. Doubles with every chunk.
+			std::size_t nextChunkSize = initialChunkSize;
+
+			//! Statistics. Only counted if instrumentation is enabled.
+			std::size_t numAllocations = 0;
+			std::size_t numUpstreamAllocations = 0;
+		};
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "Schema.h"
+#include "ParseResult.h"
+#include "WorkStealingPool.h"
+#include <vector>
+#include <memory>
+#include <exception>
+
+namespace Hazelnp
+{
+	/** One command line of a batch. Just like the arguments of main().
+	*/
+	struct ArgVector
+	{
+		int argc = 0;
+		const char* const* argv = nullptr;
+	};
+
+	/** The outcome of parsing one command line of a batch.
+	* Exactly one of result and error is set.
+	*/
+	struct BatchItem
+	{
+		//! Returns whether or not this command line parsed without error
+		bool Succeeded() const
+		{
+			return result != nullptr;
+		}
+
+		//! The parsed parameters. nullptr, if parsing failed.
+		std::unique_ptr<ParseResult> result;
+
+		//! What parsing threw. Usually a HazelnuppException. nullptr, if parsing succeeded.
+		std::exception_ptr error;
+	};
+
+	/** Parses large batches of command lines against one shared schema, across a pool of worker threads.
+	* Idle workers steal work from busy ones, so batches of uneven command lines still keep all cores busy.
+	* The worker threads are kept alive between batches.
+	*/
+	class BatchParser
+	{
+	public:
+		//! Will construct a BatchParser with numThreads workers, including the thread calling Parse().  
+		//! 0 means one worker per hardware thread.  
+		//! IMPORTANT: The schema is referenced, not copied. It must outlive this object!
+		explicit BatchParser(const Schema& schema, std::size_t numThreads = 0);
+
+		BatchParser(const BatchParser&) = delete;
+		BatchParser& operator=(const BatchParser&) = delete;
+
+		//! Will parse numItems command lines, and return their outcomes in input order.  
+		//! Errors are reported per item, and never thrown. A failing command line does not affect any other.  
+		//! Throws a HazelnuppException if the schema is not frozen.
+		std::vector<BatchItem> Parse(const ArgVector* items, std::size_t numItems);
+
+		//! Will parse a batch of command lines, and return their outcomes in input order.  
+		//! Errors are reported per item, and never thrown. A failing command line does not affect any other.  
+		//! Throws a HazelnuppException if the schema is not frozen.
+		std::vector<BatchItem> Parse(const std::vector<ArgVector>& items);
+
+		//! Will return the amount of workers, including the thread calling Parse()
+		std::size_t GetNumThreads() const;
+
+		//! Sets whether the results should reference the callers argv directly, instead of copying it.  
+		//! IMPORTANT: If enabled, all argvs of a batch must outlive its results!
+		void SetBorrowArgv(bool borrowArgv);
+
+		//! Returns whether the results reference the callers argv directly, instead of copying it.
+		bool GetBorrowArgv() const;
+
+		//! Will return the schema this parses against
+		const Schema& GetSchema() const;
+
+	private:
+		//! What we parse against
+		const Schema* schema;
+
+		Internal::WorkStealingPool pool;
+
+		//! Passed on to every ParseResult
+		bool borrowArgv = false;
+	};
+}
@@ -1,14 +1,16 @@
 #pragma once
-#include "Parameter.h"
-#include "ParamConstraint.h"
-#include <unordered_map>
-#include <vector>
+#include "Schema.h"
+#include "ParseResult.h"
+#include <string>
+#include <memory_resource>
 
 #include "Version.h"
 
 namespace Hazelnp
 {
-	/** The main class to interface with
+	/** The main class to interface with.
+	* A convenience wrapper around one Schema, and one ParseResult parsing against it.
+	* Use those directly to parse from several threads against one schema.
 	*/
 	class CmdArgsInterface
 	{
@@ -16,11 +18,32 @@ namespace Hazelnp
 		CmdArgsInterface();
 		CmdArgsInterface(const int argc, const char* const* argv);
 
+		//! Will construct a CmdArgsInterface, whose parse results request their memory from upstream.
+		explicit CmdArgsInterface(std::pmr::memory_resource* upstream);
+
+		//! Will construct a CmdArgsInterface using a compile-time schema. See SetStaticSchema().
+		template <std::size_t N>
+		explicit CmdArgsInterface(const StaticSchema<N>& schema)
+			:
+			CmdArgsInterface()
+		{
+			SetStaticSchema(schema);
+			return;
+		}
+
+		CmdArgsInterface(const CmdArgsInterface&) = delete;
+		CmdArgsInterface& operator=(const CmdArgsInterface&) = delete;
+
 		~CmdArgsInterface();
 
-		//! Will parse command line arguments
+		//! Will parse command line arguments.  
+		//! Results of a previous parse are dropped. The registered schema, and all memory reserved, are kept.  
+		//! Once warmed up with similar input, parsing again does not allocate at all.
 		void Parse(const int argc, const char* const* argv);
 
+		//! Will drop all parse results, but keep the registered schema and all memory reserved for the next Parse().
+		void Reset();
+
 		//! Will return argv[0], the name of the executable.
 		const std::string& GetExecutableName() const;
 
@@ -30,6 +53,54 @@ namespace Hazelnp
 		//! Will check wether a parameter exists given a key, or not
 		bool HasParam(const std::string& key) const;
 
+		//! Will return the value given a handle. This is just a bounds-checked array access.  
+		//! Its type is already fixed by the handle. Throws HazelnuppInvalidKeyException if the parameter does not exist.
+		template <typename T>
+		typename Internal::ParamTraits<T>::ReturnType operator[](const ParamHandle<T>& handle) const
+		{
+			return result[handle];
+		}
+
+		//! Will check wether a parameter exists given a handle, or not
+		template <typename T>
+		bool HasParam(const ParamHandle<T>& handle) const
+		{
+			return result.HasParam(handle);
+		}
+
+		//! Will return where the value of a parameter came from: the command line, the environment, a config file, or its default value.  
+		//! Throws HazelnuppInvalidKeyException if the parameter does not exist.
+		PARAM_SOURCE GetSource(const std::string& key) const;
+
+		//! Will return where the value of a parameter came from, given a handle.  
+		//! Throws HazelnuppInvalidKeyException if the parameter does not exist.
+		template <typename T>
+		PARAM_SOURCE GetSource(const ParamHandle<T>& handle) const
+		{
+			return result.GetSource(handle);
+		}
+
+		//! Will return the environment variable, or the path of the config file, the value of a parameter was taken from.  
+		//! Empty for the command line and default values. Throws HazelnuppInvalidKeyException if the parameter does not exist.
+		std::string_view GetOrigin(const std::string& key) const;
+
+		//! Will register a constraint for a parameter, and return a typed handle to it.  
+		//! A type-safety aspect for T gets added to the constraint.
+		template <typename T>
+		ParamHandle<T> RegisterParameter(const std::string& key, ParamConstraint constraint = ParamConstraint())
+		{
+			return schema.RegisterParameter<T>(key, constraint);
+		}
+
+		//! Will return a typed handle to a parameter, that is already registered at runtime or in the static schema.  
+		//! It has to be constrained to the type of T. Throws HazelnuppException otherwise.  
+		//! Handles into the static schema stay valid as long as the schema stays in use.
+		template <typename T>
+		ParamHandle<T> GetHandle(const std::string& key)
+		{
+			return schema.GetHandle<T>(key);
+		}
+
 		// Abbreviations
 		//! Will register an abbreviation (like -f for --force)
 		void RegisterAbbreviation(const std::string& abbrev, const std::string& target);
@@ -48,6 +119,50 @@ namespace Hazelnp
 		//! Will delete all abbreviations
 		void ClearAbbreviations();
 
+		//! Sets whether keys may be shortened to any unique prefix, like --verb for --verbose, just like getopt_long allows.  
+		//! Only keys anything is known about get matched. Exact keys and abbreviations, like --v, always win, and unknown ones stay as they are.  
+		//! A prefix of several keys, like --ver of --verbose and --version, throws a HazelnuppAmbiguousKeyException.
+		void SetMatchUniquePrefixes(bool matchUniquePrefixes);
+
+		//! Returns whether keys may be shortened to any unique prefix
+		bool GetMatchUniquePrefixes() const;
+
+		// Environment variables
+		//! Will bind a parameter to an environment variable (like --verbose to APP_VERBOSE).  
+		//! If the parameter is not supplied, its value gets taken from that variable, before resorting to config files, and its default value.  
+		//! Parameters constrained to lists split the value at whitespace. Others take it as one value. An empty variable has no values.
+		void RegisterEnvironmentVariable(const std::string& key, const std::string& variable);
+
+		//! Will return the environment variable a parameter is bound to.  
+		//! Returns "" if it is bound to none
+		const std::string& GetEnvironmentVariable(const std::string& key) const;
+
+		//! Will check wether or not a parameter is bound to an environment variable
+		bool HasEnvironmentVariable(const std::string& key) const;
+
+		//! Will delete the environment variable binding of a parameter
+		void ClearEnvironmentVariable(const std::string& key);
+
+		//! Will delete all environment variable bindings
+		void ClearEnvironmentVariables();
+
+		//! Sets the environment bound parameters take their values from. Like the envp of main(). nullptr reads the environment of the process.  
+		//! IMPORTANT: The environment is referenced, not copied. It must outlive this object, or be unset!
+		void SetEnvironment(const char* const* environment);
+
+		//! Returns the environment bound parameters take their values from. nullptr if it is the one of the process.
+		const char* const* GetEnvironment() const;
+
+		// Config files
+		//! Will load a config file of INI/TOML-style key = value lines. Its keys share the namespace of --key arguments.  
+		//! Values of config files rank below the command line and the environment, but above default values.  
+		//! Of several config files, the one loaded last takes precedence. The file gets memory-mapped and parsed right away.  
+		//! Throws a HazelnuppConfigFileException if it can not be read, or is malformed.
+		void LoadConfigFile(const std::string& path);
+
+		//! Will unload all config files
+		void ClearConfigFiles();
+
 		//! Will register a constraint for a parameter.
 		//! IMPORTANT: Any parameter can only have ONE constraint. Applying a new one will overwrite the old one!
 		//! Construct the ParamConstraint struct yourself to combine Require, TypeSafety and Incompatibilities! You can also use the ParamConstraint constructor!
@@ -62,6 +177,24 @@ namespace Hazelnp
 		//! Will delete all constraints
 		void ClearConstraints();
 
+		//! Will use a compile-time schema for keys, abbreviations, constraints and descriptions.  
+		//! Its keys are looked up through a perfect hash table, and their results are stored by id. No map involved.  
+		//! Runtime registrations still apply to keys the schema does not know. The Get/Has/Clear methods above only concern those.  
+		//! IMPORTANT: The schema is referenced, not copied. It must outlive this object!
+		template <std::size_t N>
+		void SetStaticSchema(const StaticSchema<N>& schema)
+		{
+			this->schema.SetStaticSchema(schema);
+			result.Reset();
+			return;
+		}
+
+		//! Will stop using the compile-time schema
+		void ClearStaticSchema();
+
+		//! Returns whether or not a compile-time schema is in use
+		bool HasStaticSchema() const;
+
 		//! Sets whether to crash the application, and print to stderr, when an exception is 
 		//! raised whilst parsing, or not.
 		void SetCrashOnFail(bool crashOnFail);
@@ -69,7 +202,50 @@ namespace Hazelnp
 		//! Gets whether the application crashes on an exception whilst parsing, and prints to stderr.
 		bool GetCrashOnFail() const;
 
-		//! Sets whether the CmdArgsInterface should automatically catch the --help parameter, print the parameter documentation to stdout, and exit or not.
+		//! Sets whether Parse() should reference the callers argv directly, instead of copying it into one internal buffer.  
+		//! IMPORTANT: If enabled, argv must outlive this object, as all keys and string values will point into it!
+		void SetBorrowArgv(bool borrowArgv);
+
+		//! Returns whether Parse() references the callers argv directly, instead of copying it into one internal buffer.
+		bool GetBorrowArgv() const;
+
+		//! Sets whether Parse() should replace arguments like @args.txt with the arguments listed in that file.  
+		//! The file gets memory-mapped, and its tokens are referenced in place, until the next Parse().  
+		//! Response files may list further response files. Relative paths are relative to the listing file.
+		void SetExpandResponseFiles(bool expandResponseFiles);
+
+		//! Returns whether Parse() replaces arguments like @args.txt with the arguments listed in that file.
+		bool GetExpandResponseFiles() const;
+
+		//! Sets how deep response files may be nested. A response file passed on the command line has depth 1.
+		void SetMaxResponseFileDepth(std::size_t maxResponseFileDepth);
+
+		//! Returns how deep response files may be nested
+		std::size_t GetMaxResponseFileDepth() const;
+
+		//! Sets whether values should only be converted once they are accessed, instead of whilst parsing.  
+		//! Type-constraint violations then throw on access, instead of failing Parse(). Call Validate() to check them right away.
+		void SetLazyConversion(bool lazyConversion);
+
+		//! Returns whether values are only converted once they are accessed
+		bool GetLazyConversion() const;
+
+		//! Will convert all values right away, and throw the first type-constraint violation, if any.
+		void Validate() const;
+
+		//! Sets a sink to pass the statistics of each Parse() call, and each documentation rendering to. nullptr for none.  
+		//! Statistics only get recorded if instrumentation is enabled. See g_instrumentationEnabled.  
+		//! IMPORTANT: The sink is referenced, not copied. It must outlive this object, or be unset!
+		void SetInstrumentationSink(InstrumentationSink* sink);
+
+		//! Returns the sink the statistics get passed to. nullptr if there is none.
+		InstrumentationSink* GetInstrumentationSink() const;
+
+		//! Will return the statistics of the last Parse() call. All zero, unless instrumentation is enabled.
+		const ParseStats& GetParseStats() const;
+
+		//! Sets whether the CmdArgsInterface should automatically catch the --help parameter, print the parameter documentation to stdout, and exit or not.  
+		//! --help followed by a parameter, like --help --width, prints the documentation of just that one.
 		void SetCatchHelp(bool catchHelp);
 
 		//! Retruns whether the CmdArgsInterface should automatically catch the --help parameter, print the parameter documentation to stdout, and exit or not.
@@ -98,46 +274,42 @@ namespace Hazelnp
 		//! Will delete all parameter descriptions
 		void ClearDescriptions();
 
-		//! Will generate a text-based documentation suited to show the user, for example on --help.
-		std::string GenerateDocumentation() const;
+		//! Sets the column to wrap documentation lines at. 0 does not wrap at all, which is the default.
+		void SetDocumentationWidth(std::size_t documentationWidth);
 
-	private:
-		//! Will translate the c-like args to an std::vector
-		void PopulateRawArgs(const int argc, const char* const* argv);
-
-		//! Will replace all args matching an abbreviation with their long form (like -f for --force)
-		void ExpandAbbreviations();
+		//! Returns the column documentation lines get wrapped at. 0 if they do not get wrapped.
+		std::size_t GetDocumentationWidth() const;
 
-		//! Will parse the next parameter. Returns the index of the next parameter.
-		std::size_t ParseNextParameter(const std::size_t parIndex, Parameter*& out_Par);
+		//! Will generate a text-based documentation suited to show the user, for example on --help.  
+		//! It is rendered once, and cached until anything registered changes.
+		const std::string& GenerateDocumentation() const;
 
-		//! Will convert a vector of string-values to an actual Value
-		Value* ParseValue(const std::vector<std::string>& values, const ParamConstraint* constraint = nullptr);
+		//! Will generate the documentation of a single parameter, without rendering the whole document.  
+		//! key may be an abbreviation aswell. Returns an empty string, if nothing is known about it.
+		std::string GenerateParameterDocumentation(const std::string& key) const;
 
-		//! Will apply the loaded constraints on the loaded values, exluding types.
-		void ApplyConstraints();
+		//! Will write the documentation, followed by a line break, straight to a file descriptor, like 1 for stdout.  
+		//! Returns false, if it could not be written completely.
+		bool WriteDocumentation(int fd) const;
 
-		//! Will return a pointer to a paramConstraint given a key. If there is no, it returns nullptr
-		const ParamConstraint* GetConstraintForKey(const std::string& key) const;
+		//! Will return the schema everything gets registered to
+		Schema& GetSchema();
 
-		std::string executableName; //! The path of the executable. Always argv[0]
-		std::unordered_map<std::string, Parameter*> parameters;
+		//! Will return the schema everything gets registered to
+		const Schema& GetSchema() const;
 
-		//! These are abbreviations. Like, -f for --force.
-		std::unordered_map<std::string, std::string> parameterAbreviations;
+		//! Will return the results of the last parse
+		const ParseResult& GetParseResult() const;
 
-		//! Parameter constraints, mapped to keys
-		std::unordered_map<std::string, ParamConstraint> parameterConstraints;
-
-		//! Raw argv
-		std::vector<std::string> rawArgs;
+	private:
+		//! Will print the documentation, and exit, if --help was passed and catchHelp is set.  
+		//! If --help is directly followed by a known parameter, like --help --width, only that one gets documented.
+		void CatchHelp(const int argc, const char* const* argv) const;
 
-		//! Short descriptions for parameters
-		//! First member is the abbreviation
-		std::unordered_map<std::string, std::string> parameterDescriptions;
+		//! Declared before result, because it has to be constructed first
+		Schema schema;
 
-		//! A brief description of the application to be added to the generated documentation. Optional.
-		std::string briefDescription;
+		ParseResult result;
 
 		//! If set to true, CmdArgsInterface will automatically catch the --help parameter, print the parameter documentation to stdout and exit.
 		bool catchHelp = true;
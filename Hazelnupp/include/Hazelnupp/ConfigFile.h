@@ -0,0 +1,88 @@
+#pragma once
+#include "MappedFile.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+namespace Hazelnp
+{
+	namespace Internal
+	{
+		/** Internal memory-mapped config file of INI/TOML-style key = value lines, parsed in place.
+		* The file is mapped copy-on-write. Values are views into the mapping, so nothing gets copied.
+		* Only pages holding escaped values ever get written to, to unescape these in place.
+		*
+		* Keys map to parameters like this: `width = 800` is --width, and `width` within a [render] section is --render.width.
+		* Keys may be written with their leading dashes aswell.
+		* Values are either bare, like `billy bob`, quoted, like "billy\tbob" or 'billy bob', or an array, like [1, 2, "three"].
+		* Within "...", a backslash escapes the next character. Within '...', everything is literal. Arrays may span several lines.
+		* A bare `true` sets a parameter without values. A bare `false` omits it. An empty value has no values either.
+		* Lines beginning with # or ; are comments. So is anything after a # or ; that follows whitespace, outside of quotes.
+		*/
+		class ConfigFile
+		{
+		public:
+			//! A key, and its values
+			struct Entry
+			{
+				std::string_view key;
+				const std::string_view* values;
+				std::size_t numValues;
+			};
+
+			//! Will map and parse the file at path. Throws HazelnuppConfigFileException if it can't be read, or is malformed.
+			explicit ConfigFile(const std::string& path);
+
+			ConfigFile(const ConfigFile&) = delete;
+			ConfigFile& operator=(const ConfigFile&) = delete;
+
+			//! Will return all entries, in the order they appear in. They stay valid as long as this object lives.
+			const std::vector<Entry>& GetEntries() const;
+
+			//! Will return the path of this file
+			const std::string& GetPath() const;
+
+		private:
+			//! Will parse the value beginning at the cursor, and append its tokens to values.  
+			//! Returns false, if it is a bare false, and the entry should be omitted.
+			bool ParseValue();
+
+			//! Will parse a quoted or bare scalar beginning at the cursor, and append it to values.  
+			//! Within arrays, bare scalars end at a comma or closing bracket aswell. Returns whether it was quoted.
+			bool ParseScalar(bool inArray);
+
+			//! Will skip blanks, but not line breaks
+			void SkipBlanks();
+
+			//! Will skip whitespace, line breaks and comments
+			void SkipWhitespace();
+
+			//! Will skip the rest of the line, if it is blank or a comment. Throws otherwise.
+			void ExpectEndOfLine();
+
+			//! Will throw a HazelnuppConfigFileException about the current line
+			[[noreturn]] void Fail(const std::string& reason) const;
+
+			std::string path;
+
+			MappedFile file;
+
+			//! The mapped contents. nullptr, if the file is empty.
+			char* data = nullptr;
+			std::size_t size = 0;
+
+			//! Where parsing continues, and on which line that is
+			std::size_t cursor = 0;
+			std::size_t line = 1;
+
+			//! Keys, with their dashes and section, one after another. Entries reference it.
+			std::string keys;
+
+			//! Values of all entries, one after another. Entries reference it.
+			std::vector<std::string_view> values;
+
+			std::vector<Entry> entries;
+		};
+	}
+}
@@ -2,6 +2,7 @@
 #include <stdexcept>
 #include <string>
 #include <sstream>
+#include <vector>
 #include "DataType.h"
 
 namespace Hazelnp
@@ -33,6 +34,72 @@ namespace Hazelnp
 		HazelnuppInvalidKeyException(const std::string& msg) : HazelnuppException(msg) {};
 	};
 
+	/** Gets thrown when a key is a prefix of several known keys, like --ver of --verbose and --version, and prefixes are matched
+	*/
+	class HazelnuppAmbiguousKeyException : public HazelnuppException
+	{
+	public:
+		HazelnuppAmbiguousKeyException() : HazelnuppException() {};
+		HazelnuppAmbiguousKeyException(const std::string& key, const std::vector<std::string>& candidates)
+		{
+			// Generate descriptive error message
+			std::stringstream ss;
+			ss << "Parameter " << key << " is ambiguous. It may stand for ";
+
+			for (std::size_t i = 0; i < candidates.size(); i++)
+			{
+				if (i > 0)
+					ss << ", ";
+
+				ss << candidates[i];
+			}
+
+			ss << ".";
+
+			message = ss.str();
+			return;
+		};
+	};
+
+	/** Gets thrown when a response file (like @args.txt) can not be read, is malformed, or nested too deeply
+	*/
+	class HazelnuppResponseFileException : public HazelnuppException
+	{
+	public:
+		HazelnuppResponseFileException() : HazelnuppException() {};
+		HazelnuppResponseFileException(const std::string& path, const std::string& reason)
+		{
+			// Generate descriptive error message
+			std::stringstream ss;
+			ss << "Unable to read response file \"" << path << "\": " << reason;
+
+			message = ss.str();
+			return;
+		};
+	};
+
+	/** Gets thrown when a config file can not be read, or is malformed
+	*/
+	class HazelnuppConfigFileException : public HazelnuppException
+	{
+	public:
+		HazelnuppConfigFileException() : HazelnuppException() {};
+		HazelnuppConfigFileException(const std::string& path, std::size_t line, const std::string& reason)
+		{
+			// Generate descriptive error message
+			std::stringstream ss;
+			ss << "Unable to read config file \"" << path << "\"";
+
+			if (line > 0)
+				ss << " (line " << line << ")";
+
+			ss << ": " << reason;
+
+			message = ss.str();
+			return;
+		};
+	};
+
 	/** Gets thrown when an attempt is made to retrieve the wrong data type from a value, when the value not convertible
 	*/
 	class HazelnuppValueNotConvertibleException : public HazelnuppException
@@ -96,6 +163,27 @@ namespace Hazelnp
 		};
 	};
 
+	/** Gets thrown when a parameter whose repeat policy is REJECT is supplied more than once
+	*/
+	class HazelnuppConstraintRepeatedParameter : public HazelnuppConstraintException
+	{
+	public:
+		HazelnuppConstraintRepeatedParameter() : HazelnuppConstraintException() {};
+		HazelnuppConstraintRepeatedParameter(const std::string& key, const std::string& paramDescription = "")
+		{
+			// Generate descriptive error message
+			std::stringstream ss;
+			ss << "Parameter " << key << " may only be supplied once.";
+
+			// Add the parameter description, if provided
+			if (paramDescription.length() > 0)
+				ss << std::endl << key << "   => " << paramDescription;
+
+			message = ss.str();
+			return;
+		};
+	};
+
 	/** Gets thrown when a parameter constrained to be incompatible with other parameters gets supplied alongside at least one of those incompatible ones
 	*/
 	class HazelnuppConstraintIncompatibleParameters : public HazelnuppConstraintException
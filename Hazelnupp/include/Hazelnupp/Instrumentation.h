@@ -0,0 +1,126 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+
+namespace Hazelnp
+{
+	//! Whether or not statistics get recorded. Define HAZELNUPP_INSTRUMENTATION to enable it.  
+	//! Otherwise, recording compiles away entirely, and all statistics stay zero.
+#ifdef HAZELNUPP_INSTRUMENTATION
+	constexpr bool g_instrumentationEnabled = true;
+#else
+	constexpr bool g_instrumentationEnabled = false;
+#endif
+
+	/** The phases statistics get recorded for
+	*/
+	enum class PARSE_PHASE
+	{
+		POPULATE_RAW_ARGS,
+		EXPAND_ABBREVIATIONS,
+		PARSE_VALUES,
+		APPLY_CONSTRAINTS,
+		RENDER_DOCUMENTATION
+	};
+
+	//! Amount of phases in PARSE_PHASE
+	constexpr std::size_t g_numParsePhases = 5;
+
+	static inline const char* ParsePhaseToString(PARSE_PHASE phase)
+	{
+		switch (phase)
+		{
+		case PARSE_PHASE::POPULATE_RAW_ARGS:
+			return "POPULATE_RAW_ARGS";
+
+		case PARSE_PHASE::EXPAND_ABBREVIATIONS:
+			return "EXPAND_ABBREVIATIONS";
+
+		case PARSE_PHASE::PARSE_VALUES:
+			return "PARSE_VALUES";
+
+		case PARSE_PHASE::APPLY_CONSTRAINTS:
+			return "APPLY_CONSTRAINTS";
+
+		case PARSE_PHASE::RENDER_DOCUMENTATION:
+			return "RENDER_DOCUMENTATION";
+		}
+
+		return "";
+	}
+
+	/** What a single phase took
+	*/
+	struct PhaseStats
+	{
+		//! Time spent, measured with a monotonic clock
+		std::chrono::nanoseconds duration { 0 };
+
+		//! Tokens processed
+		std::size_t numTokens = 0;
+
+		//! Values created. One per parameter, or per documented parameter.
+		std::size_t numValues = 0;
+
+		//! Allocations from the arena of the ParseResult
+		std::size_t numAllocations = 0;
+
+		//! Chunks the arena requested from its upstream resource. Only these reach the heap, by default.
+		std::size_t numUpstreamAllocations = 0;
+	};
+
+	/** What a single Parse() call took, phase by phase
+	*/
+	struct ParseStats
+	{
+		//! Indexed by PARSE_PHASE. Parsing never renders the documentation, so that one stays zero.
+		PhaseStats phases[g_numParsePhases];
+
+		//! Time spent on the whole call, including anything in between the phases
+		std::chrono::nanoseconds duration { 0 };
+
+		//! False, if the call threw
+		bool succeeded = false;
+
+		const PhaseStats& operator[](PARSE_PHASE phase) const
+		{
+			return phases[(std::size_t)phase];
+		}
+
+		PhaseStats& operator[](PARSE_PHASE phase)
+		{
+			return phases[(std::size_t)phase];
+		}
+	};
+
+	/** Receives statistics as they get recorded. Implement it to export them to a metrics pipeline.
+	* It gets called on the thread that parsed. If it is shared between ParseResults parsing concurrently, it has to be thread-safe.
+	*/
+	class InstrumentationSink
+	{
+	public:
+		virtual ~InstrumentationSink() = default;
+
+		//! Will be called at the end of each Parse() and EndStream() call. Also if they threw.
+		virtual void OnParse(const ParseStats& stats) = 0;
+
+		//! Will be called whenever a schema rendered its documentation
+		virtual void OnRenderDocumentation(const PhaseStats&)
+		{
+			return;
+		}
+	};
+
+	namespace Internal
+	{
+		/** Where a phase began. Only ever filled if instrumentation is enabled.
+		*/
+		struct PhaseMark
+		{
+			std::chrono::steady_clock::time_point begin;
+			std::size_t numValues = 0;
+			std::size_t numAllocations = 0;
+			std::size_t numUpstreamAllocations = 0;
+		};
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "Span.h"
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace Hazelnp
+{
+	namespace Internal
+	{
+		/** Internal index over a set of keys, to find all keys beginning with a prefix in O(prefix length), like --verb of --verbose.
+		* It is a radix tree, stored in one array. The children of a node lie next to each other, so descending scans one cache line or two.
+		* Each node stands for a prefix, and covers the range of sorted keys beginning with it. These are the matches, without collecting anything.
+		* Chains of nodes with a single child are collapsed, so there are less than two nodes per key.
+		* Keys are referenced, not copied. They must stay valid until the index is built again.
+		*/
+		class KeyIndex
+		{
+		public:
+			//! Will index keys, replacing whatever was indexed before. Duplicates are indexed once.
+			void Build(std::vector<std::string_view> keys);
+
+			//! Will return all keys beginning with prefix, sorted. If prefix is a key itself, it comes first.  
+			//! Stays valid until the index is built again.
+			Span<const std::string_view> FindPrefixed(std::string_view prefix) const;
+
+		private:
+			struct Node
+			{
+				//! Length of the prefix this node stands for. All keys of its range begin with it.
+				std::uint32_t depth;
+
+				//! Its range of sorted keys
+				std::uint32_t firstKey;
+				std::uint32_t numKeys;
+
+				//! Its children, next to each other
+				std::uint32_t firstChild;
+				std::uint32_t numChildren;
+
+				//! The character following the prefix of the parent, that leads here
+				char label;
+			};
+
+			//! Sorted, without duplicates
+			std::vector<std::string_view> keys;
+
+			//! The root comes first
+			std::vector<Node> nodes;
+		};
+	}
+}
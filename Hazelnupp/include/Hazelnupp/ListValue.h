@@ -4,45 +4,35 @@
 
 namespace Hazelnp
 {
-	/** Specializations for list values (uses std::vector<Value*>)
+	/** Facade for list values (uses std::vector<Value*>)
+	* Lists parsed from elements sharing a type store them contiguously, and only build these values on first access.
 	*/
 	class ListValue : public Value
 	{
 	public:
+		//! Will construct an empty list, owning its values
 		ListValue();
-		~ListValue() override;
 
-		//! Will return a deeopopy of this object
-		Value* Deepcopy() const override;
-
-		//! Will return a string suitable for an std::ostream;
-		std::string GetAsOsString() const override;
-
-		//! Will add this value to the list
+		//! Will add this value to the list.  
+		//! Lists assembled like this only store their elements as values. Their typed accessors work for empty lists only.
 		void AddValue(const Value* value);
 
 		//! Will return the raw value
 		const std::vector<Value*>& GetValue() const;
 
-		operator std::vector<Value*>() const;
-
-		//! Throws HazelnuppValueNotConvertibleException
-		long long int GetInt64() const override;
-		//! Throws HazelnuppValueNotConvertibleException
-		int GetInt32() const override;
+		//! Will return whether this list owns its values, or they belong to an arena
+		bool IsOwning() const;
 
-		//! Throws HazelnuppValueNotConvertibleException
-		long double GetFloat64() const override;
-		//! Throws HazelnuppValueNotConvertibleException
-		double GetFloat32() const override;
+		operator std::vector<Value*>() const;
 
-		//! Throws HazelnuppValueNotConvertibleException
-		std::string GetString() const override;
+	private:
+		//! Will construct a list over storage, which lives in an arena aswell
+		explicit ListValue(Internal::ListStorage* storage);
 
-		//! Will return this values list
-		const std::vector<Value*>& GetList() const override;
+		//! Will add a value to the list without copying it.
+		//! Only for lists not owning their values. Value has to live in the same arena as this list.
+		void AddValueReference(Value* value);
 
-	private:
-		std::vector<Value*> value;
+		friend class ParseResult;
 	};
 }
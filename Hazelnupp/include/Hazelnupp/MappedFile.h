@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+namespace Hazelnp
+{
+	namespace Internal
+	{
+		/** Internal copy-on-write memory mapping of a whole file.
+		* Writing to it never touches the file. Only pages written to get copied.
+		*/
+		class MappedFile
+		{
+		public:
+			MappedFile() = default;
+			~MappedFile();
+
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			//! Will map the file at path. Returns nullptr on success, or why it failed otherwise.
+			const char* Map(const std::string& path);
+
+			//! Will return the mapped contents. nullptr, if the file is empty.
+			char* Data() const
+			{
+				return data;
+			}
+
+			//! Will return the size of the file
+			std::size_t Size() const
+			{
+				return size;
+			}
+
+		private:
+			char* data = nullptr;
+			std::size_t size = 0;
+
+#ifdef _WIN32
+			void* file = nullptr;
+			void* mapping = nullptr;
+#endif
+		};
+	}
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "DataType.h"
+#include "RepeatPolicy.h"
 #include <string>
 #include <vector>
 
@@ -96,6 +97,26 @@ namespace Hazelnp
 			return pc;
 		}
 
+		//! Constructs a repeat policy constraint.  
+		//! This decides what happens if the parameter is supplied more than once. Like appending all values to one list.
+		static ParamConstraint RepeatPolicy(REPEAT_POLICY repeatPolicy)
+		{
+			ParamConstraint pc;
+			pc.repeatPolicy = repeatPolicy;
+
+			return pc;
+		}
+
+		//! Daisychain-method. Will add a the "repeat-policy" aspect.  
+		//! This decides what happens if the parameter is supplied more than once. Like appending all values to one list.
+		ParamConstraint AddRepeatPolicy(REPEAT_POLICY repeatPolicy)
+		{
+			ParamConstraint pc = *this;
+			pc.repeatPolicy = repeatPolicy;
+
+			return pc;
+		}
+
 		//! Whole constructor
 		ParamConstraint(bool constrainType, DATA_TYPE requiredType, const std::initializer_list<std::string>& defaultValue, bool required, const std::initializer_list<std::string>& incompatibleParameters)
 			:
@@ -127,11 +148,20 @@ namespace Hazelnp
 		//! Parameters that are incompatible with this parameter
 		std::vector<std::string> incompatibleParameters;
 
+		//! What happens if this parameter is supplied more than once.  
+		//! By default, the first occurrence is kept.
+		REPEAT_POLICY repeatPolicy = REPEAT_POLICY::KEEP_FIRST;
+
 	private:
 		//! The parameter this constraint is for.
 		//! This value is automatically set by Hazelnupp.
 		std::string key;
 
-		friend class CmdArgsInterface;
+		//! Dense id of this parameter, assigned on registration. Indexes the bit masks of the schema, and the slots of the parse results.
+		//! This value is automatically set by Hazelnupp.
+		std::size_t id = (std::size_t)-1;
+
+		friend class Schema;
+		friend class ParseResult;
 	};
 }
@@ -0,0 +1,112 @@
+#pragma once
+#include "Value.h"
+#include "DataType.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace Hazelnp
+{
+	namespace Internal
+	{
+		/** Maps a C++ type to the DATA_TYPE a ParamHandle enforces, and to the accessor reading it.
+		* Not specialized for a type? Then it can not be used with a ParamHandle.
+		*/
+		template <typename T>
+		struct ParamTraits;
+
+		template <>
+		struct ParamTraits<long long int>
+		{
+			static constexpr DATA_TYPE type = DATA_TYPE::INT;
+			typedef long long int ReturnType;
+			static ReturnType Read(const Value& value) { return value.GetInt64(); }
+		};
+
+		template <>
+		struct ParamTraits<int>
+		{
+			static constexpr DATA_TYPE type = DATA_TYPE::INT;
+			typedef int ReturnType;
+			static ReturnType Read(const Value& value) { return value.GetInt32(); }
+		};
+
+		template <>
+		struct ParamTraits<long double>
+		{
+			static constexpr DATA_TYPE type = DATA_TYPE::FLOAT;
+			typedef long double ReturnType;
+			static ReturnType Read(const Value& value) { return value.GetFloat64(); }
+		};
+
+		template <>
+		struct ParamTraits<double>
+		{
+			static constexpr DATA_TYPE type = DATA_TYPE::FLOAT;
+			typedef double ReturnType;
+			static ReturnType Read(const Value& value) { return value.GetFloat32(); }
+		};
+
+		template <>
+		struct ParamTraits<std::string_view>
+		{
+			static constexpr DATA_TYPE type = DATA_TYPE::STRING;
+			typedef std::string_view ReturnType;
+			static ReturnType Read(const Value& value) { return value.GetStringView(); }
+		};
+
+		template <>
+		struct ParamTraits<std::string>
+		{
+			static constexpr DATA_TYPE type = DATA_TYPE::STRING;
+			typedef std::string ReturnType;
+			static ReturnType Read(const Value& value) { return value.GetString(); }
+		};
+
+		template <>
+		struct ParamTraits<void>
+		{
+			static constexpr DATA_TYPE type = DATA_TYPE::VOID;
+			typedef void ReturnType;
+			static ReturnType Read(const Value&) { return; }
+		};
+	}
+
+	/** Typed handle to a parameter, as returned by Schema::RegisterParameter() or Schema::GetHandle().
+	* Reading through it indexes straight into the parse results. No hashing, no string comparisons.
+	* T is one of long long int, int, long double, double, std::string_view, std::string or void.
+	* Its type is enforced via a type-safety constraint.
+	*/
+	template <typename T>
+	class ParamHandle
+	{
+	public:
+		//! Constructs an invalid handle. Reading through it will throw.
+		ParamHandle() = default;
+
+		//! Returns whether this handle refers to a parameter
+		bool IsValid() const
+		{
+			return id != invalidId;
+		}
+
+		//! The data type this handle enforces
+		static constexpr DATA_TYPE type = Internal::ParamTraits<T>::type;
+
+	private:
+		static constexpr std::size_t invalidId = (std::size_t)-1;
+
+		explicit ParamHandle(std::size_t id)
+			:
+			id { id }
+		{
+			return;
+		}
+
+		//! Index into the parse results of any ParseResult parsing against the Schema that issued this handle
+		std::size_t id = invalidId;
+
+		friend class Schema;
+		friend class ParseResult;
+	};
+}
@@ -1,21 +1,80 @@
 #pragma once
 #include "Value.h"
 #include <string>
+#include <string_view>
 #include <ostream>
+#include <atomic>
 
 namespace Hazelnp
 {
+	class ParseResult;
+
+	/** Where the value of a parameter came from. Sources further up take precedence over those further down.
+	*/
+	enum class PARAM_SOURCE
+	{
+		COMMAND_LINE,
+		ENVIRONMENT,
+		CONFIG_FILE,
+		DEFAULT_VALUE
+	};
+
+	static inline std::string ParamSourceToString(PARAM_SOURCE source)
+	{
+		switch (source)
+		{
+		case PARAM_SOURCE::COMMAND_LINE:
+			return "COMMAND_LINE";
+
+		case PARAM_SOURCE::ENVIRONMENT:
+			return "ENVIRONMENT";
+
+		case PARAM_SOURCE::CONFIG_FILE:
+			return "CONFIG_FILE";
+
+		case PARAM_SOURCE::DEFAULT_VALUE:
+			return "DEFAULT_VALUE";
+		}
+
+		return "";
+	}
+
 	class Parameter
 	{
 	public:
-		explicit Parameter(const std::string& key, const Value* value);
+		//! Will construct a parameter. Neither the key, nor the value, nor the origin get copied or owned.  
+		//! Parameters, and what they reference, live in the arena of the CmdArgsInterface that created them.
+		explicit Parameter(std::string_view key, Value* value, PARAM_SOURCE source = PARAM_SOURCE::COMMAND_LINE, std::string_view origin = std::string_view());
+		Parameter(const Parameter&) = delete;
 		~Parameter();
 
-		//! Will return the key of this parameter
+		//! Will return the key of this parameter. The std::string gets built on first call, and is kept as long as this parameter lives.
 		const std::string& Key() const;
 
+		//! Will return the key of this parameter, without copying it
+		std::string_view KeyView() const
+		{
+			return key;
+		}
+
 		//! Will return the value of this parameter
-		const Value* GetValue() const;
+		const Value* GetValue() const
+		{
+			return value;
+		}
+
+		//! Will return where the value of this parameter came from
+		PARAM_SOURCE GetSource() const
+		{
+			return source;
+		}
+
+		//! Will return the environment variable, or the path of the config file, the value was taken from.  
+		//! Empty for the command line and default values.
+		std::string_view GetOrigin() const
+		{
+			return origin;
+		}
 
 		friend std::ostream& operator<< (std::ostream& os, const Parameter& p)
 		{
@@ -23,7 +82,18 @@ namespace Hazelnp
 		}
 
 	private:
-		std::string key;
+		std::string_view key;
 		Hazelnp::Value* value;
+		std::string_view origin;
+		PARAM_SOURCE source;
+
+		//! The ParseResult this parameter lives in. It owns the std::string of Key(). nullptr, if there is none.
+		ParseResult* owner = nullptr;
+
+		//! The key as an std::string, once Key() got called
+		mutable std::atomic<const std::string*> keyString { nullptr };
+
+		//! Sets the value of appended parameters, once all of their occurrences are known, and the owner of each
+		friend class ParseResult;
 	};
 }
@@ -0,0 +1,570 @@
+#pragma once
+#include "Parameter.h"
+#include "Schema.h"
+#include "Arena.h"
+#include "ResponseFile.h"
+#include "ConfigFile.h"
+#include "Instrumentation.h"
+#include "HazelnuppException.h"
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <utility>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <memory_resource>
+
+namespace Hazelnp
+{
+	namespace Internal
+	{
+		/** Internal raw tokens of a lazily parsed parameter, and what it takes to convert them later on.
+		* Lives in the arena of its ParseResult.
+		*/
+		struct LazySource
+		{
+			ParseResult* owner;
+			const std::string_view* tokens;
+			std::size_t numTokens;
+
+			// The type constraint, if any
+			bool constrainType;
+			DATA_TYPE requiredType;
+			std::string_view key;
+		};
+	}
+
+	/** The parameters parsed from one command line, against a Schema.
+	* Holds nothing but parse state, so each thread can have its own ones, all parsing against the same frozen schema.
+	* Can parse any number of times. Each Parse() drops the previous results, but keeps all memory reserved.
+	*/
+	class ParseResult
+	{
+	public:
+		//! Will construct a ParseResult for schema, whose results request their memory from upstream.  
+		//! IMPORTANT: The schema is referenced, not copied. It must outlive this object!
+		explicit ParseResult(const Schema& schema, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+		ParseResult(const ParseResult&) = delete;
+		ParseResult& operator=(const ParseResult&) = delete;
+
+		~ParseResult();
+
+		//! Will parse command line arguments.  
+		//! Results of a previous parse are dropped. All memory reserved is kept.  
+		//! Once warmed up with similar input, parsing again does not allocate at all.  
+		//! Throws a HazelnuppException if the arguments violate the schema.
+		void Parse(const int argc, const char* const* argv);
+
+		//! Will drop all parse results, but keep all memory reserved for the next Parse().
+		void Reset();
+
+		//! Gets called with each parameter, as soon as its value list is complete. Whilst parsing, not after.
+		typedef std::function<void(const Parameter&)> ParameterCallback;
+
+		//! Sets a callback to call with each parameter, as soon as its value list is complete.  
+		//! Fires during Parse() and streams alike, in the order parameters appear. Repeated keys only fire once,  
+		//! unless their repeat policy keeps the last occurrence. Then each occurrence fires.  
+		//! Parameters appended to fire once all parameters are parsed, with all of their values.  
+		//! Parameters filled in from default values are not announced. Read them after parsing is done.
+		void SetParameterCallback(const ParameterCallback& callback);
+
+		//! Returns the callback called with each parameter, as soon as its value list is complete
+		const ParameterCallback& GetParameterCallback() const;
+
+		//! Will begin parsing a stream of tokens, arriving one at a time, or in chunks.  
+		//! Just like Parse(), results of a previous parse are dropped. All memory reserved is kept.  
+		//! Each parameter is parsed as soon as its value list is complete, which is when the next key arrives.
+		void BeginStream(std::string_view executableName = "");
+
+		//! Will push the next token of the stream. It gets copied, so the callers buffer may be reused right away.  
+		//! Throws a HazelnuppException if its parameter completes, and violates its type constraint.
+		void Push(std::string_view token);
+
+		//! Will push the next tokens of the stream. They get copied, so the callers buffers may be reused right away.
+		void Push(const std::string_view* tokens, const std::size_t numTokens);
+
+		//! Will push a chunk of raw stream data, like read from stdin, a pipe or a socket.  
+		//! Each delimiter ends a token. A token may span several chunks.
+		void PushChunk(std::string_view chunk, const char delimiter = '\n');
+
+		//! Will end the stream. Parses the last parameter, and applies the remaining constraints.  
+		//! Throws a HazelnuppException if required parameters are missing, or incompatible ones are present.
+		void EndStream();
+
+		//! Returns whether a stream has begun, and not ended yet
+		bool IsStreaming() const;
+
+		//! Will return argv[0], the name of the executable.
+		const std::string& GetExecutableName() const;
+
+		//! Will return the value given a key
+		const Value& operator[](const std::string& key) const;
+
+		//! Will check wether a parameter exists given a key, or not
+		bool HasParam(const std::string& key) const;
+
+		//! Will return the value given a handle. This is just a bounds-checked array access.  
+		//! Its type is already fixed by the handle. Throws HazelnuppInvalidKeyException if the parameter does not exist.
+		template <typename T>
+		typename Internal::ParamTraits<T>::ReturnType operator[](const ParamHandle<T>& handle) const
+		{
+			const Parameter* param = FindParameter(handle.id);
+			if (param == nullptr)
+				throw HazelnuppInvalidKeyException();
+
+			return Internal::ParamTraits<T>::Read(*param->GetValue());
+		}
+
+		//! Will check wether a parameter exists given a handle, or not
+		template <typename T>
+		bool HasParam(const ParamHandle<T>& handle) const
+		{
+			return FindParameter(handle.id) != nullptr;
+		}
+
+		//! Will return where the value of a parameter came from: the command line, the environment, a config file, or its default value.  
+		//! Throws HazelnuppInvalidKeyException if the parameter does not exist.
+		PARAM_SOURCE GetSource(const std::string& key) const;
+
+		//! Will return where the value of a parameter came from, given a handle.  
+		//! Throws HazelnuppInvalidKeyException if the parameter does not exist.
+		template <typename T>
+		PARAM_SOURCE GetSource(const ParamHandle<T>& handle) const
+		{
+			const Parameter* param = FindParameter(handle.id);
+			if (param == nullptr)
+				throw HazelnuppInvalidKeyException();
+
+			return param->GetSource();
+		}
+
+		//! Will return the environment variable, or the path of the config file, the value of a parameter was taken from.  
+		//! Empty for the command line and default values. Throws HazelnuppInvalidKeyException if the parameter does not exist.
+		std::string_view GetOrigin(const std::string& key) const;
+
+		//! Sets whether Parse() should reference the callers argv directly, instead of copying it into one internal buffer.  
+		//! IMPORTANT: If enabled, argv must outlive this object, as all keys and string values will point into it!
+		void SetBorrowArgv(bool borrowArgv);
+
+		//! Returns whether Parse() references the callers argv directly, instead of copying it into one internal buffer.
+		bool GetBorrowArgv() const;
+
+		//! Sets whether Parse() should replace arguments like @args.txt with the arguments listed in that file.  
+		//! The file gets memory-mapped, and its tokens are referenced in place, until the next Parse().  
+		//! Response files may list further response files. Relative paths are relative to the listing file.
+		void SetExpandResponseFiles(bool expandResponseFiles);
+
+		//! Returns whether Parse() replaces arguments like @args.txt with the arguments listed in that file.
+		bool GetExpandResponseFiles() const;
+
+		//! Sets how deep response files may be nested. A response file passed on the command line has depth 1.  
+		//! Parse() throws a HazelnuppResponseFileException beyond that. Guards against files listing themselves.
+		void SetMaxResponseFileDepth(std::size_t maxResponseFileDepth);
+
+		//! Returns how deep response files may be nested
+		std::size_t GetMaxResponseFileDepth() const;
+
+		//! Will load a config file of INI/TOML-style key = value lines. Its keys share the namespace of --key arguments.  
+		//! Values of config files rank below the command line and the environment, but above default values.  
+		//! Of several config files, the one loaded last takes precedence. All of them get merged on each parse,  
+		//! and the merged result gets converted and constrained just like the command line.  
+		//! The file gets memory-mapped and parsed right away, and its values are referenced in place until ClearConfigFiles().  
+		//! Throws a HazelnuppConfigFileException if it can not be read, or is malformed.
+		void LoadConfigFile(const std::string& path);
+
+		//! Will unload all config files. Drops the results of the last parse aswell, as they may reference them.
+		void ClearConfigFiles();
+
+		//! Sets the environment parameters bound to environment variables take their values from. Like the envp of main().  
+		//! nullptr, the default, reads the environment of the process. It gets read once per parse, into a hashed snapshot.  
+		//! Values taken from it rank between the command line and config files, and get converted and constrained just the same.  
+		//! IMPORTANT: The environment is referenced, not copied. It must outlive this object, or be unset!
+		void SetEnvironment(const char* const* environment);
+
+		//! Returns the environment bound parameters take their values from. nullptr if it is the one of the process.
+		const char* const* GetEnvironment() const;
+
+		//! Will return the schema this parses against
+		const Schema& GetSchema() const;
+
+		//! Sets whether values should only be converted once they are accessed, instead of whilst parsing.  
+		//! Parameters then keep their raw tokens. Type inference and conversion happen on first access, and get cached.  
+		//! Lists get converted as a whole, on first access. Accessing values from several threads is safe.  
+		//! Type-constraint violations throw on access then, or right away via Validate().
+		void SetLazyConversion(bool lazyConversion);
+
+		//! Returns whether values are only converted once they are accessed
+		bool GetLazyConversion() const;
+
+		//! Will convert all values right away, and throw the first type-constraint violation, if any.  
+		//! Without lazy conversion, all values are converted whilst parsing already, so this does nothing.
+		void Validate() const;
+
+		//! Sets a sink to pass the statistics of each Parse() and EndStream() call to. nullptr for none.  
+		//! Statistics only get recorded if instrumentation is enabled. See g_instrumentationEnabled.  
+		//! IMPORTANT: The sink is referenced, not copied. It must outlive this object, or be unset!
+		void SetInstrumentationSink(InstrumentationSink* sink);
+
+		//! Returns the sink the statistics get passed to. nullptr if there is none.
+		InstrumentationSink* GetInstrumentationSink() const;
+
+		//! Will return the statistics of the last Parse() or EndStream() call. All zero, unless instrumentation is enabled.  
+		//! Streams only record APPLY_CONSTRAINTS, and the time from BeginStream() to EndStream() as a whole.
+		const ParseStats& GetParseStats() const;
+
+	private:
+		//! Will reset the statistics, and mark the beginning of a call, if instrumentation is enabled
+		Internal::PhaseMark BeginCall();
+
+		//! Will mark the beginning of a phase, if instrumentation is enabled
+		Internal::PhaseMark BeginPhase() const;
+
+		//! Will record what happened since mark as phase, if instrumentation is enabled
+		void EndPhase(PARSE_PHASE phase, const Internal::PhaseMark& mark, std::size_t numTokens);
+
+		//! Will record the call that began at mark, and pass the statistics to the sink, if instrumentation is enabled
+		void EndCall(const Internal::PhaseMark& mark, bool succeeded);
+
+		//! Will translate the c-like args to an std::vector of views.  
+		//! These point either into argv directly, or into argvBuffer, depending on borrowArgv.
+		void PopulateRawArgs(const int argc, const char* const* argv);
+
+		//! Will map the response file at path, and append its tokens to rawArgs. Nested response files get expanded recursively.
+		void ExpandResponseFile(const std::string& path, const std::size_t depth);
+
+		//! Will return whether an arg names a response file, like @args.txt
+		static bool IsResponseFile(std::string_view arg);
+
+		//! Will replace all args matching an abbreviation with their long form (like -f for --force),  
+		//! and clusters of single character abbreviations with the long form of each (like -ltr for --long --time --reverse).
+		//! If the schema matches prefixes, unique prefixes of keys get replaced by those keys aswell (like --verb for --verbose).
+		void ExpandAbbreviations();
+
+		//! Will append arg to out, expanded if it is an abbreviation, a cluster of them, or a unique prefix of a key. Else as it is.  
+		//! If the arg appended before is a key taking exactly one value, arg is that value, and is never expanded.
+		void ExpandArg(std::string_view arg, std::vector<std::string_view>& out);
+
+		//! Will append the long forms of a cluster of single character abbreviations to out, like -ltr for --long --time --reverse.  
+		//! The first one taking values ends the cluster, and the rest is its value, like file of -vofile.  
+		//! Returns false, and appends nothing, if arg is no such cluster.
+		bool ExpandCluster(std::string_view arg, std::vector<std::string_view>& out);
+
+		//! Will return the long form of a single character abbreviation. Stays valid until the next parse.
+		std::string_view ExpandShortFlag(const Internal::ShortFlag& flag);
+
+		//! Will replace arg with its long form, if it is an abbreviation as a whole. The long form stays valid until the next parse.  
+		//! Returns whether it is one.
+		bool ExpandAbbreviation(std::string_view& arg);
+
+		//! Will return the key that key is a unique prefix of, like --verbose for --verb. Stays valid until the next parse.  
+		//! Returns key itself, if it is known, or the prefix of none. Throws a HazelnuppAmbiguousKeyException, if it is the prefix of several.
+		std::string_view MatchPrefix(std::string_view key);
+
+		//! Will remember arg as the one appended last. If it is a key, its arity only gets looked up once the next arg asks for it.
+		void RememberPrevious(std::string_view arg);
+
+		//! Will remember that the arg appended last is a key of known arity, like the long form of a short flag
+		void RememberPreviousArity(bool takesSingleValue);
+
+		//! Will return whether the arg appended last is a key taking exactly one value. Then the next arg is its value.  
+		//! Each key gets looked up once at most.
+		bool PreviousTakesSingleValue();
+
+		//! Will return whether an arg ends the value list of a parameter. This is the case if it begins with "--".  
+		//! If it is also longer than that, it is a key.
+		static bool IsParameterDelimiter(std::string_view arg);
+
+		//! Will parse and store all parameters in rawArgs, in a single forward scan
+		void ParseParameters();
+
+		//! Will parse the parameter with the key at keyIndex, and store it. Its values range up until endIndex (exclusive).  
+		//! If a parameter with the same key is already stored, its repeat policy decides what happens.  
+		//! Calls the parameter callback, if the parameter got stored.
+		void ParseParameter(const std::size_t keyIndex, const std::size_t endIndex);
+
+		//! Will parse the streamed parameter, if there is one, and drop its tokens
+		void FinishStreamedParameter();
+
+		//! The part of a constraint ParseValue() cares about. Taken either from a ParamConstraint, or from a ParamSpec.
+		struct TypeRequirement
+		{
+			TypeRequirement() = default;
+
+			TypeRequirement(const ParamConstraint& constraint)
+				:
+				constrainType { constraint.constrainType },
+				requiredType { constraint.requiredType },
+				key { constraint.key }
+			{
+				return;
+			}
+
+			TypeRequirement(const ParamSpec& spec)
+				:
+				constrainType { spec.constrainType },
+				requiredType { spec.requiredType },
+				key { spec.key },
+				isStatic { true }
+			{
+				return;
+			}
+
+			bool constrainType = false;
+			DATA_TYPE requiredType = DATA_TYPE::VOID;
+			std::string_view key;
+
+			//! Whether key stems from the static schema, and has static storage
+			bool isStatic = false;
+		};
+
+		//! The tokens of all occurrences of a parameter appended to so far. Lives in the arena.
+		struct Accumulation
+		{
+			Accumulation(Parameter* param, const TypeRequirement& requirement, std::pmr::memory_resource* resource)
+				:
+				param { param },
+				requirement { requirement },
+				tokens { resource }
+			{
+				return;
+			}
+
+			Parameter* param;
+			TypeRequirement requirement;
+
+			//! One contiguous buffer, grown geometrically, so that each occurrence only costs the copies of its views
+			std::pmr::vector<std::string_view> tokens;
+		};
+
+		//! Will store a parameter whose occurrences get appended to one list, and begin collecting their tokens.  
+		//! Its value gets set by FinishAccumulations(). Unconstrained ones become lists, no matter how many values there are.
+		Parameter* BeginAccumulation(std::string_view key, TypeRequirement requirement);
+
+		//! Will append the values of another occurrence to the tokens of an appended parameter
+		void Accumulate(const Parameter* param, const std::string_view* values, const std::size_t numValues);
+
+		//! Will convert the tokens of all appended parameters in one go each, and call the parameter callback with them.  
+		//! They are complete once all parameters are parsed.
+		void FinishAccumulations();
+
+		//! Will convert a range of string-values to an actual Value.  
+		//! String values will reference the passed strings, so these must outlive the returned value.
+		Value* ParseValue(const std::string_view* values, const std::size_t numValues, const TypeRequirement& constraint);
+
+		//! Will convert a range of string-values to a list. Elements sharing a type get stored contiguously,  
+		//! and only get built as values on first access to them. Elements of differing types get built right away.
+		Value* ParseList(const std::string_view* values, const std::size_t numValues);
+
+		//! Will build the elements of a list stored contiguously as values. Called by the list on first access, with lazyMutex locked.
+		std::vector<Value*>* NewListElements(const Internal::ListStorage& list);
+
+		//! Will return an empty vector to hold the elements of a list as values, until the next parse.  
+		//! Vectors get reused by the following parses, so that they keep their capacity.
+		std::vector<Value*>* NewElementVector(std::size_t capacity);
+
+		//! Will create a string value referencing str, in the arena. The std::string its GetValue() builds belongs to this.
+		Value* NewStringValue(std::string_view str);
+
+		//! Will create a parameter in the arena. The std::string its Key() builds belongs to this.
+		template <typename... Args>
+		Parameter* NewParameter(Args&&... args)
+		{
+			Parameter* param = arena.New<Parameter>(std::forward<Args>(args)...);
+			param->owner = this;
+
+			return param;
+		}
+
+		//! Will return an std::string holding str, until the next parse. Called by values and parameters asked for one, from any thread.  
+		//! Strings get reused by the following parses, so that they keep their capacity.
+		const std::string* NewCachedString(std::string_view str);
+
+		//! Will create a value keeping its raw tokens, that converts itself on first access.  
+		//! If copyTokens is false, the views onto the tokens are referenced, and have to live as long as the parse results.
+		Value* NewLazyValue(const std::string_view* values, const std::size_t numValues, const TypeRequirement& constraint, bool copyTokens);
+
+		//! Will convert the tokens of a lazily parsed parameter. Called by the value on first access, from any thread.
+		Value* ConvertLazily(const Internal::LazySource& source);
+
+		//! Will return the parsed parameter for a key, or nullptr if it was not supplied
+		const Parameter* FindParameter(std::string_view key) const;
+
+		//! Will return the parsed parameter for a handle id, or nullptr if it was not supplied
+		const Parameter* FindParameter(std::size_t handleId) const
+		{
+			// Handles into the static schema are flagged
+			if (handleId & Schema::staticHandleFlag)
+			{
+				const std::size_t id = handleId & ~Schema::staticHandleFlag;
+				return (id < numStaticSlots) ? staticParameters[id] : nullptr;
+			}
+
+			return (handleId < numIdSlots) ? parametersById[handleId] : nullptr;
+		}
+
+		//! Will store a parsed parameter of the static schema in its slot. Marks its dense id present, if runtime constraints gave it one.
+		void StoreStaticParameter(Parameter* param, const std::size_t id);
+
+		//! Will store a parsed parameter in the map, and in the slot of its dense id, if it has one.  
+		//! Keeps the first occurrence, unless replace is set. Returns false, if there already was one, and it was kept.
+		bool StoreParameter(Parameter* param, const std::size_t id, bool replace = false);
+
+		//! Will return a word of the presence mask. 0, beyond it.
+		std::uint64_t GetPresentWord(const std::size_t word) const
+		{
+			return (word < (numIdSlots + 63) / 64) ? presentIds[word] : 0;
+		}
+
+		//! Will delete all parameters of a previous parse, by rewinding the arena
+		void ClearParameters();
+
+		//! Will copy a string into the arena, and return a view onto the copy.  
+		//! Used for strings parameters have to reference, which do not stem from argv.
+		std::string_view StoreString(std::string_view str);
+
+		//! Will apply the loaded constraints on the loaded values, exluding types.
+		void ApplyConstraints();
+
+		//! Will create a parameter from values of another source than the command line, unless it is already present.  
+		//! Parameters of the static schema go into its slots, all others into the map. The key and the values are referenced.
+		void MergeParameter(std::string_view key, const std::string_view* values, const std::size_t numValues, PARAM_SOURCE source, std::string_view origin);
+
+		//! Will create parameters not supplied from the environment variables they are bound to
+		void MergeEnvironment();
+
+		//! Will create parameters not supplied from the config files. Later files take precedence.
+		void MergeConfigFiles();
+
+		//! Will convert the value of an environment variable, like the values following a key.  
+		//! Returns nullptr if the variable is not set.
+		Value* ParseEnvironmentVariable(std::string_view variable, const TypeRequirement& constraint);
+
+		//! Will return the snapshot of the environment, reading it on the first call of each parse
+		const std::pmr::unordered_map<std::string_view, std::string_view>& GetEnvironmentSnapshot();
+
+		//! What we parse against
+		const Schema* schema;
+
+		std::string executableName; //! The path of the executable. Always argv[0]
+
+		//! Everything a parse produces lives in here: Values, Parameters, lists and the parameter map.  
+		//! Gets rewound as a whole. Declared before parameters, because it has to be constructed first.
+		Internal::Arena arena;
+
+		//! The elements of lists as values. These are std::vectors, as GetList() hands them out, so they can not live in the arena.  
+		//! The first numElementVectorsInUse belong to the current parse. The others are kept for the next ones.
+		std::vector<std::unique_ptr<std::vector<Value*>>> elementVectors;
+		std::size_t numElementVectorsInUse = 0;
+
+		//! The std::strings handed out by the GetValue() of string values, and the Key() of parameters. Reused just like elementVectors.
+		std::vector<std::unique_ptr<std::string>> cachedStrings;
+		std::size_t numCachedStringsInUse = 0;
+
+		//! Parsed parameters. The keys reference the same memory as the parameters keys.  
+		//! Lives in the arena, and is recreated after each rewind.  
+		//! Parameters known to the static schema do not go in here, but into staticParameters.
+		typedef std::pmr::unordered_map<std::string_view, Parameter*> ParameterMap;
+		ParameterMap* parameters;
+
+		//! Parsed parameters of the static schema, indexed by spec id. nullptr, if not supplied.  
+		//! Lives in the arena, and is recreated after each rewind.
+		Parameter** staticParameters = nullptr;
+
+		//! Amount of slots in staticParameters. The schema may have changed since the last rewind.
+		std::size_t numStaticSlots = 0;
+
+		//! Parsed parameters, indexed by dense id. nullptr, if not supplied.  
+		//! Lives in the arena, and is recreated after each rewind.
+		Parameter** parametersById = nullptr;
+
+		//! One bit per dense id, set if the parameter is present. Lets constraints be checked a word at a time.  
+		//! Lives in the arena, and is recreated after each rewind.
+		std::uint64_t* presentIds = nullptr;
+
+		//! Amount of slots in parametersById. Ids issued after the last rewind have none yet.
+		std::size_t numIdSlots = 0;
+
+		//! Raw argv
+		std::vector<std::string_view> rawArgs;
+
+		//! The args with their abbreviations expanded, before being swapped with rawArgs. Kept, to reuse its capacity.
+		std::vector<std::string_view> expandedArgs;
+
+		//! One contiguous copy of all argv strings, referenced by rawArgs. Unused if borrowArgv is set.
+		std::string argvBuffer;
+
+		//! Reused to look string_views up in the std::string keyed maps of the schema, so that this does not allocate.  
+		//! (There is no heterogeneous lookup for unordered maps before C++20)
+		std::string lookupBuffer;
+
+		//! The arg ExpandArg() appended last, if it is a key whose arity is not looked up yet. Empty otherwise.
+		std::string_view previousKey;
+
+		//! Whether the arg ExpandArg() appended last is a key taking exactly one value. Only valid, if previousKey is empty.
+		bool previousTakesSingleValue = false;
+
+		//! If set to true, rawArgs, keys and string values will reference the callers argv, instead of argvBuffer.
+		bool borrowArgv = false;
+
+		//! Response files of the last parse. rawArgs, keys and string values reference their mappings.
+		std::vector<std::unique_ptr<Internal::ResponseFile>> responseFiles;
+
+		//! If set to true, args like @args.txt get replaced by the args listed in that file
+		bool expandResponseFiles = false;
+
+		//! How deep response files may be nested
+		std::size_t maxResponseFileDepth = 8;
+
+		//! Config files, in the order they were loaded. Parameters reference their keys, values and paths.
+		std::vector<std::unique_ptr<Internal::ConfigFile>> configFiles;
+
+		//! The environment bound parameters take their values from. nullptr for the one of the process.
+		const char* const* environment = nullptr;
+
+		//! The variables of the environment, mapped to their values. Read at most once per parse.  
+		//! Lives in the arena, and is nullptr after each rewind.
+		std::pmr::unordered_map<std::string_view, std::string_view>* environmentSnapshot = nullptr;
+
+		//! Parameters appended to, in the order they first occurred, and by the parameter, to find them again on repetition.  
+		//! Live in the arena, and are nullptr after each rewind.
+		std::pmr::vector<Accumulation*>* accumulations = nullptr;
+		std::pmr::unordered_map<const Parameter*, Accumulation*>* accumulationsByParameter = nullptr;
+
+		//! Called with each parameter, as soon as its value list is complete
+		ParameterCallback parameterCallback;
+
+		//! Set between BeginStream() and EndStream()
+		bool streaming = false;
+
+		//! Index of the key of the streamed parameter within rawArgs. 0, if the stream is not within a parameter.  
+		//! rawArgs only holds the executable name, and the tokens of this parameter.
+		std::size_t streamKeyIndex = 0;
+
+		//! The begin of a token pushed by PushChunk(), whose delimiter has not arrived yet
+		std::string pendingToken;
+
+		//! If set to true, values get converted on first access, instead of whilst parsing
+		bool lazyConversion = false;
+
+		//! Serializes lazy conversions that allocate from the arena, and handing out cached strings. Values may be accessed from several threads.
+		std::mutex lazyMutex;
+
+		//! Statistics of the last call. Only recorded if instrumentation is enabled.
+		ParseStats stats;
+
+		//! Values created since construction. Only counted if instrumentation is enabled.
+		std::size_t numValuesCreated = 0;
+
+		//! Where the current stream began. Only recorded if instrumentation is enabled.
+		Internal::PhaseMark streamMark;
+
+		//! Gets passed the statistics of each call
+		InstrumentationSink* instrumentationSink = nullptr;
+
+		friend class Value;
+		friend class Parameter;
+	};
+}
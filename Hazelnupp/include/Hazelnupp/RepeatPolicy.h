@@ -0,0 +1,42 @@
+#pragma once
+#include <string>
+
+namespace Hazelnp
+{
+	/** What happens if a parameter is supplied more than once on the command line
+	*/
+	enum class REPEAT_POLICY
+	{
+		//! Keep the first occurrence, and drop the others
+		KEEP_FIRST,
+
+		//! Keep the last occurrence, and drop the others
+		KEEP_LAST,
+
+		//! Collect the values of all occurrences, in order, into one list
+		APPEND,
+
+		//! Throw a HazelnuppConstraintRepeatedParameter
+		REJECT
+	};
+
+	static inline std::string RepeatPolicyToString(REPEAT_POLICY policy)
+	{
+		switch (policy)
+		{
+		case REPEAT_POLICY::KEEP_FIRST:
+			return "KEEP_FIRST";
+
+		case REPEAT_POLICY::KEEP_LAST:
+			return "KEEP_LAST";
+
+		case REPEAT_POLICY::APPEND:
+			return "APPEND";
+
+		case REPEAT_POLICY::REJECT:
+			return "REJECT";
+		}
+
+		return "";
+	}
+}
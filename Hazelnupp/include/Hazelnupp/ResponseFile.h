@@ -0,0 +1,50 @@
+#pragma once
+#include "MappedFile.h"
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+namespace Hazelnp
+{
+	namespace Internal
+	{
+		/** Internal memory-mapped response file (like @args.txt), tokenized in place.
+		* The file is mapped copy-on-write. Tokens are views into the mapping, so nothing gets copied.
+		* Only pages holding quoted or escaped tokens ever get written to, to unescape these in place.
+		*
+		* Tokens are separated by whitespace.
+		* A # at the beginning of a token comments out the rest of the line.
+		* Within '...', everything is literal. Within "...", a backslash escapes the next character. Outside of quotes aswell.
+		* Quoted and unquoted parts directly next to each other make up one token, just like in a shell.
+		*/
+		class ResponseFile
+		{
+		public:
+			//! Will map the file at path. Throws HazelnuppResponseFileException if it can't be read.
+			explicit ResponseFile(const std::string& path);
+
+			ResponseFile(const ResponseFile&) = delete;
+			ResponseFile& operator=(const ResponseFile&) = delete;
+
+			//! Will tokenize the next token, and return a view onto it. It stays valid as long as this object lives.  
+			//! out_isQuoted tells whether any part of it was quoted or escaped.  
+			//! Returns false if there are no tokens left. Throws HazelnuppResponseFileException on an unterminated quote.
+			bool NextToken(std::string_view& out_token, bool& out_isQuoted);
+
+			//! Will return the path of this file
+			const std::string& GetPath() const;
+
+		private:
+			std::string path;
+
+			MappedFile file;
+
+			//! The mapped contents. nullptr, if the file is empty.
+			char* data = nullptr;
+			std::size_t size = 0;
+
+			//! Where the next token begins, or whitespace before it
+			std::size_t cursor = 0;
+		};
+	}
+}
@@ -0,0 +1,337 @@
+#pragma once
+#include "ParamConstraint.h"
+#include "StaticSchema.h"
+#include "ParamHandle.h"
+#include "Instrumentation.h"
+#include "KeyIndex.h"
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+namespace Hazelnp
+{
+	namespace Internal
+	{
+		/** Internal entry of the short flag table. Tells what a single-character abbreviation, like -f, stands for.
+		*/
+		struct ShortFlag
+		{
+			//! Its long form. Empty, if the character is no abbreviation.
+			std::string_view longForm;
+
+			//! Whether the long form stems from the static schema, and has static storage
+			bool isStatic = false;
+
+			//! Whether it takes values at all, going by its constraint. Then the rest of a cluster, like file of -ofile, is its value.
+			bool takesValue = false;
+
+			//! Whether it takes exactly one value. Then the next arg is its value.
+			bool takesSingleValue = false;
+		};
+	}
+
+	/** Everything known about the parameters before parsing: abbreviations, constraints and descriptions.
+	* Once frozen, a schema is immutable, and any amount of ParseResults may parse against it concurrently, without locking.
+	*/
+	class Schema
+	{
+	public:
+		Schema();
+
+		// Abbreviations
+		//! Will register an abbreviation (like -f for --force)
+		void RegisterAbbreviation(const std::string& abbrev, const std::string& target);
+
+		//! Will return the long form of an abbreviation (like --force for -f)  
+		//! Returns "" if no match is found
+		const std::string& GetAbbreviation(const std::string& abbrev) const;
+
+		//! Will check wether or not an abbreviation is registered
+		bool HasAbbreviation(const std::string& abbrev) const;
+
+		//! Will delete the abbreviation for a given parameter.  
+		//! IMPORTANT: This parameter is the abbreviation! Not the long form!
+		void ClearAbbreviation(const std::string& abbrevation);
+
+		//! Will delete all abbreviations
+		void ClearAbbreviations();
+
+		//! Sets whether keys may be shortened to any unique prefix, like --verb for --verbose, just like getopt_long allows.  
+		//! Only keys anything is known about get matched. Exact keys and abbreviations, like --v, always win, and unknown ones stay as they are.  
+		//! A prefix of several keys, like --ver of --verbose and --version, throws a HazelnuppAmbiguousKeyException.
+		void SetMatchUniquePrefixes(bool matchUniquePrefixes);
+
+		//! Returns whether keys may be shortened to any unique prefix
+		bool GetMatchUniquePrefixes() const;
+
+		// Environment variables
+		//! Will bind a parameter to an environment variable (like --verbose to APP_VERBOSE).  
+		//! If the parameter is not supplied, its value gets taken from that variable, before resorting to config files, and its default value.  
+		//! Parameters constrained to lists split the value at whitespace. Others take it as one value. An empty variable has no values.  
+		//! Will overwrite an existing binding of that parameter.
+		void RegisterEnvironmentVariable(const std::string& key, const std::string& variable);
+
+		//! Will return the environment variable a parameter is bound to.  
+		//! Returns "" if it is bound to none
+		const std::string& GetEnvironmentVariable(const std::string& key) const;
+
+		//! Will check wether or not a parameter is bound to an environment variable
+		bool HasEnvironmentVariable(const std::string& key) const;
+
+		//! Will delete the environment variable binding of a parameter
+		void ClearEnvironmentVariable(const std::string& key);
+
+		//! Will delete all environment variable bindings
+		void ClearEnvironmentVariables();
+
+		//! Will register a constraint for a parameter.
+		//! IMPORTANT: Any parameter can only have ONE constraint. Applying a new one will overwrite the old one!
+		//! Construct the ParamConstraint struct yourself to combine Require, TypeSafety and Incompatibilities! You can also use the ParamConstraint constructor!
+		void RegisterConstraint(const std::string& key, const ParamConstraint& constraint);
+
+		//! Will return the constraint information for a specific parameter
+		ParamConstraint GetConstraint(const std::string& parameter) const;
+
+		//! Will the constraint of a specific parameter
+		void ClearConstraint(const std::string& parameter);
+
+		//! Will delete all constraints
+		void ClearConstraints();
+
+		//! Will register a constraint for a parameter, and return a typed handle to it.  
+		//! A type-safety aspect for T gets added to the constraint.
+		template <typename T>
+		ParamHandle<T> RegisterParameter(const std::string& key, ParamConstraint constraint = ParamConstraint())
+		{
+			RegisterConstraint(key, constraint.AddTypeSafety(ParamHandle<T>::type));
+			return GetHandle<T>(key);
+		}
+
+		//! Will return a typed handle to a parameter, that is already registered at runtime or in the static schema.  
+		//! It has to be constrained to the type of T. Throws HazelnuppException otherwise.  
+		//! Handles into the static schema stay valid as long as the schema stays in use.
+		template <typename T>
+		ParamHandle<T> GetHandle(const std::string& key)
+		{
+			return ParamHandle<T>(AcquireHandle(key, ParamHandle<T>::type));
+		}
+
+		//! Will use a compile-time schema for keys, abbreviations, constraints and descriptions.  
+		//! Its keys are looked up through a perfect hash table, and their results are stored by id. No map involved.  
+		//! Runtime registrations still apply to keys the schema does not know. The Get/Has/Clear methods above only concern those.  
+		//! IMPORTANT: The schema is referenced, not copied. It must outlive this object!
+		template <std::size_t N>
+		void SetStaticSchema(const StaticSchema<N>& schema)
+		{
+			BeginChange();
+			staticSchema = schema.View();
+			UpdateShortFlags();
+			return;
+		}
+
+		//! Will stop using the compile-time schema
+		void ClearStaticSchema();
+
+		//! Returns whether or not a compile-time schema is in use
+		bool HasStaticSchema() const;
+
+		//! Sets a brief description of the application to be automatically added to the documentation.
+		void SetBriefDescription(const std::string& description);
+
+		//! Returns the brief description of the application to be automatically added to the documentation.
+		const std::string& GetBriefDescription() const;
+
+		//! Willl register a short description for a parameter.  
+		//! Will overwrite existing descriptions for that parameter.
+		void RegisterDescription(const std::string& parameter, const std::string& description);
+
+		//! Will return a short description for a parameter, if it exists.  
+		//! Empty string if it does not exist.
+		const std::string& GetDescription(const std::string& parameter) const;
+
+		//! Returns whether or not a given parameter has a registered description
+		bool HasDescription(const std::string& parameter) const;
+
+		//! Will delete the description of a parameter if it exists.
+		void ClearDescription(const std::string& parameter);
+
+		//! Will delete all parameter descriptions
+		void ClearDescriptions();
+
+		//! Sets the column to wrap documentation lines at. Wrapped lines get indented. 0 does not wrap at all, which is the default.
+		void SetDocumentationWidth(std::size_t documentationWidth);
+
+		//! Returns the column documentation lines get wrapped at. 0 if they do not get wrapped.
+		std::size_t GetDocumentationWidth() const;
+
+		//! Will generate a text-based documentation suited to show the user, for example on --help.  
+		//! Parameters are sorted by key. It is rendered once, and cached until anything registered changes.
+		const std::string& GenerateDocumentation() const;
+
+		//! Will generate the documentation of a single parameter, without rendering the whole document.  
+		//! key may be an abbreviation aswell. Returns an empty string, if nothing is known about it.
+		std::string GenerateParameterDocumentation(const std::string& key) const;
+
+		//! Will write the documentation, followed by a line break, straight to a file descriptor, like 1 for stdout.  
+		//! Returns false, if it could not be written completely.
+		bool WriteDocumentation(int fd) const;
+
+		//! Sets a sink to pass the statistics of each documentation rendering to. nullptr for none.  
+		//! Statistics only get recorded if instrumentation is enabled. See g_instrumentationEnabled.  
+		//! IMPORTANT: The sink is referenced, not copied. It must outlive this object, or be unset!
+		void SetInstrumentationSink(InstrumentationSink* sink);
+
+		//! Returns the sink the statistics of documentation renderings get passed to. nullptr if there is none.
+		InstrumentationSink* GetInstrumentationSink() const;
+
+		//! Will make this schema immutable. Any attempt to change it afterwards throws a HazelnuppException.  
+		//! Freeze a schema before sharing it between threads. This renders the documentation, and indexes the keys, aswell.
+		void Freeze();
+
+		//! Returns whether or not this schema is immutable
+		bool IsFrozen() const;
+
+	private:
+		//! Throws a HazelnuppException if this schema is frozen.  
+		//! Else it drops the cached documentation and key index, as something is about to change.
+		void BeginChange();
+
+		//! Will render the documentation into the cache
+		void RenderDocumentation() const;
+
+		//! Will return the index over all keys anything is known about, to match prefixes against. Builds it, if it is not valid.
+		const Internal::KeyIndex& GetKeyIndex() const;
+
+		//! Will append the documentation entry of a parameter to out.  
+		//! Returns false, and appends nothing, if nothing is known about it.
+		bool AppendParameterDocumentation(std::string& out, const std::string& key, std::string_view abbreviation) const;
+
+		//! Will return the first abbreviation of a key, in sorted order. From the registered ones, or the static schema.
+		std::string_view FindAbbreviationOf(const std::string& key) const;
+
+		//! Will find out whether a parameter takes values at all, and whether it takes exactly one, going by its type constraint.  
+		//! Parameters appended to take values aswell, unless constrained to void.
+		void FindArity(const std::string& key, bool& out_takesValue, bool& out_takesSingleValue) const;
+
+		//! Will return whether a parameter takes exactly one value, going by its type constraint.  
+		//! The arg following it is its value then, and is never expanded, even if it looks like an abbreviation.
+		bool TakesSingleValue(const std::string& key) const;
+
+		//! Will return whether an abbreviation is a single character, like -f. These go into the short flag table, and may be clustered.
+		static bool IsShortFlag(std::string_view abbreviation);
+
+		//! Will look up what the single character abbreviation -c stands for, and put it into the short flag table
+		void UpdateShortFlag(unsigned char c);
+
+		//! Will rebuild the short flag table as a whole, and recount the other abbreviations
+		void UpdateShortFlags();
+
+		//! Will update the entries of the short flag table that stand for key, as its constraint changed
+		void UpdateShortFlagsOf(const std::string& key);
+
+		//! Will return a pointer to a paramConstraint given a key. If there is no, it returns nullptr
+		const ParamConstraint* GetConstraintForKey(const std::string& key) const;
+
+		//! Will return the description of a parameter, from the static schema or from the registered ones
+		std::string_view FindDescription(std::string_view key) const;
+
+		//! Will return the handle id of a registered key. This is just its dense id.  
+		//! Throws if key is not constrained to type.
+		std::size_t AcquireHandle(const std::string& key, DATA_TYPE type) const;
+
+		//! Will return the dense id of a key, and assign one if it has none yet
+		std::size_t AssignId(const std::string& key);
+
+		//! Will return the dense id of a key, or npos, if it has none
+		std::size_t FindId(const std::string& key) const;
+
+		//! Will compile the constraint of an id into the bit masks. Clears its bits, if it has no constraint (anymore).
+		void CompileConstraint(const std::size_t id);
+
+		//! Will remove the constraint of key, but keep its id, so that handles and incompatibilities referencing it stay valid
+		void UnregisterConstraint(const std::unordered_map<std::string, ParamConstraint>::iterator& constraint);
+
+		//! These are abbreviations. Like, -f for --force.
+		std::unordered_map<std::string, std::string> parameterAbreviations;
+
+		//! Single character abbreviations, from the static schema and the registered ones, indexed by their character.  
+		//! Kept up to date on each change, so that expanding them, and clusters of them like -ltr, is just a table read per character.  
+		//! Long forms of registered ones reference parameterAbreviations.
+		std::array<Internal::ShortFlag, 256> shortFlags;
+
+		//! Amount of abbreviations not in shortFlags, like -mv, from the static schema and the registered ones.  
+		//! Only if there are any, args have to be looked up as a whole.
+		std::size_t numLongAbbreviations = 0;
+
+		//! Environment variables, mapped to the keys bound to them
+		std::unordered_map<std::string, std::string> environmentVariables;
+
+		//! Parameter constraints, mapped to keys
+		std::unordered_map<std::string, ParamConstraint> parameterConstraints;
+
+		//! Short descriptions for parameters  
+		//! First member is the abbreviation
+		std::unordered_map<std::string, std::string> parameterDescriptions;
+
+		//! A brief description of the application to be added to the generated documentation. Optional.
+		std::string briefDescription;
+
+		//! The compile-time schema in use. Has no specs, if there is none.
+		Internal::StaticSchemaView staticSchema;
+
+		//! Handle ids into the static schema carry this flag. Others are dense ids, and index the slots of a ParseResult.
+		static constexpr std::size_t staticHandleFlag = ((std::size_t)-1 >> 1) + 1;
+
+		//! Returned by FindId(), if a key has no id
+		static constexpr std::size_t npos = (std::size_t)-1;
+
+		//! Dense ids of keys without a constraint, that are listed as incompatibilities, or had a constraint before.  
+		//! Keys with a constraint carry their id in it.
+		std::unordered_map<std::string, std::size_t> unconstrainedIds;
+
+		//! Amount of dense ids issued
+		std::size_t numIds = 0;
+
+		//! The constraint of each id. nullptr, if it has none.
+		std::vector<const ParamConstraint*> constraintsById;
+
+		//! Bit masks over ids, compiled from the constraints on registration. One bit per id.  
+		//! Parameters required, that have no default value.
+		std::vector<std::uint64_t> requiredMask;
+
+		//! Parameters that have a default value
+		std::vector<std::uint64_t> defaultMask;
+
+		//! Parameters that are incompatible with any others
+		std::vector<std::uint64_t> incompatibleMask;
+
+		//! For each id, the ids it is incompatible with, as a bit mask. Only as long as needed, so mostly empty.
+		std::vector<std::vector<std::uint64_t>> incompatibilityMasks;
+
+		//! The rendered documentation. Only valid if documentationIsValid is set.
+		mutable std::string documentation;
+		mutable bool documentationIsValid = false;
+
+		//! All keys anything is known about. References the keys of the static schema and the maps above.  
+		//! Only valid if keyIndexIsValid is set.
+		mutable Internal::KeyIndex keyIndex;
+		mutable bool keyIndexIsValid = false;
+
+		//! If set to true, keys may be shortened to any unique prefix
+		bool matchUniquePrefixes = false;
+
+		//! The column to wrap documentation lines at. 0 does not wrap.
+		std::size_t documentationWidth = 0;
+
+		//! Gets passed the statistics of each documentation rendering
+		InstrumentationSink* instrumentationSink = nullptr;
+
+		//! If set to true, this schema can not be changed anymore
+		bool frozen = false;
+
+		friend class ParseResult;
+	};
+}
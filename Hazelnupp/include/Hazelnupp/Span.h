@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+
+namespace Hazelnp
+{
+	/** Non-owning view onto contiguous elements, like std::span (which needs C++20).
+	* Valid as long as whatever it views is.
+	*/
+	template <typename T>
+	class Span
+	{
+	public:
+		//! Constructs an empty span
+		Span() = default;
+
+		//! Constructs a span viewing size elements, beginning at elements
+		Span(T* elements, std::size_t size)
+			:
+			elements { elements },
+			numElements { size }
+		{
+			return;
+		}
+
+		//! Will return a pointer to the first element
+		T* data() const
+		{
+			return elements;
+		}
+
+		//! Will return the amount of elements
+		std::size_t size() const
+		{
+			return numElements;
+		}
+
+		//! Will return whether there are no elements
+		bool empty() const
+		{
+			return numElements == 0;
+		}
+
+		//! Will return the element at index. Not bounds-checked.
+		T& operator[](std::size_t index) const
+		{
+			return elements[index];
+		}
+
+		T* begin() const
+		{
+			return elements;
+		}
+
+		T* end() const
+		{
+			return elements + numElements;
+		}
+
+	private:
+		T* elements = nullptr;
+		std::size_t numElements = 0;
+	};
+}
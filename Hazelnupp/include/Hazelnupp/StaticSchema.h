@@ -0,0 +1,370 @@
+#pragma once
+#include "DataType.h"
+#include "RepeatPolicy.h"
+#include "HazelnuppException.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Hazelnp
+{
+	/** Compile-time description of a single parameter. Meant to be collected in a StaticSchema.
+	* All strings and arrays are referenced, not copied. Use string literals, and arrays with static storage duration.
+	*/
+	struct ParamSpec
+	{
+	public:
+		//! Empty constructor
+		constexpr ParamSpec() = default;
+
+		//! Constructs a spec for the parameter key (like --force)
+		constexpr explicit ParamSpec(std::string_view key)
+			:
+			key { key }
+		{
+			return;
+		}
+
+		//! Daisychain-method. Will add an abbreviation (like -f for --force)
+		constexpr ParamSpec AddAbbreviation(std::string_view abbreviation) const
+		{
+			ParamSpec ps = *this;
+			ps.abbreviation = abbreviation;
+
+			return ps;
+		}
+
+		//! Daisychain-method. Will add a short description
+		constexpr ParamSpec AddDescription(std::string_view description) const
+		{
+			ParamSpec ps = *this;
+			ps.description = description;
+
+			return ps;
+		}
+
+		//! Daisychain-method. Will add a the "type-safety" aspect.
+		constexpr ParamSpec AddTypeSafety(DATA_TYPE requiredType, bool constrainType = true) const
+		{
+			ParamSpec ps = *this;
+			ps.constrainType = constrainType;
+			ps.requiredType = requiredType;
+
+			return ps;
+		}
+
+		//! Daisychain-method. Will add a the "required-argument" aspect, without a default value.
+		constexpr ParamSpec AddRequire(bool required = true) const
+		{
+			ParamSpec ps = *this;
+			ps.required = required;
+
+			return ps;
+		}
+
+		//! Daisychain-method. Will add a the "required-argument" aspect.
+		//! Think of the default value like of a list of parameters. Like {"800"}
+		template <std::size_t N>
+		constexpr ParamSpec AddRequire(const std::string_view (&defaultValue)[N], bool required = true) const
+		{
+			ParamSpec ps = *this;
+			ps.defaultValue = defaultValue;
+			ps.numDefaultValues = N;
+			ps.required = required;
+
+			return ps;
+		}
+
+		//! Daisychain-method. Will add a the "incompatiblity" aspect.
+		//! This means, that the following parameters are NOT compatible with this one and will throw an error if passed together.
+		template <std::size_t N>
+		constexpr ParamSpec AddIncompatibilities(const std::string_view (&incompatibleParameters)[N]) const
+		{
+			ParamSpec ps = *this;
+			ps.incompatibleParameters = incompatibleParameters;
+			ps.numIncompatibleParameters = N;
+
+			return ps;
+		}
+
+		//! Daisychain-method. Will bind the parameter to an environment variable (like APP_FORCE).  
+		//! If the parameter is not supplied, its value gets taken from that variable, before resorting to config files, and the default value.
+		constexpr ParamSpec AddEnvironmentVariable(std::string_view environmentVariable) const
+		{
+			ParamSpec ps = *this;
+			ps.environmentVariable = environmentVariable;
+
+			return ps;
+		}
+
+		//! Daisychain-method. Will add a the "repeat-policy" aspect.  
+		//! This decides what happens if the parameter is supplied more than once. Like appending all values to one list.
+		constexpr ParamSpec AddRepeatPolicy(REPEAT_POLICY repeatPolicy) const
+		{
+			ParamSpec ps = *this;
+			ps.repeatPolicy = repeatPolicy;
+
+			return ps;
+		}
+
+		//! The parameter this spec is for. Like --force
+		std::string_view key;
+
+		//! Its abbreviation, like -f. Empty if none.
+		std::string_view abbreviation;
+
+		//! A short description of the parameter. Empty if none.
+		std::string_view description;
+
+		//! Should this parameter be forced to be of a certain type?
+		bool constrainType = false;
+
+		//! Constrain the parameter to this value. Requires `constrainType` to be set to true.
+		DATA_TYPE requiredType = DATA_TYPE::VOID;
+
+		//! If set to true, and no default value set,
+		//! an error will be produced if this parameter is not supplied by the user.
+		bool required = false;
+
+		//! The default value for this parameter. Gets applied if this parameter was not given.
+		const std::string_view* defaultValue = nullptr;
+		std::size_t numDefaultValues = 0;
+
+		//! Parameters that are incompatible with this parameter
+		const std::string_view* incompatibleParameters = nullptr;
+		std::size_t numIncompatibleParameters = 0;
+
+		//! The environment variable to take the value from, if the parameter is not supplied. Empty if none.
+		std::string_view environmentVariable;
+
+		//! What happens if this parameter is supplied more than once
+		REPEAT_POLICY repeatPolicy = REPEAT_POLICY::KEEP_FIRST;
+	};
+
+	namespace Internal
+	{
+		//! FNV-1a. Usable at compile time and at runtime alike, which is the whole point.
+		constexpr std::uint64_t HashName(std::string_view name)
+		{
+			std::uint64_t hash = 0xcbf29ce484222325ull;
+			for (const char c : name)
+				hash = (hash ^ (std::uint8_t)c) * 0x100000001b3ull;
+
+			return hash;
+		}
+
+		//! Scrambles a hash, after it has been displaced
+		constexpr std::uint64_t MixHash(std::uint64_t hash)
+		{
+			hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+			hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+			return hash ^ (hash >> 31);
+		}
+
+		constexpr std::size_t NextPowerOfTwo(std::size_t n)
+		{
+			std::size_t p = 1;
+			while (p < n)
+				p <<= 1;
+
+			return p;
+		}
+
+		/** Non-template view onto a StaticSchema, so that CmdArgsInterface can use any of them.
+		*/
+		struct StaticSchemaView
+		{
+			//! Returned by Find() if the name is unknown
+			static constexpr std::size_t npos = (std::size_t)-1;
+
+			//! Will return the id of the spec whose key or abbreviation is name. Or npos, if there is none.
+			//! out_isAbbreviation tells which of both it was.
+			//! This is one hash, two table reads and one string comparison.
+			constexpr std::size_t Find(std::string_view name, bool& out_isAbbreviation) const
+			{
+				if (numSpecs == 0)
+					return npos;
+
+				const std::uint64_t hash = HashName(name);
+				const std::uint16_t displacement = displacements[hash & (numBuckets - 1)];
+				const std::uint16_t slot = slots[MixHash(hash + displacement) & (numSlots - 1)];
+
+				// Empty slot
+				if (slot == 0)
+					return npos;
+
+				const std::size_t id = (slot - 1) >> 1;
+				out_isAbbreviation = ((slot - 1) & 1) != 0;
+
+				// The table is perfect for known names, but anything else may land on a slot aswell
+				const std::string_view& candidate = out_isAbbreviation ? specs[id].abbreviation : specs[id].key;
+				if (candidate != name)
+					return npos;
+
+				return id;
+			}
+
+			const ParamSpec* specs = nullptr;
+			std::size_t numSpecs = 0;
+
+			const std::uint16_t* displacements = nullptr;
+			std::size_t numBuckets = 0;
+
+			//! 0 is empty. Else it is (id * 2 + isAbbreviation) + 1
+			const std::uint16_t* slots = nullptr;
+			std::size_t numSlots = 0;
+		};
+	}
+
+	/** A parameter schema known at compile time. Build it constexpr, and hand it to CmdArgsInterface::SetStaticSchema().
+	* Keys and abbreviations are looked up through a perfect hash table that is built by the compiler,
+	* so nothing has to be registered, hashed or allocated at startup.
+	* Duplicate keys or abbreviations fail to compile.
+	*/
+	template <std::size_t N>
+	class StaticSchema
+	{
+		static_assert(N > 0, "A StaticSchema needs at least one parameter");
+		static_assert(N < 0x7fff, "A StaticSchema can not have this many parameters");
+
+	public:
+		//! Returned by Find() if the key is unknown
+		static constexpr std::size_t npos = Internal::StaticSchemaView::npos;
+
+		//! Will build the schema, and its hash table, from an array of specs
+		constexpr StaticSchema(const ParamSpec (&specs)[N])
+		{
+			for (std::size_t i = 0; i < N; i++)
+				this->specs[i] = specs[i];
+
+			// Reject empty keys, and names used twice
+			for (std::size_t i = 0; i < numNames; i++)
+			{
+				if ((i % 2 == 0) && (GetName(i).length() == 0))
+					throw HazelnuppException("StaticSchema: Empty key");
+
+				if (GetName(i).length() == 0)
+					continue;
+
+				for (std::size_t j = i + 1; j < numNames; j++)
+					if (GetName(i) == GetName(j))
+						throw HazelnuppException("StaticSchema: Duplicate key or abbreviation");
+			}
+
+			// Hash and displace: Sort all names into buckets, and find a displacement for each bucket
+			// that moves all of its names into free slots. Biggest buckets go first, whilst there's plenty of room.
+			std::array<std::size_t, numBuckets> bucketSizes {};
+			std::size_t biggestBucket = 0;
+			for (std::size_t i = 0; i < numNames; i++)
+				if (GetName(i).length() > 0)
+				{
+					std::size_t& size = bucketSizes[Internal::HashName(GetName(i)) & (numBuckets - 1)];
+					size++;
+					if (size > biggestBucket)
+						biggestBucket = size;
+				}
+
+			for (std::size_t size = biggestBucket; size > 0; size--)
+				for (std::size_t bucket = 0; bucket < numBuckets; bucket++)
+					if (bucketSizes[bucket] == size)
+						PlaceBucket(bucket, size);
+
+			return;
+		}
+
+		//! Will return the id of the spec for key. Or npos, if there is none. Abbreviations are not considered.
+		constexpr std::size_t Find(std::string_view key) const
+		{
+			bool isAbbreviation = false;
+			const std::size_t id = View().Find(key, isAbbreviation);
+
+			return isAbbreviation ? npos : id;
+		}
+
+		//! Will return the spec with a given id
+		constexpr const ParamSpec& GetSpec(std::size_t id) const
+		{
+			return specs[id];
+		}
+
+		//! Will return the amount of parameters in this schema
+		constexpr std::size_t Size() const
+		{
+			return N;
+		}
+
+		//! Will return a non-template view onto this schema. It references this object.
+		constexpr Internal::StaticSchemaView View() const
+		{
+			Internal::StaticSchemaView view;
+			view.specs = specs.data();
+			view.numSpecs = N;
+			view.displacements = displacements.data();
+			view.numBuckets = numBuckets;
+			view.slots = slots.data();
+			view.numSlots = numSlots;
+
+			return view;
+		}
+
+	private:
+		//! Every spec contributes its key, and its abbreviation. Even names are keys, odd ones abbreviations.
+		static constexpr std::size_t numNames = N * 2;
+		static constexpr std::size_t numBuckets = Internal::NextPowerOfTwo(numNames);
+		static constexpr std::size_t numSlots = numBuckets * 2;
+
+		constexpr std::string_view GetName(std::size_t i) const
+		{
+			return (i % 2 == 0) ? specs[i / 2].key : specs[i / 2].abbreviation;
+		}
+
+		//! Will find a displacement for bucket, that places all of its names into free, distinct slots
+		constexpr void PlaceBucket(std::size_t bucket, std::size_t size)
+		{
+			std::array<std::size_t, numNames> placed {};
+
+			for (std::uint32_t displacement = 0; displacement < 0x10000; displacement++)
+			{
+				std::size_t numPlaced = 0;
+				bool fits = true;
+
+				for (std::size_t i = 0; (i < numNames) && (fits); i++)
+				{
+					if (GetName(i).length() == 0)
+						continue;
+
+					const std::uint64_t hash = Internal::HashName(GetName(i));
+					if ((hash & (numBuckets - 1)) != bucket)
+						continue;
+
+					const std::size_t slot = Internal::MixHash(hash + displacement) & (numSlots - 1);
+					if (slots[slot] != 0)
+						fits = false;
+
+					for (std::size_t j = 0; j < numPlaced; j++)
+						if ((placed[j] & (numSlots - 1)) == slot)
+							fits = false;
+
+					// Remember the slot, and which name goes there
+					placed[numPlaced++] = slot | (i * numSlots);
+				}
+
+				if (fits)
+				{
+					for (std::size_t j = 0; j < size; j++)
+						slots[placed[j] & (numSlots - 1)] = (std::uint16_t)(placed[j] / numSlots + 1);
+
+					displacements[bucket] = (std::uint16_t)displacement;
+					return;
+				}
+			}
+
+			throw HazelnuppException("StaticSchema: Unable to build the key table");
+		}
+
+		std::array<ParamSpec, N> specs {};
+		std::array<std::uint16_t, numBuckets> displacements {};
+		std::array<std::uint16_t, numSlots> slots {};
+	};
+}
@@ -1,5 +1,7 @@
 #pragma once
+#include "DataType.h"
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <vector>
 #include <cmath>
@@ -14,7 +16,7 @@ namespace Hazelnp
 		{
 		public:
 			//! Will return wether or not a given char is in a string
-			static bool Contains(const std::string& str, const char c);
+			static bool Contains(std::string_view str, const char c);
 
 			//! Will replace a part of a string with another string
 			static std::string Replace(const std::string& str, const char find, const std::string& subst);
@@ -23,12 +25,29 @@ namespace Hazelnp
 			static std::string Replace(const std::string& str, const std::string& find, const std::string& subst);
 
 			//! Will return true if the given string consists only of digits (including signage)
-			static bool IsNumeric(const std::string& str, const bool allowDecimalPoint = false);
+			static bool IsNumeric(std::string_view str, const bool allowDecimalPoint = false);
 
 			//! Will convert the number in str to a number.  
 			//! Returns wether or not the operation was successful.  
 			//! Also returns wether the number is an integer, or floating point. If int, cast out_number to int.
-			static bool ParseNumber(const std::string& str, bool& out_isInt, long double& out_number);
+			static bool ParseNumber(std::string_view str, bool& out_isInt, long double& out_number);
+
+			//! Will classify and convert the number in str in a single pass. Never throws, and does not depend on the locale.  
+			//! Returns DATA_TYPE::INT or DATA_TYPE::FLOAT, or DATA_TYPE::STRING if str is not a number.  
+			//! Understands decimal, hexadecimal (0x1F), octal (0o17) and binary (0b101) integers, and exponents (1.5e-3).  
+			//! Integers are converted exactly into out_int. Decimal integers exceeding 64 bits are treated as floats.  
+			//! out_float always receives the value.
+			static DATA_TYPE LexNumber(std::string_view str, long long int& out_int, long double& out_float);
+
+			//! Will convert a batch of tokens to integers in a single pass, into out. Stops at the first token LexNumber() would not call an integer.  
+			//! Returns how many tokens got converted. Each one ends up exactly as LexNumber() would convert it.  
+			//! Decimal integers of up to 16 digits get validated and accumulated all at once, via SSE2 where available.
+			static std::size_t LexIntegers(const std::string_view* tokens, const std::size_t numTokens, long long int* out);
+
+			//! Will convert a batch of tokens to floating points in a single pass, into out. Stops at the first token LexNumber() would not call a float.  
+			//! Returns how many tokens got converted. Each one ends up exactly as LexNumber() would convert it.  
+			//! Plain decimal fractions, like -12.375, take the same path as short integers in LexIntegers().
+			static std::size_t LexFloats(const std::string_view* tokens, const std::size_t numTokens, long double* out);
 
 			//! Will split a string by a delimiter char. The delimiter will be excluded!
 			static std::vector<std::string> SplitString(const std::string& str, const char delimiter);
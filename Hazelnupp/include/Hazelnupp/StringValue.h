@@ -1,45 +1,32 @@
 #pragma once
 #include "Value.h"
 #include <string>
+#include <string_view>
 
 namespace Hazelnp
 {
-	/** Specializations for string values (uses std::string)
+	/** Facade for string values. Short strings are stored inline, long ones on the heap.
+	* Strings may also just be referenced, instead of owned.
 	*/
 	class StringValue : public Value
 	{
 	public:
+		//! Will construct a string value owning a copy of value
 		StringValue(const std::string& value);
-		~StringValue() override {};
 
-		//! Will return a deeopopy of this object
-		Value* Deepcopy() const override;
+		//! Will construct a string value. If copy is false, it will only reference value,
+		//! which then has to outlive this object.
+		StringValue(std::string_view value, bool copy);
 
-		//! Will return a string suitable for an std::ostream;
-		std::string GetAsOsString() const override;
-
-		//! Will return the raw value
+		//! Will return the raw value. The std::string gets built on first call, and is kept as long as this value lives.
 		const std::string& GetValue() const;
 
-		operator std::string() const;
-
-		//! Throws HazelnuppValueNotConvertibleException
-		long long int GetInt64() const override;
-		//! Throws HazelnuppValueNotConvertibleException
-		int GetInt32() const override;
+		//! Will return the raw value, without copying it
+		std::string_view GetValueView() const;
 
-		//! Throws HazelnuppValueNotConvertibleException
-		long double GetFloat64() const override;
-		//! Throws HazelnuppValueNotConvertibleException
-		double GetFloat32() const override;
+		//! Will return whether this value owns its string, or just references it
+		bool IsOwning() const;
 
-		//! Will return this value as a string
-		std::string GetString() const override;
-
-		//! Throws HazelnuppValueNotConvertibleException
-		const std::vector<Value*>& GetList() const override;
-
-	private:
-		std::string value;
+		operator std::string() const;
 	};
 }
@@ -1,25 +1,77 @@
 #pragma once
 #include "DataType.h"
+#include "Span.h"
 #include <ostream>
 #include <vector>
+#include <memory_resource>
+#include <string_view>
+#include <cstdint>
+#include <atomic>
 
 namespace Hazelnp
 {
-	/** Abstract class for values
+	class ParseResult;
+	class Value;
+
+	namespace Internal
+	{
+		struct LazySource;
+
+		/** Internal storage of a list value.
+		* Elements sharing a type get stored contiguously, and only get built as values on first access to them.
+		*/
+		struct ListStorage
+		{
+			//! The type all elements share: INT, FLOAT or STRING. VOID, if they differ, or if they are stored as values only.
+			DATA_TYPE elementType = DATA_TYPE::VOID;
+
+			//! Amount of elements
+			std::size_t size = 0;
+
+			//! The elements, contiguously. Only the one matching elementType is set.
+			union
+			{
+				const long long int* ints = nullptr;
+				const long double* floats;
+				const std::string_view* strings;
+			};
+
+			//! The characters strings references, if this list owns them. nullptr, if they are just referenced.
+			const char* characters = nullptr;
+
+			//! The elements as values. nullptr, until they are first accessed.
+			std::atomic<std::vector<Value*>*> elements { nullptr };
+
+			//! The ParseResult to build the elements in, on first access. nullptr, if they got built right away.
+			ParseResult* owner = nullptr;
+		};
+	}
+
+	/** Compact, tagged value. Stores ints, floats and short strings inline.  
+	* Accessors are not virtual, and get inlined.
+	* IntValue, FloatValue, StringValue, VoidValue and ListValue are just facades over this class,
+	* and add no data on their own.
+	* Values parsed lazily only hold their raw tokens, and convert themselves on first access. Thread-safely.
 	*/
 	class Value
 	{
 	public:
-		virtual ~Value() {};
+		Value(const Value& other);
+		Value& operator=(const Value& other);
+		~Value();
 
 		//! Will return a deeopopy of this object
-		virtual Value* Deepcopy() const = 0;
+		Value* Deepcopy() const;
 
 		//! Will return a string suitable for an std::ostream
-		virtual std::string GetAsOsString() const = 0;
+		std::string GetAsOsString() const;
 
 		//! Will return the data type of this value
-		DATA_TYPE GetDataType() const;
+		DATA_TYPE GetDataType() const
+		{
+			ResolveIfPending();
+			return type;
+		}
 
 		friend std::ostream& operator<< (std::ostream& os, const Value& v)
 		{
@@ -27,24 +79,231 @@ namespace Hazelnp
 		}
 
 		//! Will attempt to return the integer data (long long)
-		virtual long long int GetInt64() const = 0;
+		long long int GetInt64() const
+		{
+			ResolveIfPending();
+
+			if (type == DATA_TYPE::INT)
+				return data.intValue;
+			else if (type == DATA_TYPE::FLOAT)
+				return (long long int)data.floatValue;
+
+			ThrowNotConvertible();
+		}
+
 		//! Will attempt to return the integer data (int)
-		virtual int GetInt32() const = 0;
+		int GetInt32() const
+		{
+			return (int)GetInt64();
+		}
 
 		//! Will attempt to return the floating-point data (long double)
-		virtual long double GetFloat64() const = 0;
+		long double GetFloat64() const
+		{
+			ResolveIfPending();
+
+			if (type == DATA_TYPE::FLOAT)
+				return data.floatValue;
+			else if (type == DATA_TYPE::INT)
+				return (long double)data.intValue;
+
+			ThrowNotConvertible();
+		}
+
 		//! Will attempt to return the floating-point data (double)
-		virtual double GetFloat32() const = 0;
+		double GetFloat32() const
+		{
+			return (double)GetFloat64();
+		}
+
+		//! Will attempt to return the string-data as an owning copy
+		std::string GetString() const;
+
+		//! Will attempt to return a view onto the string-data, without copying it.  
+		//! The view is valid as long as this value is.
+		std::string_view GetStringView() const
+		{
+			ResolveIfPending();
+
+			if (type == DATA_TYPE::STRING)
+				return std::string_view(isInline ? data.inlineString : data.stringData, stringLength);
+			else if (type == DATA_TYPE::VOID)
+				return std::string_view();
 
-		//! Will attempt to return the string-data
-		virtual std::string GetString() const = 0;
+			ThrowNotConvertible();
+		}
+
+		//! Will attempt to return the list-data.  
+		//! Lists whose elements share a type only build these values on first access. Prefer the typed accessors below for them.
+		const std::vector<Value*>& GetList() const
+		{
+			ResolveIfPending();
+
+			if (type == DATA_TYPE::LIST)
+			{
+				const std::vector<Value*>* elements = data.listStorage->elements.load(std::memory_order_acquire);
+				return (elements != nullptr) ? *elements : BuildElements();
+			}
+			else if (type == DATA_TYPE::VOID)
+				return emptyList;
+
+			ThrowNotConvertible();
+		}
+
+		//! Will return the type all list elements share: INT, FLOAT or STRING.  
+		//! VOID, if they differ, if there are none, if this is no list, or if the list was assembled via ListValue::AddValue().
+		DATA_TYPE GetListElementType() const
+		{
+			ResolveIfPending();
 
-		//! Will attempt to return the list-data
-		virtual const std::vector<Value*>& GetList() const = 0;
+			if (type == DATA_TYPE::LIST)
+				return data.listStorage->elementType;
+
+			return DATA_TYPE::VOID;
+		}
+
+		//! Will attempt to return the elements of a list of integers, contiguously. Without a value per element.  
+		//! Only works if GetListElementType() is INT, or the list is empty.
+		Span<const long long int> GetIntList() const
+		{
+			ResolveIfPending();
+
+			if (type == DATA_TYPE::LIST)
+			{
+				if (data.listStorage->elementType == DATA_TYPE::INT)
+					return Span<const long long int>(data.listStorage->ints, data.listStorage->size);
+				else if (data.listStorage->size == 0)
+					return Span<const long long int>();
+			}
+			else if (type == DATA_TYPE::VOID)
+				return Span<const long long int>();
+
+			ThrowNotConvertible();
+		}
+
+		//! Will attempt to return the elements of a list of floating-points, contiguously. Without a value per element.  
+		//! Only works if GetListElementType() is FLOAT, or the list is empty.
+		Span<const long double> GetFloatList() const
+		{
+			ResolveIfPending();
+
+			if (type == DATA_TYPE::LIST)
+			{
+				if (data.listStorage->elementType == DATA_TYPE::FLOAT)
+					return Span<const long double>(data.listStorage->floats, data.listStorage->size);
+				else if (data.listStorage->size == 0)
+					return Span<const long double>();
+			}
+			else if (type == DATA_TYPE::VOID)
+				return Span<const long double>();
+
+			ThrowNotConvertible();
+		}
+
+		//! Will attempt to return the elements of a list of strings, contiguously. Without a value per element.  
+		//! Only works if GetListElementType() is STRING, or the list is empty. The views are valid as long as this value is.
+		Span<const std::string_view> GetStringList() const
+		{
+			ResolveIfPending();
+
+			if (type == DATA_TYPE::LIST)
+			{
+				if (data.listStorage->elementType == DATA_TYPE::STRING)
+					return Span<const std::string_view>(data.listStorage->strings, data.listStorage->size);
+				else if (data.listStorage->size == 0)
+					return Span<const std::string_view>();
+			}
+			else if (type == DATA_TYPE::VOID)
+				return Span<const std::string_view>();
+
+			ThrowNotConvertible();
+		}
 
 	protected:
 		Value(DATA_TYPE type);
 
-		DATA_TYPE type;
+		//! Will set the string-data. If copy is false, str will just be referenced.  
+		//! Else it will be copied inline, if short enough, or onto the heap.
+		void AssignString(std::string_view str, bool copy);
+
+		//! Will free the data owned, if any
+		void Free();
+
+		//! Will return the string-data as an std::string. It gets built on first call, and is kept as long as this value lives.
+		const std::string& GetCachedString() const;
+
+		//! Will free the contiguous elements of an owning list, if any. Its elements then are values only.
+		void DropTypedElements();
+
+		//! Throws HazelnuppValueNotConvertibleException
+		[[noreturn]] static void ThrowNotConvertible();
+
+		//! Will convert this value, if it got parsed lazily, and is not converted yet
+		void ResolveIfPending() const
+		{
+			if (state.load(std::memory_order_acquire) != RESOLVED)
+				Resolve();
+
+			return;
+		}
+
+		//! The maximum length of strings stored inline
+		static constexpr std::size_t inlineStringCapacity = 16;
+
+		//! 8 bits hold each type, and leave room for stringCache, without growing values
+		DATA_TYPE type : 8;
+
+		//! Whether the string-data lives in data.inlineString
+		bool isInline = false;
+
+		//! Whether the long string, or the list and its elements, are owned by this value (and have to be freed)
+		bool isOwning = false;
+
+		//! Whether this value is converted already. Anything but RESOLVED means data holds a lazy source or token.
+		enum State : std::uint8_t
+		{
+			RESOLVED,
+			PENDING_SOURCE,
+			RESOLVING
+		};
+		mutable std::atomic<std::uint8_t> state { RESOLVED };
+
+		//! Length of the string-data, if any
+		std::uint32_t stringLength = 0;
+
+		//! The string-data as an std::string, once StringValue::GetValue() got called. 0 until then.  
+		//! Values living in the arena of a ParseResult hold a pointer to it, tagged with parseResultTag, until then. Their std::string belongs to it.  
+		//! All others own their std::string.
+		mutable std::atomic<std::uintptr_t> stringCache { 0 };
+		static constexpr std::uintptr_t parseResultTag = 1;
+
+		union
+		{
+			long long int intValue;
+			long double floatValue;
+			char inlineString[inlineStringCapacity];
+			const char* stringData;
+			Internal::ListStorage* listStorage;
+			const Internal::LazySource* lazySource;
+		} data;
+
+		//! Returned by void values
+		static const std::vector<Value*> emptyList;
+
+	private:
+		//! Will construct a value converting all tokens of source on first access
+		explicit Value(const Internal::LazySource* source);
+
+		//! Will convert this value. If another thread is converting it already, waits for it.  
+		//! If the conversion throws, this value stays pending, and the next access throws again.
+		void Resolve() const;
+
+		//! Will build the elements of a list as values, in the arena of its ParseResult. If another thread is building them already, waits for it.
+		const std::vector<Value*>& BuildElements() const;
+
+		//! Will take over the contents of a converted value
+		void Adopt(const Value& converted);
+
+		friend class ParseResult;
 	};
 }
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Hazelnp
+{
+	namespace Internal
+	{
+		/** Internal pool of worker threads, running a batch of independent tasks.
+		* Every worker starts with an equal, contiguous share of the tasks. Once a worker runs out,
+		* it steals half of the remaining tasks of another one, so that uneven tasks still keep all workers busy.
+		*/
+		class WorkStealingPool
+		{
+		public:
+			//! Will construct a pool of numThreads workers. The thread calling Run() is one of them,  
+			//! so numThreads - 1 threads get spawned. 0 means one worker per hardware thread.
+			explicit WorkStealingPool(std::size_t numThreads = 0);
+			~WorkStealingPool();
+
+			WorkStealingPool(const WorkStealingPool&) = delete;
+			WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+			//! Will call task(i) for every i in [0, numTasks), spread across all workers, and return once all are done.  
+			//! task must not throw. Calls of Run() from several threads are serialized.
+			void Run(std::size_t numTasks, const std::function<void(std::size_t)>& task);
+
+			//! Will return the amount of workers, including the thread calling Run()
+			std::size_t GetNumThreads() const;
+
+		private:
+			//! What each spawned thread does, until the pool gets destructed
+			void WorkerLoop(std::size_t worker);
+
+			//! Will run tasks of worker, and then steal from others, until there is nothing left
+			void Work(std::size_t worker);
+
+			//! Will take the first task of worker. Returns false if it has none.
+			bool Pop(std::size_t worker, std::size_t& out_task);
+
+			//! Will move half of the tasks of another worker over to worker. Returns false if there was nothing to steal.
+			bool Steal(std::size_t worker);
+
+			//! Range of tasks left for a worker, packed as (begin << 32 | end), so that both change atomically.  
+			//! The owner takes from the begin, thieves take from the end.
+			struct alignas(64) TaskRange
+			{
+				std::atomic<std::uint64_t> bounds { 0 };
+			};
+
+			std::size_t numWorkers;
+			std::unique_ptr<TaskRange[]> ranges;
+			std::vector<std::thread> threads;
+
+			//! The task of the current Run()
+			const std::function<void(std::size_t)>* task = nullptr;
+
+			std::mutex mutex;
+			std::condition_variable wake;
+			std::condition_variable done;
+
+			//! Incremented for every Run(), so that workers can tell a new one from a spurious wakeup
+			std::size_t generation = 0;
+
+			//! Amount of spawned workers not done with the current Run()
+			std::size_t numBusy = 0;
+
+			bool stopping = false;
+
+			//! Serializes calls of Run()
+			std::mutex runMutex;
+		};
+	}
+}
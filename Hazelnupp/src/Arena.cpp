@@ -0,0 +1,152 @@
+#include "Hazelnupp/Arena.h"
+#include "Hazelnupp/Instrumentation.h"
+#include <cstdint>
+
+using namespace Hazelnp;
+
+Internal::Arena::Arena(std::pmr::memory_resource* upstream)
+	:
+	upstream { upstream }
+{
+	return;
+}
+
+Internal::Arena::~Arena()
+{
+	Release();
+
+	return;
+}
+
+void Internal::Arena::Release()
+{
+	while (chunks != nullptr)
+	{
+		Chunk* next = chunks->next;
+		upstream->deallocate(chunks, chunks->size, alignof(std::max_align_t));
+		chunks = next;
+	}
+
+	current = nullptr;
+	cursor = nullptr;
+	end = nullptr;
+	nextChunkSize = initialChunkSize;
+
+	return;
+}
+
+void Internal::Arena::Reset()
+{
+	if (chunks != nullptr)
+		Enter(chunks);
+
+	return;
+}
+
+std::size_t Internal::Arena::GetCapacity() const
+{
+	std::size_t capacity = 0;
+	for (const Chunk* chunk = chunks; chunk != nullptr; chunk = chunk->next)
+		capacity += chunk->size;
+
+	return capacity;
+}
+
+std::pmr::memory_resource* Internal::Arena::GetUpstream() const
+{
+	return upstream;
+}
+
+std::size_t Internal::Arena::GetNumAllocations() const
+{
+	return numAllocations;
+}
+
+std::size_t Internal::Arena::GetNumUpstreamAllocations() const
+{
+	return numUpstreamAllocations;
+}
+
+void* Internal::Arena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+	if constexpr (g_instrumentationEnabled)
+		numAllocations++;
+
+	// Align the cursor
+	std::uintptr_t address = ((std::uintptr_t)cursor + (alignment - 1)) & ~(std::uintptr_t)(alignment - 1);
+
+	// Does it not fit into the current chunk anymore?
+	if ((cursor == nullptr) || (address + bytes > (std::uintptr_t)end))
+	{
+		Grow(bytes + alignment);
+		address = ((std::uintptr_t)cursor + (alignment - 1)) & ~(std::uintptr_t)(alignment - 1);
+	}
+
+	cursor = (char*)(address + bytes);
+
+	return (void*)address;
+}
+
+void Internal::Arena::do_deallocate(void*, std::size_t, std::size_t)
+{
+	// Monotonic. Memory only gets freed all at once.
+	return;
+}
+
+bool Internal::Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	return this == &other;
+}
+
+void Internal::Arena::Grow(std::size_t minBytes)
+{
+	// Are there chunks kept from before a Reset()? Take the next one big enough.
+	// Chunks too small for this request are skipped until the next Reset().
+	if (current != nullptr)
+		for (Chunk* chunk = current->next; chunk != nullptr; chunk = chunk->next)
+			if (chunk->size >= minBytes + sizeof(Chunk))
+			{
+				Enter(chunk);
+				return;
+			}
+
+	std::size_t size = nextChunkSize;
+	while (size < minBytes + sizeof(Chunk))
+		size *= 2;
+
+	// Append it to the very end, so that kept chunks stay in order
+	Chunk* chunk = (Chunk*)upstream->allocate(size, alignof(std::max_align_t));
+
+	if constexpr (g_instrumentationEnabled)
+		numUpstreamAllocations++;
+
+	chunk->next = nullptr;
+	chunk->size = size;
+
+	if (chunks == nullptr)
+		chunks = chunk;
+	else
+	{
+		Chunk* last = (current != nullptr) ? current : chunks;
+		while (last->next != nullptr)
+			last = last->next;
+
+		last->next = chunk;
+	}
+
+	Enter(chunk);
+
+	// Grow geometrically, so that the amount of chunks stays logarithmic
+	nextChunkSize = size * 2;
+
+	return;
+}
+
+void Internal::Arena::Enter(Chunk* chunk)
+{
+	current = chunk;
+	cursor = (char*)(chunk + 1);
+	end = (char*)chunk + chunk->size;
+
+	return;
+}
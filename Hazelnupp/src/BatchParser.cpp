@@ -0,0 +1,69 @@
+#include "Hazelnupp/BatchParser.h"
+#include "Hazelnupp/HazelnuppException.h"
+
+using namespace Hazelnp;
+
+BatchParser::BatchParser(const Schema& schema, std::size_t numThreads)
+	:
+	schema { &schema },
+	pool(numThreads)
+{
+	return;
+}
+
+std::vector<BatchItem> BatchParser::Parse(const ArgVector* items, std::size_t numItems)
+{
+	// Workers read the schema without locking. This is only safe, if nobody can change it.
+	if (!schema->IsFrozen())
+		throw HazelnuppException("The schema has to be frozen before parsing batches against it!");
+
+	std::vector<BatchItem> outcomes(numItems);
+
+	// Each task writes only its own outcome, so that no synchronization is needed beyond the pool's
+	pool.Run(numItems, [&](std::size_t i)
+		{
+			BatchItem& outcome = outcomes[i];
+
+			try
+			{
+				outcome.result = std::make_unique<ParseResult>(*schema);
+				outcome.result->SetBorrowArgv(borrowArgv);
+				outcome.result->Parse(items[i].argc, items[i].argv);
+			}
+			catch (...)
+			{
+				outcome.result.reset();
+				outcome.error = std::current_exception();
+			}
+
+			return;
+		});
+
+	return outcomes;
+}
+
+std::vector<BatchItem> BatchParser::Parse(const std::vector<ArgVector>& items)
+{
+	return Parse(items.data(), items.size());
+}
+
+std::size_t BatchParser::GetNumThreads() const
+{
+	return pool.GetNumThreads();
+}
+
+void BatchParser::SetBorrowArgv(bool borrowArgv)
+{
+	this->borrowArgv = borrowArgv;
+	return;
+}
+
+bool BatchParser::GetBorrowArgv() const
+{
+	return borrowArgv;
+}
+
+const Schema& BatchParser::GetSchema() const
+{
+	return *schema;
+}
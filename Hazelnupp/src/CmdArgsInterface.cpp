@@ -1,35 +1,34 @@
 #include "Hazelnupp/CmdArgsInterface.h"
-#include "Hazelnupp/VoidValue.h"
-#include "Hazelnupp/IntValue.h"
-#include "Hazelnupp/FloatValue.h"
-#include "Hazelnupp/StringValue.h"
-#include "Hazelnupp/ListValue.h"
 #include "Hazelnupp/HazelnuppException.h"
-#include "Hazelnupp/Placeholders.h"
-#include "Hazelnupp/StringTools.h"
 #include <iostream>
 #include <cstdlib>
 
 using namespace Hazelnp;
 
 CmdArgsInterface::CmdArgsInterface()
+	:
+	result { schema }
 {
 	return;
 }
 
 CmdArgsInterface::CmdArgsInterface(const int argc, const char* const* argv)
+	:
+	result { schema }
 {
 	Parse(argc, argv);
 	return;
 }
 
-CmdArgsInterface::~CmdArgsInterface()
+CmdArgsInterface::CmdArgsInterface(std::pmr::memory_resource* upstream)
+	:
+	result { schema, upstream }
 {
-	for (auto& it : parameters)
-		delete it.second;
-
-	parameters.clear();
+	return;
+}
 
+CmdArgsInterface::~CmdArgsInterface()
+{
 	return;
 }
 
@@ -37,34 +36,16 @@ void CmdArgsInterface::Parse(const int argc, const char* const* argv)
 {
 	try
 	{
-		// Populate raw arguments
-		PopulateRawArgs(argc, argv);
-
-		// Expand abbreviations
-		ExpandAbbreviations();
-
-		executableName = std::string(rawArgs[0]);
-
-		// Read and parse all parameters
-		std::size_t i = 1;
-		while (i < rawArgs.size())
+		try
 		{
-			if ((rawArgs[i].length() > 2) && (rawArgs[i].substr(0, 2) == "--"))
-			{
-				Parameter* param = nullptr;
-				i = ParseNextParameter(i, param);
-
-				parameters.insert(std::pair<std::string, Parameter*>(param->Key(), param));
-			}
-			else
-				i++;
+			result.Parse(argc, argv);
+		}
+		catch (const HazelnuppException&)
+		{
+			// Asking for help beats any parameter error
+			CatchHelp(argc, argv);
+			throw;
 		}
-
-		// Apply constraints such as default values, and required parameters.
-		// Types have already been enforced.
-		// Dont apply constraints when we are just printind the param docs
-		if ((!catchHelp) || (!HasParam("--help")))
-			ApplyConstraints();
 	}
 	catch (const HazelnuppConstraintIncompatibleParameters& exc)
 	{
@@ -99,6 +80,28 @@ void CmdArgsInterface::Parse(const int argc, const char* const* argv)
 		else
 			throw exc; // yeet
 	}
+	catch (const HazelnuppConstraintRepeatedParameter& exc)
+	{
+		if (crashOnFail)
+		{
+			std::cout << GenerateDocumentation() << std::endl << std::endl;
+			std::cerr << "Parameter error: " << exc.What() << std::endl;
+			exit(-1005);
+		}
+		else
+			throw exc; // yeet
+	}
+	catch (const HazelnuppAmbiguousKeyException& exc)
+	{
+		if (crashOnFail)
+		{
+			std::cout << GenerateDocumentation() << std::endl << std::endl;
+			std::cerr << "Parameter error: " << exc.What() << std::endl;
+			exit(-1006);
+		}
+		else
+			throw exc; // yeet
+	}
 	catch (const HazelnuppConstraintException& exc)
 	{
 		if (crashOnFail)
@@ -123,568 +126,358 @@ void CmdArgsInterface::Parse(const int argc, const char* const* argv)
 	}
 
 	// Catch --help parameter
-	if ((catchHelp) && (HasParam("--help")))
-	{
-		std::cout << GenerateDocumentation() << std::endl;
-		exit(0);
-	}
+	CatchHelp(argc, argv);
 
 	return;
 }
 
-std::size_t CmdArgsInterface::ParseNextParameter(const std::size_t parIndex, Parameter*& out_Par)
+void CmdArgsInterface::CatchHelp(const int argc, const char* const* argv) const
 {
-	std::size_t i = parIndex;
-	const std::string key = rawArgs[parIndex];
-	std::vector<std::string> values;
+	if ((!catchHelp) || (!result.HasParam("--help")))
+		return;
 
-	// Get values
-	for (i++; i < rawArgs.size(); i++)
-		// If not another parameter
-		if ((rawArgs[i].length() < 2) || (rawArgs[i].substr(0, 2) != "--"))
-			values.emplace_back(rawArgs[i]);
-		else
+	// Asked for help on a single parameter? Like --help --width
+	for (int i = 1; i + 1 < argc; i++)
+		if ((std::string_view(argv[i]) == "--help") || (schema.GetAbbreviation(argv[i]) == "--help"))
 		{
+			const std::string parameterDocumentation = schema.GenerateParameterDocumentation(argv[i + 1]);
+			if (parameterDocumentation.length() > 0)
+			{
+				std::cout << parameterDocumentation << std::endl;
+				exit(0);
+			}
+
 			break;
 		}
 
-	// Fetch constraint info
-	const ParamConstraint* pcn = GetConstraintForKey(key);
-
-	Value* parsedVal = ParseValue(values, pcn);
-	if (parsedVal != nullptr)
-	{
-		out_Par = new Parameter(key, parsedVal);
+	// Print the cached documentation, through std::cout like the documentation of single parameters
+	std::cout << schema.GenerateDocumentation() << std::endl;
+	exit(0);
 
-		delete parsedVal;
-		parsedVal = nullptr;
-	}
-	else
-		throw std::runtime_error("Unable to parse parameter!");
-
-	return i;
+	return;
 }
 
-void CmdArgsInterface::PopulateRawArgs(const int argc, const char* const* argv)
+void CmdArgsInterface::Reset()
 {
-	rawArgs.clear();
-	rawArgs.reserve(argc);
-	
-	for (int i = 0; i < argc; i++)
-		rawArgs.emplace_back(std::string(argv[i]));
-
+	result.Reset();
 	return;
 }
 
-void CmdArgsInterface::ExpandAbbreviations()
+const std::string& CmdArgsInterface::GetExecutableName() const
 {
-	// Abort if no abbreviations
-	if (parameterAbreviations.size() == 0)
-		return;
-
-	for (std::string& arg : rawArgs)
-	{
-		// Is arg registered as an abbreviation?
-		auto abbr = parameterAbreviations.find(arg);
-		if (abbr != parameterAbreviations.end())
-		{
-			// Yes: replace arg with the long form
-			arg = abbr->second;
-		}
-	}
+	return result.GetExecutableName();
+}
 
-	return;
+const Value& CmdArgsInterface::operator[](const std::string& key) const
+{
+	return result[key];
 }
 
 bool CmdArgsInterface::HasParam(const std::string& key) const
 {
-	return parameters.find(key) != parameters.end();
+	return result.HasParam(key);
 }
 
-Value* CmdArgsInterface::ParseValue(const std::vector<std::string>& values, const ParamConstraint* constraint)
+PARAM_SOURCE CmdArgsInterface::GetSource(const std::string& key) const
 {
-	// This is the raw (unconverted) data type the user provided
-	DATA_TYPE rawInputType;
-
-	// Constraint values
-	const bool constrainType = (constraint != nullptr) && (constraint->constrainType);
-
-	// Void-type
-	if (values.size() == 0)
-	{
-		rawInputType = DATA_TYPE::VOID;
-
-		// Is a list forced via a constraint? If yes, return an empty list
-		if ((constrainType) &&
-			(constraint->requiredType == DATA_TYPE::LIST))
-			return new ListValue();
-
-		// Is a string forced via a constraint? If yes, return an empty string
-		else if ((constrainType) &&
-			(constraint->requiredType == DATA_TYPE::STRING))
-			return new StringValue("");
-
-		// Is an int or float forced via constraint? If yes, throw an exception
-		else if ((constrainType) &&
-			((constraint->requiredType == DATA_TYPE::INT) ||
-			 (constraint->requiredType == DATA_TYPE::FLOAT)))
-			throw HazelnuppConstraintTypeMissmatch(
-				constraint->key,
-				constraint->requiredType,
-				rawInputType,
-				GetDescription(constraint->key)
-			);
-
-		// Else, just return the void type
-		return new VoidValue;
-	}
-
-	// Force void type by constraint
-	else if ((constrainType) &&
-		(constraint->requiredType == DATA_TYPE::VOID))
-	{
-		return new VoidValue;
-	}
-
-	// List-type
-	else if (values.size() > 1)
-	{
-		rawInputType = DATA_TYPE::LIST;
-
-		// Should the type be something other than list?
-		if ((constrainType) &&
-			(constraint->requiredType != DATA_TYPE::LIST))
-		{
-			throw HazelnuppConstraintTypeMissmatch(
-				constraint->key, 
-				constraint->requiredType,
-				rawInputType,
-				GetDescription(constraint->key)
-			);
-		}
-
-		ListValue* newList = new ListValue();
-		for (const std::string& val : values)
-		{
-			Value* tmp = ParseValue({ val });
-			newList->AddValue(tmp);
-			delete tmp;
-		}
-		return newList;
-	}
-
-	// Now we're only dealing with a single value
-	const std::string& val = values[0];
-	
-	// String
-	if (!Internal::StringTools::IsNumeric(val, true))
-	{
-		rawInputType = DATA_TYPE::STRING;
-
-		// Is the type not supposed to be a string?
-		// void and list are already sorted out
-		if ((constrainType) &&
-			(constraint->requiredType != DATA_TYPE::STRING))
-		{
-			// We can only force a list-value from here
-			if (constraint->requiredType == DATA_TYPE::LIST)
-			{
-				ListValue* list = new ListValue();
-				Value* tmp = ParseValue({ val });
-				list->AddValue(tmp);
-				delete tmp;
-				tmp = nullptr;
-				return list;
-			}
-			// Else it is not possible to convert to a numeric
-			else
-				throw HazelnuppConstraintTypeMissmatch(
-					constraint->key,
-					constraint->requiredType,
-					rawInputType,
-					GetDescription(constraint->key)
-				);
-		}
-
-		return new StringValue(val);
-	}
-
-	// In this case we have a numeric value.
-	// We should still produce a string if requested
-	if ((constrainType) &&
-		(constraint->requiredType == DATA_TYPE::STRING))
-		return new StringValue(val);
-
-	// Numeric
-	bool isInt;
-	long double num;
-	
-	if (Internal::StringTools::ParseNumber(val, isInt, num))
-	{
-		rawInputType = isInt ? DATA_TYPE::INT : DATA_TYPE::FLOAT;
+	return result.GetSource(key);
+}
 
-		// Is the type constrained?
-		// (only int and float left)
-		if (constrainType)
-		{
-			// Must it be an integer?
-			if (constraint->requiredType == DATA_TYPE::INT)
-				return new IntValue((long long int)num);
-			// Must it be a floating point?
-			else if (constraint->requiredType == DATA_TYPE::FLOAT)
-				return new FloatValue(num);
-			// Else it must be a List
-			else
-			{
-				ListValue* list = new ListValue();
-				Value* tmp = ParseValue({ val });
-				list->AddValue(tmp);
-				delete tmp;
-				tmp = nullptr;
-				return list;
-			}
-		}
-		// Type is not constrained
-		else
-		{
-			// Integer
-			if (isInt)
-				return new IntValue((long long int)num);
+std::string_view CmdArgsInterface::GetOrigin(const std::string& key) const
+{
+	return result.GetOrigin(key);
+}
 
-			// Double
-			return new FloatValue(num);
-		}
-	}
+void CmdArgsInterface::RegisterAbbreviation(const std::string& abbrev, const std::string& target)
+{
+	schema.RegisterAbbreviation(abbrev, target);
+	return;
+}
 
-	// Failed
-	return nullptr;
+const std::string& CmdArgsInterface::GetAbbreviation(const std::string& abbrev) const
+{
+	return schema.GetAbbreviation(abbrev);
 }
 
-bool CmdArgsInterface::GetCrashOnFail() const
+bool CmdArgsInterface::HasAbbreviation(const std::string& abbrev) const
 {
-	return crashOnFail;
+	return schema.HasAbbreviation(abbrev);
 }
 
-void CmdArgsInterface::SetCatchHelp(bool catchHelp)
+void CmdArgsInterface::ClearAbbreviation(const std::string& abbrevation)
 {
-	this->catchHelp = catchHelp;
+	schema.ClearAbbreviation(abbrevation);
 	return;
 }
 
-bool CmdArgsInterface::GetCatchHelp() const
+void CmdArgsInterface::ClearAbbreviations()
 {
-	return catchHelp;
+	schema.ClearAbbreviations();
+	return;
 }
 
-void CmdArgsInterface::SetBriefDescription(const std::string& description)
+void CmdArgsInterface::SetMatchUniquePrefixes(bool matchUniquePrefixes)
 {
-	briefDescription = description;
+	schema.SetMatchUniquePrefixes(matchUniquePrefixes);
 	return;
 }
 
-const std::string& CmdArgsInterface::GetBriefDescription()
+bool CmdArgsInterface::GetMatchUniquePrefixes() const
 {
-	return briefDescription;
+	return schema.GetMatchUniquePrefixes();
 }
 
-void Hazelnp::CmdArgsInterface::RegisterDescription(const std::string& parameter, const std::string& description)
+void CmdArgsInterface::RegisterEnvironmentVariable(const std::string& key, const std::string& variable)
 {
-	parameterDescriptions[parameter] = description;
+	schema.RegisterEnvironmentVariable(key, variable);
 	return;
 }
 
-const std::string& Hazelnp::CmdArgsInterface::GetDescription(const std::string& parameter) const
+const std::string& CmdArgsInterface::GetEnvironmentVariable(const std::string& key) const
 {
-	// Do we already have a description for this parameter?
-	if (!HasDescription(parameter))
-		// No? Then return ""
-		return Placeholders::g_emptyString;
-
-	// We do? Then return it
-	return parameterDescriptions.find(parameter)->second;
+	return schema.GetEnvironmentVariable(key);
 }
 
-bool CmdArgsInterface::HasDescription(const std::string& parameter) const
+bool CmdArgsInterface::HasEnvironmentVariable(const std::string& key) const
 {
-	return parameterDescriptions.find(parameter) != parameterDescriptions.end();
+	return schema.HasEnvironmentVariable(key);
 }
 
-void CmdArgsInterface::ClearDescription(const std::string& parameter)
+void CmdArgsInterface::ClearEnvironmentVariable(const std::string& key)
 {
-	// This will just do nothing if the entry does not exist
-	parameterDescriptions.erase(parameter);
+	schema.ClearEnvironmentVariable(key);
 	return;
 }
 
-void Hazelnp::CmdArgsInterface::ClearDescriptions()
+void CmdArgsInterface::ClearEnvironmentVariables()
 {
-	parameterDescriptions.clear();
+	schema.ClearEnvironmentVariables();
 	return;
 }
 
-std::string CmdArgsInterface::GenerateDocumentation() const
+void CmdArgsInterface::SetEnvironment(const char* const* environment)
 {
-	std::stringstream ss;
-
-	// Add brief, if available
-	if (briefDescription.length() > 0)
-		ss << briefDescription << std::endl;
-
-	// Collect parameter information
-	struct ParamDocEntry
-	{
-		std::string abbreviation;
-		std::string description;
-		std::string type;
-		bool required = false;
-		bool typeIsForced = false;
-		std::string defaultVal;
-		std::string incompatibilities;
-	};
-	std::unordered_map<std::string, ParamDocEntry> paramInfos;
-
-	// Collect descriptions
-	for (const auto& it : parameterDescriptions)
-	{
-		// Do we already have that param in the paramInfo set?
-		if (paramInfos.find(it.first) == paramInfos.end())
-			// No? Create it.
-			paramInfos[it.first] = ParamDocEntry();
-
-		paramInfos[it.first].description = it.second;
-	}
+	result.SetEnvironment(environment);
+	return;
+}
 
-	// Collect abbreviations
-	// first value is abbreviation, second is long form
-	for (const auto& it : parameterAbreviations)
-	{
-		// Do we already have that param in the paramInfo set?
-		if (paramInfos.find(it.second) == paramInfos.end())
-			// No? Create it.
-			paramInfos[it.second] = ParamDocEntry();
+const char* const* CmdArgsInterface::GetEnvironment() const
+{
+	return result.GetEnvironment();
+}
 
-		paramInfos[it.second].abbreviation = it.first;
-	}
+void CmdArgsInterface::LoadConfigFile(const std::string& path)
+{
+	result.LoadConfigFile(path);
+	return;
+}
 
-	// Collect constraints
-	for (const auto& it : parameterConstraints)
-	{
-		// Do we already have that param in the paramInfo set?
-		if (paramInfos.find(it.first) == paramInfos.end())
-			// No? Create it.
-			paramInfos[it.first] = ParamDocEntry();
-
-		ParamDocEntry& cached = paramInfos[it.first];
-		cached.required = it.second.required;
-		cached.typeIsForced = it.second.constrainType;
-		cached.type = DataTypeToString(it.second.requiredType);
-		
-		// Build default-value string
-		std::stringstream vec2str_ss;
-		for (const std::string& s : it.second.defaultValue)
-		{
-			vec2str_ss << '\'' << s << '\'';
+void CmdArgsInterface::ClearConfigFiles()
+{
+	result.ClearConfigFiles();
+	return;
+}
 
-			// Add a space if we are not at the last entry
-			if ((void*)&s != (void*)&it.second.defaultValue.back())
-				vec2str_ss << " ";
-		}
-		cached.defaultVal = vec2str_ss.str();
+void CmdArgsInterface::RegisterConstraint(const std::string& key, const ParamConstraint& constraint)
+{
+	schema.RegisterConstraint(key, constraint);
+	return;
+}
 
+ParamConstraint CmdArgsInterface::GetConstraint(const std::string& parameter) const
+{
+	return schema.GetConstraint(parameter);
+}
 
-		// Build incompatibilities string
-		vec2str_ss.str("");
-		for (const std::string& s : it.second.incompatibleParameters)
-		{
-			vec2str_ss << s;
+void CmdArgsInterface::ClearConstraint(const std::string& parameter)
+{
+	schema.ClearConstraint(parameter);
+	return;
+}
 
-			// Add a comma-space if we are not at the last entry
-			if ((void*)&s != (void*)&it.second.incompatibleParameters.back())
-				vec2str_ss << ", ";
-		}
-		cached.incompatibilities = vec2str_ss.str();
-	}
+void CmdArgsInterface::ClearConstraints()
+{
+	schema.ClearConstraints();
+	return;
+}
 
-	// Now generate the documentation body
-	if (paramInfos.size() > 0)
-	{
-		ss << std::endl 
-			<< "==== AVAILABLE PARAMETERS ====" 
-			<< std::endl << std::endl;
+void CmdArgsInterface::ClearStaticSchema()
+{
+	schema.ClearStaticSchema();
+	result.Reset();
+	return;
+}
 
-		std::size_t counter = 0;
-		for (const auto& it : paramInfos)
-		{
-			const ParamDocEntry& pde = it.second;
+bool CmdArgsInterface::HasStaticSchema() const
+{
+	return schema.HasStaticSchema();
+}
 
-			// Put name
-			ss << it.first << "   ";
+void CmdArgsInterface::SetCrashOnFail(bool crashOnFail)
+{
+	this->crashOnFail = crashOnFail;
+	return;
+}
 
-			// Put abbreviation
-			if (pde.abbreviation.length() > 0)
-				ss << pde.abbreviation << "   ";
+bool CmdArgsInterface::GetCrashOnFail() const
+{
+	return crashOnFail;
+}
 
-			// Put type
-			if (pde.typeIsForced)
-				ss << pde.type << "   ";
+void CmdArgsInterface::SetBorrowArgv(bool borrowArgv)
+{
+	result.SetBorrowArgv(borrowArgv);
+	return;
+}
 
-			// Put default value
-			if (pde.defaultVal.length() > 0)
-				ss << "default=[" << pde.defaultVal << "]   ";
+bool CmdArgsInterface::GetBorrowArgv() const
+{
+	return result.GetBorrowArgv();
+}
 
-			// Put incompatibilities
-			if (pde.incompatibilities.length() > 0)
-				ss << "incompatibilities=[" << pde.incompatibilities << "]   ";
+void CmdArgsInterface::SetExpandResponseFiles(bool expandResponseFiles)
+{
+	result.SetExpandResponseFiles(expandResponseFiles);
+	return;
+}
 
-			// Put required tag, but only if no default value
-			if ((pde.required) && (pde.defaultVal.length() == 0))
-				ss << "[[REQUIRED]]    ";
+bool CmdArgsInterface::GetExpandResponseFiles() const
+{
+	return result.GetExpandResponseFiles();
+}
 
-			// Put brief description
-			if (pde.description.length() > 0)
-				ss << pde.description;
+void CmdArgsInterface::SetMaxResponseFileDepth(std::size_t maxResponseFileDepth)
+{
+	result.SetMaxResponseFileDepth(maxResponseFileDepth);
+	return;
+}
 
-			// Omit linebreaks when we're on the last element
-			if (counter < paramInfos.size()-1)
-				ss << std::endl << std::endl;
+std::size_t CmdArgsInterface::GetMaxResponseFileDepth() const
+{
+	return result.GetMaxResponseFileDepth();
+}
 
-			counter++;
-		}
-	}
+void CmdArgsInterface::SetLazyConversion(bool lazyConversion)
+{
+	result.SetLazyConversion(lazyConversion);
+	return;
+}
 
-	return ss.str();
+bool CmdArgsInterface::GetLazyConversion() const
+{
+	return result.GetLazyConversion();
 }
 
-void CmdArgsInterface::ApplyConstraints()
+void CmdArgsInterface::Validate() const
 {
-	// Enforce required parameters / default values
-	for (const auto& pc : parameterConstraints)
-		// Parameter in question is not supplied
-		if (!HasParam(pc.second.key))
-		{
-			// Do we have a default value?
-			if (pc.second.defaultValue.size() > 0)
-			{
-				// Then create it now, by its default value
-				Value* tmp = ParseValue(pc.second.defaultValue, &pc.second);
-				parameters.insert(std::pair<std::string, Parameter*>(
-					pc.second.key,
-					new Parameter(pc.second.key, tmp)
-				));
-
-				delete tmp;
-				tmp = nullptr;
-			}
-			// So we do not have a default value...
-			else
-			{
-				// Is it important to have the missing parameter?
-				if (pc.second.required)
-					// Throw an error message then
-					throw HazelnuppConstraintMissingValue(
-						pc.second.key,
-						GetDescription(pc.second.key)
-				);
-			}
-		}
-		// The parameter in question IS supplied
-		else
-		{
-			// Enforce parameter incompatibility
-
-			// Is ANY parameter present listed as incompatible with our current one?
-			for (const std::string& incompatibility : pc.second.incompatibleParameters)
-				for (const auto& otherParam : parameters)
-				{
-					if (otherParam.first == incompatibility)
-						throw HazelnuppConstraintIncompatibleParameters(pc.second.key, incompatibility);
-				}
-		}
+	result.Validate();
+	return;
+}
 
+void CmdArgsInterface::SetInstrumentationSink(InstrumentationSink* sink)
+{
+	schema.SetInstrumentationSink(sink);
+	result.SetInstrumentationSink(sink);
 	return;
 }
 
-ParamConstraint CmdArgsInterface::GetConstraint(const std::string& parameter) const
+InstrumentationSink* CmdArgsInterface::GetInstrumentationSink() const
 {
-	return parameterConstraints.find(parameter)->second;
+	return result.GetInstrumentationSink();
 }
 
-void CmdArgsInterface::ClearConstraint(const std::string& parameter)
+const ParseStats& CmdArgsInterface::GetParseStats() const
 {
-	parameterConstraints.erase(parameter);
+	return result.GetParseStats();
+}
+
+void CmdArgsInterface::SetCatchHelp(bool catchHelp)
+{
+	this->catchHelp = catchHelp;
 	return;
 }
 
-const std::string& CmdArgsInterface::GetExecutableName() const
+bool CmdArgsInterface::GetCatchHelp() const
 {
-	return executableName;
+	return catchHelp;
 }
 
-const Value& CmdArgsInterface::operator[](const std::string& key) const
+void CmdArgsInterface::SetBriefDescription(const std::string& description)
 {
-	// Throw exception if param is unknown
-	if (!HasParam(key))
-		throw HazelnuppInvalidKeyException();
+	schema.SetBriefDescription(description);
+	return;
+}
 
-	return *parameters.find(key)->second->GetValue();
+const std::string& CmdArgsInterface::GetBriefDescription()
+{
+	return schema.GetBriefDescription();
 }
 
-void CmdArgsInterface::RegisterAbbreviation(const std::string& abbrev, const std::string& target)
+void CmdArgsInterface::RegisterDescription(const std::string& parameter, const std::string& description)
 {
-	parameterAbreviations.insert(std::pair<std::string, std::string>(abbrev, target));
+	schema.RegisterDescription(parameter, description);
 	return;
 }
 
-const std::string& CmdArgsInterface::GetAbbreviation(const std::string& abbrev) const
+const std::string& CmdArgsInterface::GetDescription(const std::string& parameter) const
 {
-	if (!HasAbbreviation(abbrev))
-		return Placeholders::g_emptyString;
-
-	return parameterAbreviations.find(abbrev)->second;
+	return schema.GetDescription(parameter);
 }
 
-bool CmdArgsInterface::HasAbbreviation(const std::string& abbrev) const
+bool CmdArgsInterface::HasDescription(const std::string& parameter) const
 {
-	return parameterAbreviations.find(abbrev) != parameterAbreviations.end();
+	return schema.HasDescription(parameter);
 }
 
-void CmdArgsInterface::ClearAbbreviation(const std::string& abbrevation)
+void CmdArgsInterface::ClearDescription(const std::string& parameter)
 {
-	parameterAbreviations.erase(abbrevation);
+	schema.ClearDescription(parameter);
 	return;
 }
 
-void CmdArgsInterface::ClearAbbreviations()
+void CmdArgsInterface::ClearDescriptions()
 {
-	parameterAbreviations.clear();
+	schema.ClearDescriptions();
 	return;
 }
 
-void CmdArgsInterface::RegisterConstraint(const std::string& key, const ParamConstraint& constraint)
+void CmdArgsInterface::SetDocumentationWidth(std::size_t documentationWidth)
 {
-	// Magic syntax, wooo
-	(parameterConstraints[key] = constraint).key = key;
+	schema.SetDocumentationWidth(documentationWidth);
 	return;
 }
 
-void CmdArgsInterface::ClearConstraints()
+std::size_t CmdArgsInterface::GetDocumentationWidth() const
 {
-	parameterConstraints.clear();
-	return;
+	return schema.GetDocumentationWidth();
 }
 
-void CmdArgsInterface::SetCrashOnFail(bool crashOnFail)
+const std::string& CmdArgsInterface::GenerateDocumentation() const
 {
-	this->crashOnFail = crashOnFail;
-	return;
+	return schema.GenerateDocumentation();
 }
 
-const ParamConstraint* CmdArgsInterface::GetConstraintForKey(const std::string& key) const
+std::string CmdArgsInterface::GenerateParameterDocumentation(const std::string& key) const
 {
-	const auto constraint = parameterConstraints.find(key);
+	return schema.GenerateParameterDocumentation(key);
+}
 
-	if (constraint == parameterConstraints.end())
-		return nullptr;
+bool CmdArgsInterface::WriteDocumentation(int fd) const
+{
+	return schema.WriteDocumentation(fd);
+}
 
-	return &constraint->second;
+Schema& CmdArgsInterface::GetSchema()
+{
+	return schema;
+}
+
+const Schema& CmdArgsInterface::GetSchema() const
+{
+	return schema;
+}
+
+const ParseResult& CmdArgsInterface::GetParseResult() const
+{
+	return result;
 }
@@ -0,0 +1,336 @@
+#include "Hazelnupp/ConfigFile.h"
+#include "Hazelnupp/HazelnuppException.h"
+
+using namespace Hazelnp;
+
+namespace
+{
+	//! Will return whether c separates tokens on the same line. Carriage returns count as blanks, to read \r\n aswell.
+	bool IsBlank(char c)
+	{
+		return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\v') || (c == '\f');
+	}
+
+	bool IsComment(char c)
+	{
+		return (c == '#') || (c == ';');
+	}
+
+	std::string_view Trim(std::string_view str)
+	{
+		while ((!str.empty()) && (IsBlank(str.front())))
+			str.remove_prefix(1);
+
+		while ((!str.empty()) && (IsBlank(str.back())))
+			str.remove_suffix(1);
+
+		return str;
+	}
+
+	std::string_view TrimDashes(std::string_view str)
+	{
+		while ((!str.empty()) && (str.front() == '-'))
+			str.remove_prefix(1);
+
+		return str;
+	}
+
+	//! Where an entries key and values are, until all of them are known, and can be referenced
+	struct PendingEntry
+	{
+		std::size_t keyBegin;
+		std::size_t keyLength;
+		std::size_t firstValue;
+		std::size_t numValues;
+	};
+}
+
+Internal::ConfigFile::ConfigFile(const std::string& path)
+	:
+	path { path }
+{
+	if (const char* error = file.Map(path))
+		throw HazelnuppConfigFileException(path, 0, error);
+
+	data = file.Data();
+	size = file.Size();
+
+	std::vector<PendingEntry> pending;
+	std::string_view section;
+
+	while (true)
+	{
+		SkipWhitespace();
+		if (cursor >= size)
+			break;
+
+		// Section header, like [render]
+		if (data[cursor] == '[')
+		{
+			const std::size_t begin = ++cursor;
+			while ((cursor < size) && (data[cursor] != ']') && (data[cursor] != '\n'))
+				cursor++;
+
+			if ((cursor >= size) || (data[cursor] != ']'))
+				Fail("Unterminated section header.");
+
+			section = TrimDashes(Trim(std::string_view(data + begin, cursor - begin)));
+			if (section.empty())
+				Fail("Expected a section name.");
+
+			cursor++;
+			ExpectEndOfLine();
+			continue;
+		}
+
+		// Key
+		const std::size_t begin = cursor;
+		while ((cursor < size) && (data[cursor] != '=') && (data[cursor] != '\n'))
+			cursor++;
+
+		if ((cursor >= size) || (data[cursor] != '='))
+			Fail("Expected key = value.");
+
+		const std::string_view key = TrimDashes(Trim(std::string_view(data + begin, cursor - begin)));
+		if (key.empty())
+			Fail("Expected a key.");
+
+		cursor++;
+
+		// Values
+		const std::size_t firstValue = values.size();
+		if (!ParseValue())
+		{
+			values.resize(firstValue);
+			continue;
+		}
+
+		// Keys get their dashes, and their section
+		PendingEntry entry;
+		entry.keyBegin = keys.length();
+		keys += "--";
+		if (!section.empty())
+			(keys += section) += '.';
+		keys += key;
+		entry.keyLength = keys.length() - entry.keyBegin;
+		entry.firstValue = firstValue;
+		entry.numValues = values.size() - firstValue;
+
+		pending.push_back(entry);
+	}
+
+	// Now that keys and values stopped growing, they can be referenced
+	entries.reserve(pending.size());
+	for (const PendingEntry& entry : pending)
+		entries.push_back(Entry {
+			std::string_view(keys.data() + entry.keyBegin, entry.keyLength),
+			values.data() + entry.firstValue,
+			entry.numValues
+		});
+
+	return;
+}
+
+bool Internal::ConfigFile::ParseValue()
+{
+	SkipBlanks();
+
+	// No value at all
+	if ((cursor >= size) || (data[cursor] == '\n') || (IsComment(data[cursor])))
+	{
+		ExpectEndOfLine();
+		return true;
+	}
+
+	// Array
+	if (data[cursor] == '[')
+	{
+		cursor++;
+
+		while (true)
+		{
+			SkipWhitespace();
+			if (cursor >= size)
+				Fail("Unterminated array.");
+
+			if (data[cursor] == ']')
+			{
+				cursor++;
+				break;
+			}
+
+			ParseScalar(true);
+
+			SkipWhitespace();
+			if ((cursor < size) && (data[cursor] == ','))
+				cursor++;
+			else if ((cursor >= size) || (data[cursor] != ']'))
+				Fail("Expected , or ] after an array element.");
+		}
+
+		ExpectEndOfLine();
+		return true;
+	}
+
+	// Scalar. Bare booleans toggle the parameter.
+	const bool isQuoted = ParseScalar(false);
+	ExpectEndOfLine();
+
+	if (!isQuoted)
+	{
+		if (values.back() == "true")
+			values.pop_back();
+
+		else if (values.back() == "false")
+			return false;
+	}
+
+	return true;
+}
+
+bool Internal::ConfigFile::ParseScalar(bool inArray)
+{
+	const char quote = data[cursor];
+
+	// Quoted. Unescape in place. The unescaped value is never longer than the raw one, so writing trails reading.
+	// As long as nothing got dropped yet, both are the same, and nothing has to be written at all.
+	if ((quote == '"') || (quote == '\''))
+	{
+		const std::size_t begin = ++cursor;
+		std::size_t write = begin;
+
+		while (true)
+		{
+			if ((cursor >= size) || (data[cursor] == '\n'))
+				Fail(std::string("Unterminated ") + quote + " quote.");
+
+			const char c = data[cursor];
+
+			if (c == quote)
+			{
+				cursor++;
+				break;
+			}
+
+			else if ((quote == '"') && (c == '\\') && (cursor + 1 < size))
+			{
+				switch (data[cursor + 1])
+				{
+				case 'n':
+					data[write++] = '\n';
+					break;
+
+				case 't':
+					data[write++] = '\t';
+					break;
+
+				case 'r':
+					data[write++] = '\r';
+					break;
+
+				default:
+					data[write++] = data[cursor + 1];
+					break;
+				}
+
+				cursor += 2;
+			}
+
+			else
+			{
+				if (write != cursor)
+					data[write] = c;
+				write++;
+				cursor++;
+			}
+		}
+
+		values.emplace_back(data + begin, write - begin);
+		return true;
+	}
+
+	// Bare. Runs until the end of the line, or a comment. Within arrays, until the next element aswell.
+	const std::size_t begin = cursor;
+	std::size_t end = cursor;
+
+	while (cursor < size)
+	{
+		const char c = data[cursor];
+
+		if ((c == '\n') ||
+			((inArray) && ((c == ',') || (c == ']'))) ||
+			((IsComment(c)) && (cursor > begin) && (IsBlank(data[cursor - 1]))))
+			break;
+
+		cursor++;
+		if (!IsBlank(c))
+			end = cursor;
+	}
+
+	if (end == begin)
+		Fail("Expected a value.");
+
+	values.emplace_back(data + begin, end - begin);
+	return false;
+}
+
+void Internal::ConfigFile::SkipBlanks()
+{
+	while ((cursor < size) && (IsBlank(data[cursor])))
+		cursor++;
+
+	return;
+}
+
+void Internal::ConfigFile::SkipWhitespace()
+{
+	while (cursor < size)
+	{
+		if (data[cursor] == '\n')
+		{
+			line++;
+			cursor++;
+		}
+
+		else if (IsBlank(data[cursor]))
+			cursor++;
+
+		else if (IsComment(data[cursor]))
+			while ((cursor < size) && (data[cursor] != '\n'))
+				cursor++;
+
+		else
+			break;
+	}
+
+	return;
+}
+
+void Internal::ConfigFile::ExpectEndOfLine()
+{
+	SkipBlanks();
+
+	if ((cursor < size) && (IsComment(data[cursor])))
+		while ((cursor < size) && (data[cursor] != '\n'))
+			cursor++;
+
+	if ((cursor < size) && (data[cursor] != '\n'))
+		Fail("Unexpected characters after the value.");
+
+	return;
+}
+
+void Internal::ConfigFile::Fail(const std::string& reason) const
+{
+	throw HazelnuppConfigFileException(path, line, reason);
+}
+
+const std::vector<Internal::ConfigFile::Entry>& Internal::ConfigFile::GetEntries() const
+{
+	return entries;
+}
+
+const std::string& Internal::ConfigFile::GetPath() const
+{
+	return path;
+}
@@ -0,0 +1,109 @@
+#include "Hazelnupp/KeyIndex.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace Hazelnp;
+
+namespace
+{
+	//! Will return the length of the longest common prefix of a and b
+	std::size_t CommonPrefixLength(std::string_view a, std::string_view b)
+	{
+		const std::size_t length = std::min(a.length(), b.length());
+
+		std::size_t i = 0;
+		while ((i < length) && (a[i] == b[i]))
+			i++;
+
+		return i;
+	}
+}
+
+void Internal::KeyIndex::Build(std::vector<std::string_view> keys)
+{
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+	this->keys = std::move(keys);
+	nodes.clear();
+
+	if (this->keys.empty())
+		return;
+
+	nodes.reserve(this->keys.size() * 2);
+	nodes.push_back(Node { 0, 0, (std::uint32_t)this->keys.size(), 0, 0, '\0' });
+
+	// Breadth first, so that the children of each node get appended next to each other
+	for (std::size_t i = 0; i < nodes.size(); i++)
+	{
+		const std::size_t begin = nodes[i].firstKey;
+		const std::size_t end = begin + nodes[i].numKeys;
+
+		// The keys are sorted, so the prefix all of them share is the one of the first and the last one
+		const std::size_t depth = CommonPrefixLength(this->keys[begin], this->keys[end - 1]);
+
+		// A key ending right here is the prefix itself. It sorts first, and has no child.
+		std::size_t j = begin;
+		if (this->keys[j].length() == depth)
+			j++;
+
+		// Each run of keys sharing the next character is a child
+		const std::size_t firstChild = nodes.size();
+		while (j < end)
+		{
+			const char label = this->keys[j][depth];
+
+			std::size_t k = j + 1;
+			while ((k < end) && (this->keys[k][depth] == label))
+				k++;
+
+			nodes.push_back(Node { 0, (std::uint32_t)j, (std::uint32_t)(k - j), 0, 0, label });
+			j = k;
+		}
+
+		Node& node = nodes[i];
+		node.depth = (std::uint32_t)depth;
+		node.firstChild = (std::uint32_t)firstChild;
+		node.numChildren = (std::uint32_t)(nodes.size() - firstChild);
+	}
+
+	return;
+}
+
+Span<const std::string_view> Internal::KeyIndex::FindPrefixed(std::string_view prefix) const
+{
+	if (nodes.empty())
+		return Span<const std::string_view>();
+
+	const Node* node = &nodes[0];
+	std::size_t matched = 0;
+
+	while (true)
+	{
+		// Compare the rest of the prefix this node stands for. All keys of its range have it, so the first one will do.
+		const std::string_view key = keys[node->firstKey];
+		const std::size_t end = std::min<std::size_t>(node->depth, prefix.length());
+
+		if (std::memcmp(key.data() + matched, prefix.data() + matched, end - matched) != 0)
+			return Span<const std::string_view>();
+
+		// All of prefix matched, so each key of this range begins with it
+		if (end == prefix.length())
+			return Span<const std::string_view>(keys.data() + node->firstKey, node->numKeys);
+
+		matched = end;
+
+		// Descend by the next character
+		const Node* const firstChild = nodes.data() + node->firstChild;
+		const Node* const lastChild = firstChild + node->numChildren;
+
+		const Node* child = firstChild;
+		while ((child != lastChild) && (child->label != prefix[matched]))
+			child++;
+
+		if (child == lastChild)
+			return Span<const std::string_view>();
+
+		node = child;
+	}
+}
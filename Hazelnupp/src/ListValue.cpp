@@ -1,97 +1,59 @@
 #include "Hazelnupp/ListValue.h"
 #include "Hazelnupp/HazelnuppException.h"
-#include <sstream>
 
 using namespace Hazelnp;
 
 ListValue::ListValue() :
 	Value(DATA_TYPE::LIST)
 {
-	return;
-}
-
-ListValue::~ListValue()
-{
-	for (Value* val : value)
-		delete val;
+	data.listStorage = new Internal::ListStorage();
+	data.listStorage->elements = new std::vector<Value*>();
+	isOwning = true;
 
-	value.clear();
-	
 	return;
 }
 
-Value* ListValue::Deepcopy() const
-{
-	ListValue* newList = new ListValue();
-
-	for (const Value* val : value)
-		newList->AddValue(val);
-
-	return newList;
-}
-
-void ListValue::AddValue(const Value* value)
+ListValue::ListValue(Internal::ListStorage* storage) :
+	Value(DATA_TYPE::LIST)
 {
-	this->value.emplace_back(value->Deepcopy());
+	data.listStorage = storage;
 	return;
 }
 
-const std::vector<Value*>& ListValue::GetValue() const
-{
-	return value;
-}
-
-std::string ListValue::GetAsOsString() const
-{
-	std::stringstream ss;
-
-	ss << "ListValue: [";
-
-	for (const Value* val : value)
-	{
-		ss << *val;
-		if (val != value.back())
-			ss << ", ";
-	}
-
-	ss << "]";
-
-	return ss.str();
-}
-
-ListValue::operator std::vector<Value*>() const
+void ListValue::AddValue(const Value* value)
 {
-	return value;
-}
+	// Lists not owning their values would leak this copy
+	if (!isOwning)
+		throw HazelnuppException("Cannot add a copy to a list living in an arena!");
 
+	// Copies keep the contiguous elements of their original. Now they would be out of date.
+	DropTypedElements();
 
+	data.listStorage->elements.load()->emplace_back(value->Deepcopy());
+	data.listStorage->size++;
 
-long long int ListValue::GetInt64() const
-{
-	throw HazelnuppValueNotConvertibleException();
+	return;
 }
 
-int ListValue::GetInt32() const
+void ListValue::AddValueReference(Value* value)
 {
-	throw HazelnuppValueNotConvertibleException();
-}
+	data.listStorage->elements.load()->emplace_back(value);
+	data.listStorage->size++;
 
-long double ListValue::GetFloat64() const
-{
-	throw HazelnuppValueNotConvertibleException();
+	return;
 }
 
-double ListValue::GetFloat32() const
+const std::vector<Value*>& ListValue::GetValue() const
 {
-	throw HazelnuppValueNotConvertibleException();
+	return GetList();
 }
 
-std::string ListValue::GetString() const
+bool ListValue::IsOwning() const
 {
-	throw HazelnuppValueNotConvertibleException();
+	return isOwning;
 }
 
-const std::vector<Value*>& ListValue::GetList() const
+ListValue::operator std::vector<Value*>() const
 {
-	return value;
+	return GetList();
 }
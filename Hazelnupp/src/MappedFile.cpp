@@ -0,0 +1,103 @@
+#include "Hazelnupp/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace Hazelnp;
+
+#ifdef _WIN32
+const char* Internal::MappedFile::Map(const std::string& path)
+{
+	file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		file = nullptr;
+		return "Unable to open it.";
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+		return "Unable to determine its size.";
+
+	size = (std::size_t)fileSize.QuadPart;
+
+	// Nothing to map
+	if (size == 0)
+		return nullptr;
+
+	// Copy-on-write, so that contents can be changed in place, without touching the file
+	mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	if (mapping != nullptr)
+		data = (char*)MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, size);
+
+	if (data == nullptr)
+		return "Unable to map it.";
+
+	return nullptr;
+}
+
+Internal::MappedFile::~MappedFile()
+{
+	if (data != nullptr)
+		UnmapViewOfFile(data);
+	if (mapping != nullptr)
+		CloseHandle(mapping);
+	if (file != nullptr)
+		CloseHandle(file);
+
+	return;
+}
+#else
+const char* Internal::MappedFile::Map(const std::string& path)
+{
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return "Unable to open it.";
+
+	struct stat status;
+	if ((fstat(fd, &status) != 0) || (!S_ISREG(status.st_mode)))
+	{
+		close(fd);
+		return "It is not a regular file.";
+	}
+
+	size = (std::size_t)status.st_size;
+
+	// Nothing to map
+	if (size == 0)
+	{
+		close(fd);
+		return nullptr;
+	}
+
+	// Copy-on-write, so that contents can be changed in place, without touching the file
+	void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (mapped == MAP_FAILED)
+	{
+		size = 0;
+		return "Unable to map it.";
+	}
+
+	data = (char*)mapped;
+
+	return nullptr;
+}
+
+Internal::MappedFile::~MappedFile()
+{
+	if (data != nullptr)
+		munmap(data, size);
+
+	return;
+}
+#endif
@@ -1,29 +1,44 @@
 #include "Hazelnupp/Parameter.h"
+#include "Hazelnupp/ParseResult.h"
 
 using namespace Hazelnp;
 
-Parameter::Parameter(const std::string& key, const ::Value* value)
+Parameter::Parameter(std::string_view key, ::Value* value, PARAM_SOURCE source, std::string_view origin)
 	:
-	key{ key }
+	key{ key },
+	value{ value },
+	origin{ origin },
+	source{ source }
 {
-	this->value = value->Deepcopy();
 	return;
 }
 
+
 Parameter::~Parameter()
 {
-	delete value;
-	value = nullptr;
+	// Those of a ParseResult belong to it
+	if (owner == nullptr)
+		delete keyString.load(std::memory_order_acquire);
 
 	return;
 }
 
 const std::string& Parameter::Key() const
 {
-	return key;
-}
+	const std::string* cached = keyString.load(std::memory_order_acquire);
+	if (cached != nullptr)
+		return *cached;
 
-const ::Value* Parameter::GetValue() const
-{
-	return value;
+	const std::string* const str = (owner != nullptr) ? owner->NewCachedString(key) : new std::string(key);
+
+	// Another thread may have been faster. Then use its std::string.
+	if (!keyString.compare_exchange_strong(cached, str, std::memory_order_acq_rel, std::memory_order_acquire))
+	{
+		if (owner == nullptr)
+			delete str;
+
+		return *cached;
+	}
+
+	return *str;
 }
@@ -0,0 +1,1637 @@
+#include "Hazelnupp/ParseResult.h"
+#include "Hazelnupp/VoidValue.h"
+#include "Hazelnupp/IntValue.h"
+#include "Hazelnupp/FloatValue.h"
+#include "Hazelnupp/StringValue.h"
+#include "Hazelnupp/ListValue.h"
+#include "Hazelnupp/HazelnuppException.h"
+#include "Hazelnupp/StringTools.h"
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifdef _WIN32
+#include <stdlib.h>
+#define HAZELNUPP_ENVIRON _environ
+#else
+extern char** environ;
+#define HAZELNUPP_ENVIRON environ
+#endif
+
+using namespace Hazelnp;
+
+namespace
+{
+	//! Will return the index of the lowest bit set. word must not be 0.
+	std::size_t CountTrailingZeros(std::uint64_t word)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward64(&index, word);
+		return index;
+#else
+		return __builtin_ctzll(word);
+#endif
+	}
+
+	//! Will return whether c separates the values of a list taken from an environment variable
+	bool IsWhitespace(const char c)
+	{
+		return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') || (c == '\v') || (c == '\f');
+	}
+
+	//! Will return whether part views into whole
+	bool PointsInto(std::string_view part, std::string_view whole)
+	{
+		const std::less<const char*> before;
+		return (!before(part.data(), whole.data())) && (before(part.data(), whole.data() + whole.length()));
+	}
+}
+
+ParseResult::ParseResult(const Schema& schema, std::pmr::memory_resource* upstream)
+	:
+	schema { &schema },
+	arena { upstream },
+	parameters { arena.New<ParameterMap>(&arena) }
+{
+	return;
+}
+
+ParseResult::~ParseResult()
+{
+	// Nothing to walk. All parse results die with the arena.
+	return;
+}
+
+void ParseResult::ClearParameters()
+{
+	// Every Value, Parameter and the map itself live in the arena. Just rewind it as a whole.
+	// Its memory is kept for the next parse.
+	arena.Reset();
+	parameters = arena.New<ParameterMap>(&arena);
+	numElementVectorsInUse = 0;
+	numCachedStringsInUse = 0;
+
+	// One slot per parameter of the static schema
+	staticParameters = nullptr;
+	numStaticSlots = schema->staticSchema.numSpecs;
+	if (numStaticSlots > 0)
+	{
+		staticParameters = (Parameter**)arena.allocate(numStaticSlots * sizeof(Parameter*), alignof(Parameter*));
+		std::fill_n(staticParameters, numStaticSlots, nullptr);
+	}
+
+	// One slot, and one presence bit, per dense id issued
+	parametersById = nullptr;
+	presentIds = nullptr;
+	numIdSlots = schema->numIds;
+	if (numIdSlots > 0)
+	{
+		parametersById = (Parameter**)arena.allocate(numIdSlots * sizeof(Parameter*), alignof(Parameter*));
+		std::fill_n(parametersById, numIdSlots, nullptr);
+
+		const std::size_t numWords = (numIdSlots + 63) / 64;
+		presentIds = (std::uint64_t*)arena.allocate(numWords * sizeof(std::uint64_t), alignof(std::uint64_t));
+		std::fill_n(presentIds, numWords, 0);
+	}
+
+	// The environment may have changed since
+	environmentSnapshot = nullptr;
+
+	accumulations = nullptr;
+	accumulationsByParameter = nullptr;
+
+	return;
+}
+
+void ParseResult::Reset()
+{
+	ClearParameters();
+
+	rawArgs.clear();
+	argvBuffer.clear();
+	executableName.clear();
+	responseFiles.clear();
+	pendingToken.clear();
+	streaming = false;
+
+	return;
+}
+
+void ParseResult::Parse(const int argc, const char* const* argv)
+{
+	const Internal::PhaseMark call = BeginCall();
+
+	try
+	{
+		// Parameters of a previous parse reference buffers we are about to overwrite
+		ClearParameters();
+		streaming = false;
+
+		// Populate raw arguments
+		Internal::PhaseMark phase = BeginPhase();
+		PopulateRawArgs(argc, argv);
+		EndPhase(PARSE_PHASE::POPULATE_RAW_ARGS, phase, rawArgs.size());
+
+		// Expand abbreviations
+		phase = BeginPhase();
+		ExpandAbbreviations();
+		EndPhase(PARSE_PHASE::EXPAND_ABBREVIATIONS, phase, rawArgs.size());
+
+		// Assign, to reuse its capacity
+		executableName.assign(rawArgs[0].data(), rawArgs[0].length());
+
+		// Read and parse all parameters
+		phase = BeginPhase();
+		ParseParameters();
+		EndPhase(PARSE_PHASE::PARSE_VALUES, phase, rawArgs.size() - 1);
+
+		// Apply constraints such as default values, and required parameters.
+		// Types have already been enforced.
+		phase = BeginPhase();
+		ApplyConstraints();
+		EndPhase(PARSE_PHASE::APPLY_CONSTRAINTS, phase, 0);
+	}
+	catch (...)
+	{
+		EndCall(call, false);
+		throw;
+	}
+
+	EndCall(call, true);
+
+	return;
+}
+
+void ParseResult::ParseParameters()
+{
+	// Read and parse all parameters, in a single forward scan.
+	// Each token gets classified exactly once. Every token beginning with "--" ends
+	// the value list of the current parameter. If it is longer than that, it's the next key.
+	std::size_t keyIndex = 0; // 0 means we are not within a parameter (argv[0] is never a key)
+	for (std::size_t i = 1; i <= rawArgs.size(); i++)
+	{
+		const bool isEnd = i == rawArgs.size();
+		if ((!isEnd) && (!IsParameterDelimiter(rawArgs[i])))
+			continue;
+
+		// Finalize the current parameter, its values are in between
+		if (keyIndex > 0)
+			ParseParameter(keyIndex, i);
+
+		// A lonely "--" is no key, and the values following it belong to no parameter
+		keyIndex = ((!isEnd) && (rawArgs[i].length() > 2)) ? i : 0;
+	}
+
+	return;
+}
+
+Internal::PhaseMark ParseResult::BeginCall()
+{
+	if constexpr (g_instrumentationEnabled)
+		stats = ParseStats();
+
+	return BeginPhase();
+}
+
+Internal::PhaseMark ParseResult::BeginPhase() const
+{
+	Internal::PhaseMark mark;
+
+	if constexpr (g_instrumentationEnabled)
+	{
+		mark.numValues = numValuesCreated;
+		mark.numAllocations = arena.GetNumAllocations();
+		mark.numUpstreamAllocations = arena.GetNumUpstreamAllocations();
+		mark.begin = std::chrono::steady_clock::now();
+	}
+
+	return mark;
+}
+
+void ParseResult::EndPhase(PARSE_PHASE phase, const Internal::PhaseMark& mark, std::size_t numTokens)
+{
+	if constexpr (g_instrumentationEnabled)
+	{
+		PhaseStats& phaseStats = stats[phase];
+		phaseStats.duration += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mark.begin);
+		phaseStats.numTokens += numTokens;
+		phaseStats.numValues += numValuesCreated - mark.numValues;
+		phaseStats.numAllocations += arena.GetNumAllocations() - mark.numAllocations;
+		phaseStats.numUpstreamAllocations += arena.GetNumUpstreamAllocations() - mark.numUpstreamAllocations;
+	}
+
+	return;
+}
+
+void ParseResult::EndCall(const Internal::PhaseMark& mark, bool succeeded)
+{
+	if constexpr (g_instrumentationEnabled)
+	{
+		stats.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mark.begin);
+		stats.succeeded = succeeded;
+
+		if (instrumentationSink != nullptr)
+			instrumentationSink->OnParse(stats);
+	}
+
+	return;
+}
+
+void ParseResult::SetInstrumentationSink(InstrumentationSink* sink)
+{
+	instrumentationSink = sink;
+	return;
+}
+
+InstrumentationSink* ParseResult::GetInstrumentationSink() const
+{
+	return instrumentationSink;
+}
+
+const ParseStats& ParseResult::GetParseStats() const
+{
+	return stats;
+}
+
+bool ParseResult::IsParameterDelimiter(std::string_view arg)
+{
+	return (arg.length() >= 2) && (arg[0] == '-') && (arg[1] == '-');
+}
+
+void ParseResult::ParseParameter(const std::size_t keyIndex, const std::size_t endIndex)
+{
+	const std::string_view key = rawArgs[keyIndex];
+
+	// The values are just the args in between
+	const std::string_view* values = rawArgs.data() + keyIndex + 1;
+	const std::size_t numValues = endIndex - keyIndex - 1;
+
+	if constexpr (g_instrumentationEnabled)
+		numValuesCreated++;
+
+	// Is it known to the static schema? Then it goes into its slot. No map involved.
+	bool isAbbreviation = false;
+	const std::size_t id = schema->staticSchema.Find(key, isAbbreviation);
+	if ((id != Internal::StaticSchemaView::npos) && (!isAbbreviation))
+	{
+		const ParamSpec& spec = schema->staticSchema.specs[id];
+
+		// Appended values get converted once all occurrences are known
+		if (spec.repeatPolicy == REPEAT_POLICY::APPEND)
+		{
+			if (staticParameters[id] == nullptr)
+				StoreStaticParameter(BeginAccumulation(key, spec), id);
+
+			Accumulate(staticParameters[id], values, numValues);
+			return;
+		}
+
+		if ((spec.repeatPolicy == REPEAT_POLICY::REJECT) && (staticParameters[id] != nullptr))
+			throw HazelnuppConstraintRepeatedParameter(std::string(key), std::string(spec.description));
+
+		// Streams drop their tokens after each parameter, so lazy values need their own copy of them
+		Value* parsedVal = (lazyConversion) ?
+			NewLazyValue(values, numValues, spec, streaming) :
+			ParseValue(values, numValues, spec);
+
+		// Keep the first occurrence, unless told otherwise
+		if ((staticParameters[id] == nullptr) || (spec.repeatPolicy == REPEAT_POLICY::KEEP_LAST))
+		{
+			StoreStaticParameter(NewParameter(key, parsedVal), id);
+
+			if (parameterCallback)
+				parameterCallback(*staticParameters[id]);
+		}
+
+		return;
+	}
+
+	// Fetch constraint info
+	lookupBuffer.assign(key.data(), key.length());
+	const ParamConstraint* pcn = schema->GetConstraintForKey(lookupBuffer);
+
+	// Unconstrained keys may still have a dense id, if others list them as incompatible
+	std::size_t denseId = Schema::npos;
+	if (pcn != nullptr)
+		denseId = pcn->id;
+	else if (!schema->unconstrainedIds.empty())
+		denseId = schema->FindId(lookupBuffer);
+
+	const TypeRequirement requirement = (pcn != nullptr) ? TypeRequirement(*pcn) : TypeRequirement();
+	const REPEAT_POLICY repeatPolicy = (pcn != nullptr) ? pcn->repeatPolicy : REPEAT_POLICY::KEEP_FIRST;
+
+	// Only look for a previous occurrence, if the policy cares
+	if (repeatPolicy != REPEAT_POLICY::KEEP_FIRST)
+	{
+		const auto previous = parameters->find(key);
+
+		// Appended values get converted once all occurrences are known
+		if (repeatPolicy == REPEAT_POLICY::APPEND)
+		{
+			Parameter* param = (previous != parameters->end()) ? previous->second : nullptr;
+			if (param == nullptr)
+			{
+				param = BeginAccumulation(key, requirement);
+				StoreParameter(param, denseId);
+			}
+
+			Accumulate(param, values, numValues);
+			return;
+		}
+
+		if ((repeatPolicy == REPEAT_POLICY::REJECT) && (previous != parameters->end()))
+			throw HazelnuppConstraintRepeatedParameter(std::string(key), schema->GetDescription(lookupBuffer));
+	}
+
+	Value* parsedVal = (lazyConversion) ?
+		NewLazyValue(values, numValues, requirement, streaming) :
+		ParseValue(values, numValues, requirement);
+	if (parsedVal == nullptr)
+		throw std::runtime_error("Unable to parse parameter!");
+
+	Parameter* param = NewParameter(key, parsedVal);
+	if ((StoreParameter(param, denseId, repeatPolicy == REPEAT_POLICY::KEEP_LAST)) && (parameterCallback))
+		parameterCallback(*param);
+
+	return;
+}
+
+void ParseResult::StoreStaticParameter(Parameter* param, const std::size_t id)
+{
+	staticParameters[id] = param;
+
+	// Runtime constraints may list it as incompatible. Then it has a dense id, and has to count as present.
+	if (schema->numIds > 0)
+	{
+		lookupBuffer.assign(param->KeyView().data(), param->KeyView().length());
+		const std::size_t runtimeId = schema->FindId(lookupBuffer);
+		if (runtimeId < numIdSlots)
+		{
+			parametersById[runtimeId] = param;
+			presentIds[runtimeId / 64] |= (std::uint64_t)1 << (runtimeId % 64);
+		}
+	}
+
+	return;
+}
+
+bool ParseResult::StoreParameter(Parameter* param, const std::size_t id, bool replace)
+{
+	// Keep the first occurrence, unless told otherwise
+	const auto inserted = parameters->insert(std::pair<std::string_view, Parameter*>(param->KeyView(), param));
+	if (!inserted.second)
+	{
+		if (!replace)
+			return false;
+
+		inserted.first->second = param;
+	}
+
+	// Does it have a dense id? Then fill its slot, and mark it present
+	if (id < numIdSlots)
+	{
+		parametersById[id] = param;
+		presentIds[id / 64] |= (std::uint64_t)1 << (id % 64);
+	}
+
+	return true;
+}
+
+Parameter* ParseResult::BeginAccumulation(std::string_view key, TypeRequirement requirement)
+{
+	// Unconstrained ones are lists, so they read the same, no matter how often they were supplied
+	if (!requirement.constrainType)
+	{
+		requirement.constrainType = true;
+		requirement.requiredType = DATA_TYPE::LIST;
+	}
+
+	// Until it is complete, it is void
+	Parameter* param = NewParameter(key, arena.New<VoidValue>());
+
+	if (accumulations == nullptr)
+	{
+		accumulations = arena.New<std::pmr::vector<Accumulation*>>(&arena);
+		accumulationsByParameter = arena.New<std::pmr::unordered_map<const Parameter*, Accumulation*>>(&arena);
+	}
+
+	Accumulation* accumulation = arena.New<Accumulation>(param, requirement, &arena);
+	accumulations->push_back(accumulation);
+	accumulationsByParameter->emplace(param, accumulation);
+
+	return param;
+}
+
+void ParseResult::Accumulate(const Parameter* param, const std::string_view* values, const std::size_t numValues)
+{
+	// Copying the views is cheap. The strings they reference are stored already, but streams drop the views.
+	std::pmr::vector<std::string_view>& tokens = accumulationsByParameter->at(param)->tokens;
+	tokens.insert(tokens.end(), values, values + numValues);
+
+	return;
+}
+
+void ParseResult::FinishAccumulations()
+{
+	if (accumulations == nullptr)
+		return;
+
+	for (Accumulation* accumulation : *accumulations)
+	{
+		// The tokens do not grow anymore, so lazy values may reference them
+		const std::pmr::vector<std::string_view>& tokens = accumulation->tokens;
+		accumulation->param->value = (lazyConversion) ?
+			NewLazyValue(tokens.data(), tokens.size(), accumulation->requirement, false) :
+			ParseValue(tokens.data(), tokens.size(), accumulation->requirement);
+
+		if (parameterCallback)
+			parameterCallback(*accumulation->param);
+	}
+
+	return;
+}
+
+void ParseResult::BeginStream(std::string_view executableName)
+{
+	streamMark = BeginCall();
+
+	// Parameters of a previous parse reference buffers we are about to overwrite
+	ClearParameters();
+	responseFiles.clear();
+	pendingToken.clear();
+
+	this->executableName.assign(executableName.data(), executableName.length());
+
+	// Indices into rawArgs work just like with Parse(). Index 0 is never a key.
+	rawArgs.clear();
+	rawArgs.emplace_back(this->executableName);
+	RememberPreviousArity(false);
+	streamKeyIndex = 0;
+	streaming = true;
+
+	return;
+}
+
+void ParseResult::Push(std::string_view token)
+{
+	if (!streaming)
+		throw HazelnuppException("Begin a stream before pushing tokens to it!");
+
+	// Clusters of abbreviations expand into several args. Their long forms are already stored.
+	expandedArgs.clear();
+	ExpandArg(token, expandedArgs);
+
+	for (const std::string_view& arg : expandedArgs)
+	{
+		// The parameter will reference it, and the callers buffer is transient, so store a copy
+		const bool isTransient = PointsInto(arg, token);
+
+		// A key ends the value list of the current parameter
+		if (IsParameterDelimiter(arg))
+		{
+			FinishStreamedParameter();
+
+			// A lonely "--" is no key
+			if (arg.length() > 2)
+			{
+				rawArgs.push_back((isTransient) ? StoreString(arg) : arg);
+				streamKeyIndex = rawArgs.size() - 1;
+			}
+		}
+
+		// Values following no key belong to no parameter. So only keep the others.
+		else if (streamKeyIndex > 0)
+			rawArgs.push_back((isTransient) ? StoreString(arg) : arg);
+	}
+
+	// A key not looked up yet may reference the callers buffer. Keys always get kept, so reference the one stored instead.
+	if (!previousKey.empty())
+		previousKey = rawArgs.back();
+
+	return;
+}
+
+void ParseResult::Push(const std::string_view* tokens, const std::size_t numTokens)
+{
+	for (std::size_t i = 0; i < numTokens; i++)
+		Push(tokens[i]);
+
+	return;
+}
+
+void ParseResult::PushChunk(std::string_view chunk, const char delimiter)
+{
+	if (!streaming)
+		throw HazelnuppException("Begin a stream before pushing tokens to it!");
+
+	while (true)
+	{
+		const std::size_t end = chunk.find(delimiter);
+
+		// The rest of the token has yet to arrive
+		if (end == std::string_view::npos)
+		{
+			pendingToken.append(chunk.data(), chunk.length());
+			return;
+		}
+
+		// Only assemble the token, if it spans several chunks
+		if (pendingToken.empty())
+			Push(chunk.substr(0, end));
+		else
+		{
+			pendingToken.append(chunk.data(), end);
+			Push(pendingToken);
+			pendingToken.clear();
+		}
+
+		chunk.remove_prefix(end + 1);
+	}
+}
+
+void ParseResult::EndStream()
+{
+	if (!streaming)
+		throw HazelnuppException("Begin a stream before ending it!");
+
+	// The last token needs no delimiter
+	if (!pendingToken.empty())
+	{
+		Push(pendingToken);
+		pendingToken.clear();
+	}
+
+	FinishStreamedParameter();
+	streaming = false;
+
+	// Apply constraints such as default values, and required parameters.
+	// Types have already been enforced.
+	try
+	{
+		const Internal::PhaseMark phase = BeginPhase();
+		ApplyConstraints();
+		EndPhase(PARSE_PHASE::APPLY_CONSTRAINTS, phase, 0);
+	}
+	catch (...)
+	{
+		EndCall(streamMark, false);
+		throw;
+	}
+
+	EndCall(streamMark, true);
+
+	return;
+}
+
+bool ParseResult::IsStreaming() const
+{
+	return streaming;
+}
+
+void ParseResult::FinishStreamedParameter()
+{
+	if (streamKeyIndex > 0)
+		ParseParameter(streamKeyIndex, rawArgs.size());
+
+	// Its tokens are not needed anymore. Parsed values reference the arena, not rawArgs.
+	// So rawArgs never grows beyond the longest parameter, no matter how long the stream is.
+	rawArgs.resize(1);
+	streamKeyIndex = 0;
+
+	return;
+}
+
+void ParseResult::SetParameterCallback(const ParameterCallback& callback)
+{
+	parameterCallback = callback;
+	return;
+}
+
+const ParseResult::ParameterCallback& ParseResult::GetParameterCallback() const
+{
+	return parameterCallback;
+}
+
+void ParseResult::PopulateRawArgs(const int argc, const char* const* argv)
+{
+	rawArgs.clear();
+	rawArgs.reserve(argc);
+
+	// Nothing references the mappings of the previous parse anymore
+	responseFiles.clear();
+
+	// Unless we just reference the callers argv, copy all of it into one contiguous buffer.
+	// Reserve all of it beforehand, so that our views stay valid.
+	if (!borrowArgv)
+	{
+		std::size_t totalLength = 0;
+		for (int i = 0; i < argc; i++)
+			totalLength += std::strlen(argv[i]);
+
+		argvBuffer.clear();
+		argvBuffer.reserve(totalLength);
+	}
+
+	for (int i = 0; i < argc; i++)
+	{
+		// Response files get replaced by their contents. argv[0] is never one.
+		if ((expandResponseFiles) && (i > 0) && (IsResponseFile(argv[i])))
+			ExpandResponseFile(argv[i] + 1, 1);
+
+		else if (borrowArgv)
+			rawArgs.emplace_back(argv[i]);
+
+		else
+		{
+			const std::size_t begin = argvBuffer.length();
+			argvBuffer.append(argv[i]);
+			rawArgs.emplace_back(argvBuffer.data() + begin, argvBuffer.length() - begin);
+		}
+	}
+
+	return;
+}
+
+void ParseResult::ExpandResponseFile(const std::string& path, const std::size_t depth)
+{
+	if (depth > maxResponseFileDepth)
+		throw HazelnuppResponseFileException(path, "Response files are nested deeper than " + std::to_string(maxResponseFileDepth) + " levels.");
+
+	// The file stays mapped until the next parse, so that its tokens can be referenced directly
+	responseFiles.emplace_back(std::make_unique<Internal::ResponseFile>(path));
+	Internal::ResponseFile& file = *responseFiles.back();
+
+	std::string_view token;
+	bool isQuoted;
+	while (file.NextToken(token, isQuoted))
+	{
+		// Quoting the @ keeps it literal
+		if ((!isQuoted) && (IsResponseFile(token)))
+		{
+			const std::filesystem::path nested = std::filesystem::path(path).parent_path() / std::filesystem::path(token.substr(1));
+			ExpandResponseFile(nested.string(), depth + 1);
+		}
+		else
+			rawArgs.push_back(token);
+	}
+
+	return;
+}
+
+bool ParseResult::IsResponseFile(std::string_view arg)
+{
+	return (arg.length() > 1) && (arg[0] == '@');
+}
+
+std::string_view ParseResult::StoreString(std::string_view str)
+{
+	char* copy = (char*)arena.allocate(str.length(), 1);
+	str.copy(copy, str.length());
+
+	return std::string_view(copy, str.length());
+}
+
+void ParseResult::ExpandAbbreviations()
+{
+	// Abort if no abbreviations, and no prefixes to match
+	if ((schema->parameterAbreviations.size() == 0) && (schema->staticSchema.numSpecs == 0) && (!schema->matchUniquePrefixes))
+		return;
+
+	// Clusters expand into several args, so expand into a second buffer, and swap. Both keep their capacity.
+	// The executable name is never a key.
+	expandedArgs.clear();
+	expandedArgs.reserve(rawArgs.size());
+	expandedArgs.push_back(rawArgs[0]);
+	RememberPreviousArity(false);
+
+	for (std::size_t i = 1; i < rawArgs.size(); i++)
+		ExpandArg(rawArgs[i], expandedArgs);
+
+	rawArgs.swap(expandedArgs);
+
+	return;
+}
+
+void ParseResult::ExpandArg(std::string_view arg, std::vector<std::string_view>& out)
+{
+	const bool isDashed = (arg.length() >= 2) && (arg[0] == '-') && (arg[1] != '-');
+
+	// Unique prefixes of keys, like --verb for --verbose. A lonely "--" is no key.
+	// Args beginning with "--" are keys, even following one taking a value, so they always get matched.
+	// Abbreviations, like --v for --verbose, go first though.
+	if ((schema->matchUniquePrefixes) && (IsParameterDelimiter(arg)) && (arg.length() > 2))
+	{
+		std::string_view longForm = arg;
+		if ((schema->numLongAbbreviations > 0) && (ExpandAbbreviation(longForm)))
+			out.push_back(longForm);
+		else
+			out.push_back(MatchPrefix(arg));
+
+		RememberPrevious(out.back());
+		return;
+	}
+
+	// Single character abbreviations, like -f, are just a table read. So is their arity.
+	if ((isDashed) && (arg.length() == 2))
+	{
+		const Internal::ShortFlag& flag = schema->shortFlags[(unsigned char)arg[1]];
+		if ((flag.longForm.empty()) || (PreviousTakesSingleValue()))
+		{
+			out.push_back(arg);
+			RememberPrevious(arg);
+		}
+		else
+		{
+			out.push_back(ExpandShortFlag(flag));
+			RememberPreviousArity(flag.takesSingleValue);
+		}
+
+		return;
+	}
+
+	// Others have to be looked up as a whole. Only if there are any.
+	// Args beginning with "--" are keys, even following one taking a value, so they always get expanded.
+	if (schema->numLongAbbreviations > 0)
+	{
+		std::string_view longForm = arg;
+		if (ExpandAbbreviation(longForm))
+		{
+			out.push_back(((!IsParameterDelimiter(arg)) && (PreviousTakesSingleValue())) ? arg : longForm);
+			RememberPrevious(out.back());
+			return;
+		}
+	}
+
+	// Clusters, like -ltr. Values are never expanded, even if they look like one.
+	if ((isDashed) && (!PreviousTakesSingleValue()) && (ExpandCluster(arg, out)))
+		return;
+
+	out.push_back(arg);
+	RememberPrevious(arg);
+
+	return;
+}
+
+bool ParseResult::ExpandCluster(std::string_view arg, std::vector<std::string_view>& out)
+{
+	// Each character has to be an abbreviation, up until the first one taking values. The rest is its value then.
+	// Else it is no cluster, but just a value beginning with a dash, like -5.
+	std::size_t end = 1;
+	while (end < arg.length())
+	{
+		const Internal::ShortFlag& flag = schema->shortFlags[(unsigned char)arg[end]];
+		if (flag.longForm.empty())
+			return false;
+
+		end++;
+		if (flag.takesValue)
+			break;
+	}
+
+	for (std::size_t i = 1; i < end; i++)
+		out.push_back(ExpandShortFlag(schema->shortFlags[(unsigned char)arg[i]]));
+
+	// The attached value, like file of -ofile
+	if (end < arg.length())
+	{
+		out.push_back(arg.substr(end));
+		RememberPrevious(out.back());
+	}
+	else
+		RememberPreviousArity(schema->shortFlags[(unsigned char)arg[end - 1]].takesSingleValue);
+
+	return true;
+}
+
+std::string_view ParseResult::ExpandShortFlag(const Internal::ShortFlag& flag)
+{
+	// Long forms of the static schema have static storage, so we can just reference them.
+	// Reference a copy of the others, because abbreviations may be cleared whilst our parameters still exist.
+	return (flag.isStatic) ? flag.longForm : StoreString(flag.longForm);
+}
+
+std::string_view ParseResult::MatchPrefix(std::string_view key)
+{
+	const Span<const std::string_view> matches = schema->GetKeyIndex().FindPrefixed(key);
+
+	// Unknown keys stay as they are. So do known ones, even if they are a prefix of others, like --verb of --verbose.
+	if ((matches.empty()) || (matches[0] == key))
+		return key;
+
+	if (matches.size() > 1)
+		throw HazelnuppAmbiguousKeyException(std::string(key), std::vector<std::string>(matches.begin(), matches.end()));
+
+	// Reference a copy, because keys may be cleared whilst our parameters still exist
+	return StoreString(matches[0]);
+}
+
+void ParseResult::RememberPrevious(std::string_view arg)
+{
+	// Only keys take values. Most args are none, and need no lookup.
+	previousKey = ((IsParameterDelimiter(arg)) && (arg.length() > 2)) ? arg : std::string_view();
+	previousTakesSingleValue = false;
+
+	return;
+}
+
+void ParseResult::RememberPreviousArity(bool takesSingleValue)
+{
+	previousKey = std::string_view();
+	previousTakesSingleValue = takesSingleValue;
+
+	return;
+}
+
+bool ParseResult::PreviousTakesSingleValue()
+{
+	// Look the key up on the first ask only, and remember its answer for the next ones
+	if (!previousKey.empty())
+	{
+		lookupBuffer.assign(previousKey.data(), previousKey.length());
+		previousTakesSingleValue = schema->TakesSingleValue(lookupBuffer);
+		previousKey = std::string_view();
+	}
+
+	return previousTakesSingleValue;
+}
+
+bool ParseResult::ExpandAbbreviation(std::string_view& arg)
+{
+	// Is arg an abbreviation of the static schema?
+	// Its long form has static storage, so we can just reference it.
+	bool isAbbreviation = false;
+	const std::size_t id = schema->staticSchema.Find(arg, isAbbreviation);
+	if ((id != Internal::StaticSchemaView::npos) && (isAbbreviation))
+	{
+		arg = schema->staticSchema.specs[id].key;
+		return true;
+	}
+
+	if (schema->parameterAbreviations.size() == 0)
+		return false;
+
+	// Is arg registered as an abbreviation?
+	lookupBuffer.assign(arg.data(), arg.length());
+	auto abbr = schema->parameterAbreviations.find(lookupBuffer);
+	if (abbr != schema->parameterAbreviations.end())
+	{
+		// Yes: replace arg with the long form.
+		// Reference a copy, because abbreviations may be cleared whilst our parameters still exist.
+		arg = StoreString(abbr->second);
+		return true;
+	}
+
+	return false;
+}
+
+bool ParseResult::HasParam(const std::string& key) const
+{
+	return FindParameter(key) != nullptr;
+}
+
+void ParseResult::LoadConfigFile(const std::string& path)
+{
+	configFiles.emplace_back(std::make_unique<Internal::ConfigFile>(path));
+	return;
+}
+
+void ParseResult::ClearConfigFiles()
+{
+	// Parameters of the last parse may reference them
+	ClearParameters();
+	configFiles.clear();
+
+	return;
+}
+
+void ParseResult::SetEnvironment(const char* const* environment)
+{
+	this->environment = environment;
+	return;
+}
+
+const char* const* ParseResult::GetEnvironment() const
+{
+	return environment;
+}
+
+Value* ParseResult::NewLazyValue(const std::string_view* values, const std::size_t numValues, const TypeRequirement& constraint, bool copyTokens)
+{
+	// Copying the views is cheap. The strings they reference are stored already.
+	if ((copyTokens) && (numValues > 0))
+	{
+		std::string_view* copy = (std::string_view*)arena.allocate(numValues * sizeof(std::string_view), alignof(std::string_view));
+		std::uninitialized_copy_n(values, numValues, copy);
+		values = copy;
+	}
+
+	Internal::LazySource* source = arena.New<Internal::LazySource>();
+	source->owner = this;
+	source->tokens = values;
+	source->numTokens = numValues;
+	source->constrainType = constraint.constrainType;
+	source->requiredType = constraint.requiredType;
+
+	// Keys of the static schema have static storage. Reference a copy of others, because constraints may be cleared whilst our parameters still exist.
+	// Only constrained values ever name their key.
+	source->key = ((constraint.isStatic) || (!constraint.constrainType)) ? constraint.key : StoreString(constraint.key);
+
+	return new (arena.allocate(sizeof(Value), alignof(Value))) Value(source);
+}
+
+Value* ParseResult::ConvertLazily(const Internal::LazySource& source)
+{
+	TypeRequirement requirement;
+	requirement.constrainType = source.constrainType;
+	requirement.requiredType = source.requiredType;
+	requirement.key = source.key;
+
+	// The arena is not thread-safe
+	std::lock_guard<std::mutex> lock(lazyMutex);
+
+	return ParseValue(source.tokens, source.numTokens, requirement);
+}
+
+void ParseResult::Validate() const
+{
+	// Accessing the type converts a value. Elements of lists are unconstrained, and can not fail.
+	for (std::size_t id = 0; id < numStaticSlots; id++)
+		if (staticParameters[id] != nullptr)
+			staticParameters[id]->GetValue()->GetDataType();
+
+	for (const auto& param : *parameters)
+		param.second->GetValue()->GetDataType();
+
+	return;
+}
+
+void ParseResult::SetLazyConversion(bool lazyConversion)
+{
+	this->lazyConversion = lazyConversion;
+	return;
+}
+
+bool ParseResult::GetLazyConversion() const
+{
+	return lazyConversion;
+}
+
+const Parameter* ParseResult::FindParameter(std::string_view key) const
+{
+	// Known to the static schema? Then look into its slot
+	bool isAbbreviation = false;
+	const std::size_t id = schema->staticSchema.Find(key, isAbbreviation);
+	if ((id != Internal::StaticSchemaView::npos) && (!isAbbreviation))
+		return (id < numStaticSlots) ? staticParameters[id] : nullptr;
+
+	const auto param = parameters->find(key);
+	if (param == parameters->end())
+		return nullptr;
+
+	return param->second;
+}
+
+Value* ParseResult::ParseValue(const std::string_view* values, const std::size_t numValues, const TypeRequirement& constraint)
+{
+	// This is the raw (unconverted) data type the user provided
+	DATA_TYPE rawInputType;
+
+	// Constraint values
+	const bool constrainType = constraint.constrainType;
+
+	// Void-type
+	if (numValues == 0)
+	{
+		rawInputType = DATA_TYPE::VOID;
+
+		// Is a list forced via a constraint? If yes, return an empty list
+		if ((constrainType) &&
+			(constraint.requiredType == DATA_TYPE::LIST))
+			return ParseList(values, 0);
+
+		// Is a string forced via a constraint? If yes, return an empty string
+		else if ((constrainType) &&
+			(constraint.requiredType == DATA_TYPE::STRING))
+			return NewStringValue(std::string_view());
+
+		// Is an int or float forced via constraint? If yes, throw an exception
+		else if ((constrainType) &&
+			((constraint.requiredType == DATA_TYPE::INT) ||
+			 (constraint.requiredType == DATA_TYPE::FLOAT)))
+			throw HazelnuppConstraintTypeMissmatch(
+				std::string(constraint.key),
+				constraint.requiredType,
+				rawInputType,
+				std::string(schema->FindDescription(constraint.key))
+			);
+
+		// Else, just return the void type
+		return arena.New<VoidValue>();
+	}
+
+	// Force void type by constraint
+	else if ((constrainType) &&
+		(constraint.requiredType == DATA_TYPE::VOID))
+	{
+		return arena.New<VoidValue>();
+	}
+
+	// List-type
+	else if (numValues > 1)
+	{
+		rawInputType = DATA_TYPE::LIST;
+
+		// Should the type be something other than list?
+		if ((constrainType) &&
+			(constraint.requiredType != DATA_TYPE::LIST))
+		{
+			throw HazelnuppConstraintTypeMissmatch(
+				std::string(constraint.key),
+				constraint.requiredType,
+				rawInputType,
+				std::string(schema->FindDescription(constraint.key))
+			);
+		}
+
+		return ParseList(values, numValues);
+	}
+
+	// Now we're only dealing with a single value
+	const std::string_view& val = values[0];
+
+	// Classify and convert it in one go
+	long long int intNum;
+	long double floatNum;
+	const DATA_TYPE lexedType = Internal::StringTools::LexNumber(val, intNum, floatNum);
+	
+	// String
+	if (lexedType == DATA_TYPE::STRING)
+	{
+		rawInputType = DATA_TYPE::STRING;
+
+		// Is the type not supposed to be a string?
+		// void and list are already sorted out
+		if ((constrainType) &&
+			(constraint.requiredType != DATA_TYPE::STRING))
+		{
+			// We can only force a list-value from here
+			if (constraint.requiredType == DATA_TYPE::LIST)
+				return ParseList(&val, 1);
+			// Else it is not possible to convert to a numeric
+			else
+				throw HazelnuppConstraintTypeMissmatch(
+					std::string(constraint.key),
+					constraint.requiredType,
+					rawInputType,
+					std::string(schema->FindDescription(constraint.key))
+				);
+		}
+
+		return NewStringValue(val);
+	}
+
+	// In this case we have a numeric value.
+	// We should still produce a string if requested
+	if ((constrainType) &&
+		(constraint.requiredType == DATA_TYPE::STRING))
+		return NewStringValue(val);
+
+	// Numeric
+	const bool isInt = lexedType == DATA_TYPE::INT;
+	rawInputType = lexedType;
+
+	// Is the type constrained?
+	// (only int and float left)
+	if (constrainType)
+	{
+		// Must it be an integer?
+		if (constraint.requiredType == DATA_TYPE::INT)
+			return arena.New<IntValue>(isInt ? intNum : (long long int)floatNum);
+		// Must it be a floating point?
+		else if (constraint.requiredType == DATA_TYPE::FLOAT)
+			return arena.New<FloatValue>(isInt ? (long double)intNum : floatNum);
+		// Else it must be a List
+		else
+			return ParseList(&val, 1);
+	}
+
+	// Type is not constrained
+	// Integer
+	if (isInt)
+		return arena.New<IntValue>(intNum);
+
+	// Double
+	return arena.New<FloatValue>(floatNum);
+}
+
+Value* ParseResult::ParseList(const std::string_view* values, const std::size_t numValues)
+{
+	// The first element decides which type the list is stored as
+	long long int intNum = 0;
+	long double floatNum = 0;
+	const DATA_TYPE elementType = (numValues > 0) ?
+		Internal::StringTools::LexNumber(values[0], intNum, floatNum) :
+		DATA_TYPE::VOID;
+
+	// Convert all other elements in one pass, as long as they share its type.
+	// Numbers go straight into their contiguous array, in bulk.
+	long long int* ints = nullptr;
+	long double* floats = nullptr;
+	bool isHomogeneous = true;
+	switch (elementType)
+	{
+	case DATA_TYPE::INT:
+		ints = (long long int*)arena.allocate(numValues * sizeof(long long int), alignof(long long int));
+		ints[0] = intNum;
+		isHomogeneous = Internal::StringTools::LexIntegers(values + 1, numValues - 1, ints + 1) == numValues - 1;
+		break;
+
+	case DATA_TYPE::FLOAT:
+		floats = (long double*)arena.allocate(numValues * sizeof(long double), alignof(long double));
+		floats[0] = floatNum;
+		isHomogeneous = Internal::StringTools::LexFloats(values + 1, numValues - 1, floats + 1) == numValues - 1;
+		break;
+
+	case DATA_TYPE::STRING:
+		for (std::size_t i = 1; (i < numValues) && (isHomogeneous); i++)
+			isHomogeneous = Internal::StringTools::LexNumber(values[i], intNum, floatNum) == DATA_TYPE::STRING;
+		break;
+
+	default:
+		break;
+	}
+
+	// Elements of differing types get built as values right away
+	if (!isHomogeneous)
+	{
+		Internal::ListStorage* storage = arena.New<Internal::ListStorage>();
+		storage->elements = NewElementVector(numValues);
+
+		ListValue* list = new (arena.allocate(sizeof(ListValue), alignof(ListValue))) ListValue(storage);
+		for (std::size_t i = 0; i < numValues; i++)
+			list->AddValueReference(ParseValue(values + i, 1, TypeRequirement()));
+
+		return list;
+	}
+
+	Internal::ListStorage* storage = arena.New<Internal::ListStorage>();
+	storage->elementType = elementType;
+	storage->size = numValues;
+
+	switch (elementType)
+	{
+	case DATA_TYPE::INT:
+		storage->ints = ints;
+		break;
+
+	case DATA_TYPE::FLOAT:
+		storage->floats = floats;
+		break;
+
+	case DATA_TYPE::STRING:
+	{
+		// Copying the views is cheap. The strings they reference are stored already, but streams drop the views.
+		std::string_view* strings = (std::string_view*)arena.allocate(numValues * sizeof(std::string_view), alignof(std::string_view));
+		std::uninitialized_copy_n(values, numValues, strings);
+		storage->strings = strings;
+		break;
+	}
+
+	default:
+		break;
+	}
+
+	// The elements as values get built on first access
+	storage->owner = this;
+
+	return new (arena.allocate(sizeof(ListValue), alignof(ListValue))) ListValue(storage);
+}
+
+std::vector<Value*>* ParseResult::NewListElements(const Internal::ListStorage& list)
+{
+	std::vector<Value*>* elements = NewElementVector(list.size);
+
+	switch (list.elementType)
+	{
+	case DATA_TYPE::INT:
+		for (std::size_t i = 0; i < list.size; i++)
+			elements->emplace_back(arena.New<IntValue>(list.ints[i]));
+		break;
+
+	case DATA_TYPE::FLOAT:
+		for (std::size_t i = 0; i < list.size; i++)
+			elements->emplace_back(arena.New<FloatValue>(list.floats[i]));
+		break;
+
+	case DATA_TYPE::STRING:
+		for (std::size_t i = 0; i < list.size; i++)
+			elements->emplace_back(NewStringValue(list.strings[i]));
+		break;
+
+	default:
+		break;
+	}
+
+	return elements;
+}
+
+std::vector<Value*>* ParseResult::NewElementVector(std::size_t capacity)
+{
+	if (numElementVectorsInUse == elementVectors.size())
+		elementVectors.emplace_back(std::make_unique<std::vector<Value*>>());
+
+	std::vector<Value*>* elements = elementVectors[numElementVectorsInUse++].get();
+	elements->clear();
+	elements->reserve(capacity);
+
+	return elements;
+}
+
+Value* ParseResult::NewStringValue(std::string_view str)
+{
+	StringValue* value = arena.New<StringValue>(str, false);
+
+	// Values in the arena are never destructed, so their std::string has to belong to us
+	value->stringCache.store((std::uintptr_t)this | Value::parseResultTag, std::memory_order_relaxed);
+
+	return value;
+}
+
+const std::string* ParseResult::NewCachedString(std::string_view str)
+{
+	std::lock_guard<std::mutex> lock(lazyMutex);
+
+	if (numCachedStringsInUse == cachedStrings.size())
+		cachedStrings.emplace_back(std::make_unique<std::string>());
+
+	std::string* cached = cachedStrings[numCachedStringsInUse++].get();
+	cached->assign(str.data(), str.length());
+
+	return cached;
+}
+
+void ParseResult::ApplyConstraints()
+{
+	// All occurrences are known now
+	FinishAccumulations();
+
+	// Fill in parameters not supplied from the other sources, in order of precedence
+	MergeEnvironment();
+	MergeConfigFiles();
+
+	// Enforce the static schema first.
+	// Enforce parameter incompatibility. This concerns the merged result, but not default values.
+	for (std::size_t id = 0; id < schema->staticSchema.numSpecs; id++)
+	{
+		const ParamSpec& spec = schema->staticSchema.specs[id];
+
+		if (staticParameters[id] != nullptr)
+			for (std::size_t i = 0; i < spec.numIncompatibleParameters; i++)
+				if (FindParameter(spec.incompatibleParameters[i]) != nullptr)
+					throw HazelnuppConstraintIncompatibleParameters(
+						std::string(spec.key),
+						std::string(spec.incompatibleParameters[i])
+					);
+	}
+
+	// Enforce the runtime constraints. These are compiled into bit masks over dense ids on registration,
+	// so each check is a pass over a few words, no matter how many constraints there are.
+	const std::size_t numWords = schema->requiredMask.size();
+
+	// Enforce parameter incompatibility.
+	// Is ANY parameter present listed as incompatible with another one present?
+	// This concerns the merged result. Default values never conflict.
+	for (std::size_t word = 0; word < numWords; word++)
+	{
+		std::uint64_t candidates = schema->incompatibleMask[word] & GetPresentWord(word);
+		while (candidates != 0)
+		{
+			const std::size_t id = word * 64 + CountTrailingZeros(candidates);
+			candidates &= candidates - 1;
+
+			const std::vector<std::uint64_t>& incompatibilities = schema->incompatibilityMasks[id];
+			for (std::size_t i = 0; i < incompatibilities.size(); i++)
+				if (incompatibilities[i] & GetPresentWord(i))
+				{
+					// Find out which one it was, to tell the user
+					const ParamConstraint& pc = *schema->constraintsById[id];
+					for (const std::string& incompatibility : pc.incompatibleParameters)
+						if (FindParameter(incompatibility) != nullptr)
+							throw HazelnuppConstraintIncompatibleParameters(pc.key, incompatibility);
+				}
+		}
+	}
+
+	// Create parameters of the static schema not supplied by their default value
+	for (std::size_t id = 0; id < schema->staticSchema.numSpecs; id++)
+	{
+		const ParamSpec& spec = schema->staticSchema.specs[id];
+
+		// Parameter in question is supplied
+		if (staticParameters[id] != nullptr)
+			continue;
+
+		// It has static storage, so we can just reference it.
+		if (spec.numDefaultValues > 0)
+		{
+			staticParameters[id] = NewParameter(
+				spec.key,
+				ParseValue(spec.defaultValue, spec.numDefaultValues, spec),
+				PARAM_SOURCE::DEFAULT_VALUE
+			);
+
+			if constexpr (g_instrumentationEnabled)
+				numValuesCreated++;
+		}
+
+		// Is it important to have the missing parameter?
+		else if (spec.required)
+			throw HazelnuppConstraintMissingValue(
+				std::string(spec.key),
+				std::string(spec.description)
+			);
+	}
+
+	// Enforce required parameters.
+	// Those with a default value are not in this mask.
+	for (std::size_t word = 0; word < numWords; word++)
+	{
+		const std::uint64_t missing = schema->requiredMask[word] & ~GetPresentWord(word);
+		if (missing != 0)
+		{
+			const ParamConstraint& pc = *schema->constraintsById[word * 64 + CountTrailingZeros(missing)];
+
+			// Throw an error message then
+			throw HazelnuppConstraintMissingValue(
+				pc.key,
+				schema->GetDescription(pc.key)
+			);
+		}
+	}
+
+	// Create parameters not supplied by their default value
+	for (std::size_t word = 0; word < numWords; word++)
+	{
+		std::uint64_t missing = schema->defaultMask[word] & ~GetPresentWord(word);
+		while (missing != 0)
+		{
+			const std::size_t id = word * 64 + CountTrailingZeros(missing);
+			missing &= missing - 1;
+
+			const ParamConstraint& pc = *schema->constraintsById[id];
+
+			// Reference copies, because the constraint may be cleared whilst our parameter still exists.
+			std::pmr::vector<std::string_view> defaultValue(&arena);
+			defaultValue.reserve(pc.defaultValue.size());
+			for (const std::string& s : pc.defaultValue)
+				defaultValue.emplace_back(StoreString(s));
+
+			Parameter* param = NewParameter(
+				StoreString(pc.key),
+				ParseValue(defaultValue.data(), defaultValue.size(), pc),
+				PARAM_SOURCE::DEFAULT_VALUE
+			);
+			StoreParameter(param, id);
+
+			if constexpr (g_instrumentationEnabled)
+				numValuesCreated++;
+		}
+	}
+
+	return;
+}
+
+void ParseResult::MergeParameter(std::string_view key, const std::string_view* values, const std::size_t numValues, PARAM_SOURCE source, std::string_view origin)
+{
+	// Is it known to the static schema? Then it goes into its slot. No map involved.
+	bool isAbbreviation = false;
+	const std::size_t id = schema->staticSchema.Find(key, isAbbreviation);
+	if ((id != Internal::StaticSchemaView::npos) && (!isAbbreviation))
+	{
+		if (staticParameters[id] == nullptr)
+			StoreStaticParameter(NewParameter(key, ParseValue(values, numValues, schema->staticSchema.specs[id]), source, origin), id);
+
+		return;
+	}
+
+	if (parameters->find(key) != parameters->end())
+		return;
+
+	// Fetch constraint info
+	lookupBuffer.assign(key.data(), key.length());
+	const ParamConstraint* pcn = schema->GetConstraintForKey(lookupBuffer);
+
+	// Unconstrained keys may still have a dense id, if others list them as incompatible
+	std::size_t denseId = Schema::npos;
+	if (pcn != nullptr)
+		denseId = pcn->id;
+	else if (!schema->unconstrainedIds.empty())
+		denseId = schema->FindId(lookupBuffer);
+
+	Value* parsedVal = ParseValue(values, numValues, (pcn != nullptr) ? TypeRequirement(*pcn) : TypeRequirement());
+	StoreParameter(NewParameter(key, parsedVal, source, origin), denseId);
+
+	if constexpr (g_instrumentationEnabled)
+		numValuesCreated++;
+
+	return;
+}
+
+void ParseResult::MergeEnvironment()
+{
+	// Parameters of the static schema. These have static storage, so we can just reference them.
+	for (std::size_t id = 0; id < schema->staticSchema.numSpecs; id++)
+	{
+		const ParamSpec& spec = schema->staticSchema.specs[id];
+
+		if ((staticParameters[id] == nullptr) && (spec.environmentVariable.length() > 0))
+		{
+			Value* value = ParseEnvironmentVariable(spec.environmentVariable, spec);
+			if (value != nullptr)
+				StoreStaticParameter(NewParameter(spec.key, value, PARAM_SOURCE::ENVIRONMENT, spec.environmentVariable), id);
+		}
+	}
+
+	// Registered ones. Keys known to the static schema have been dealt with above.
+	for (const auto& binding : schema->environmentVariables)
+	{
+		bool isAbbreviation = false;
+		if ((schema->staticSchema.Find(binding.first, isAbbreviation) != Internal::StaticSchemaView::npos) && (!isAbbreviation))
+			continue;
+
+		if (FindParameter(binding.first) != nullptr)
+			continue;
+
+		const ParamConstraint* pcn = schema->GetConstraintForKey(binding.first);
+		Value* value = ParseEnvironmentVariable(binding.second, (pcn != nullptr) ? TypeRequirement(*pcn) : TypeRequirement());
+		if (value == nullptr)
+			continue;
+
+		// Reference copies, because the binding may be cleared whilst our parameter still exists.
+		Parameter* param = NewParameter(StoreString(binding.first), value, PARAM_SOURCE::ENVIRONMENT, StoreString(binding.second));
+		StoreParameter(param, (pcn != nullptr) ? pcn->id : schema->FindId(binding.first));
+	}
+
+	return;
+}
+
+void ParseResult::MergeConfigFiles()
+{
+	// The file loaded last goes first, so that it takes precedence
+	for (std::size_t i = configFiles.size(); i > 0; i--)
+	{
+		const Internal::ConfigFile& file = *configFiles[i - 1];
+
+		for (const Internal::ConfigFile::Entry& entry : file.GetEntries())
+			MergeParameter(entry.key, entry.values, entry.numValues, PARAM_SOURCE::CONFIG_FILE, file.GetPath());
+	}
+
+	return;
+}
+
+Value* ParseResult::ParseEnvironmentVariable(std::string_view variable, const TypeRequirement& constraint)
+{
+	const std::pmr::unordered_map<std::string_view, std::string_view>& snapshot = GetEnvironmentSnapshot();
+
+	const auto entry = snapshot.find(variable);
+	if (entry == snapshot.end())
+		return nullptr;
+
+	// Reference a copy, because the environment may change whilst our parameter still exists
+	const std::string_view value = StoreString(entry->second);
+
+	// Lists get split at whitespace. Anything else is one value, unless it is empty.
+	std::pmr::vector<std::string_view> tokens(&arena);
+	if ((constraint.constrainType) && (constraint.requiredType == DATA_TYPE::LIST))
+	{
+		std::size_t begin = 0;
+		while (begin < value.length())
+		{
+			if (IsWhitespace(value[begin]))
+			{
+				begin++;
+				continue;
+			}
+
+			std::size_t end = begin;
+			while ((end < value.length()) && (!IsWhitespace(value[end])))
+				end++;
+
+			tokens.emplace_back(value.substr(begin, end - begin));
+			begin = end;
+		}
+	}
+	else if (value.length() > 0)
+		tokens.emplace_back(value);
+
+	if constexpr (g_instrumentationEnabled)
+		numValuesCreated++;
+
+	return ParseValue(tokens.data(), tokens.size(), constraint);
+}
+
+const std::pmr::unordered_map<std::string_view, std::string_view>& ParseResult::GetEnvironmentSnapshot()
+{
+	if (environmentSnapshot != nullptr)
+		return *environmentSnapshot;
+
+	const char* const* variables = (environment != nullptr) ? environment : HAZELNUPP_ENVIRON;
+
+	std::size_t numVariables = 0;
+	if (variables != nullptr)
+		while (variables[numVariables] != nullptr)
+			numVariables++;
+
+	environmentSnapshot = arena.New<std::pmr::unordered_map<std::string_view, std::string_view>>(&arena);
+	environmentSnapshot->reserve(numVariables);
+
+	// Entries look like NAME=value. On Windows, names may begin with '=' aswell.
+	for (std::size_t i = 0; i < numVariables; i++)
+	{
+		const std::string_view entry = variables[i];
+		const std::size_t equals = entry.find('=', 1);
+		if (equals == std::string_view::npos)
+			continue;
+
+		// Keep the first occurrence, just like getenv()
+		environmentSnapshot->emplace(entry.substr(0, equals), entry.substr(equals + 1));
+	}
+
+	return *environmentSnapshot;
+}
+
+const std::string& ParseResult::GetExecutableName() const
+{
+	return executableName;
+}
+
+const Value& ParseResult::operator[](const std::string& key) const
+{
+	// Throw exception if param is unknown
+	const Parameter* param = FindParameter(key);
+	if (param == nullptr)
+		throw HazelnuppInvalidKeyException();
+
+	return *param->GetValue();
+}
+
+PARAM_SOURCE ParseResult::GetSource(const std::string& key) const
+{
+	const Parameter* param = FindParameter(key);
+	if (param == nullptr)
+		throw HazelnuppInvalidKeyException();
+
+	return param->GetSource();
+}
+
+std::string_view ParseResult::GetOrigin(const std::string& key) const
+{
+	const Parameter* param = FindParameter(key);
+	if (param == nullptr)
+		throw HazelnuppInvalidKeyException();
+
+	return param->GetOrigin();
+}
+
+void ParseResult::SetBorrowArgv(bool borrowArgv)
+{
+	this->borrowArgv = borrowArgv;
+	return;
+}
+
+bool ParseResult::GetBorrowArgv() const
+{
+	return borrowArgv;
+}
+
+void ParseResult::SetExpandResponseFiles(bool expandResponseFiles)
+{
+	this->expandResponseFiles = expandResponseFiles;
+	return;
+}
+
+bool ParseResult::GetExpandResponseFiles() const
+{
+	return expandResponseFiles;
+}
+
+void ParseResult::SetMaxResponseFileDepth(std::size_t maxResponseFileDepth)
+{
+	this->maxResponseFileDepth = maxResponseFileDepth;
+	return;
+}
+
+std::size_t ParseResult::GetMaxResponseFileDepth() const
+{
+	return maxResponseFileDepth;
+}
+
+const Schema& ParseResult::GetSchema() const
+{
+	return *schema;
+}
@@ -0,0 +1,118 @@
+#include "Hazelnupp/ResponseFile.h"
+#include "Hazelnupp/HazelnuppException.h"
+
+using namespace Hazelnp;
+
+namespace
+{
+	bool IsWhitespace(char c)
+	{
+		return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') || (c == '\v') || (c == '\f');
+	}
+}
+
+Internal::ResponseFile::ResponseFile(const std::string& path)
+	:
+	path { path }
+{
+	if (const char* error = file.Map(path))
+		throw HazelnuppResponseFileException(path, error);
+
+	data = file.Data();
+	size = file.Size();
+
+	return;
+}
+
+bool Internal::ResponseFile::NextToken(std::string_view& out_token, bool& out_isQuoted)
+{
+	// Skip whitespace and comments
+	while (cursor < size)
+	{
+		if (IsWhitespace(data[cursor]))
+			cursor++;
+
+		else if (data[cursor] == '#')
+			while ((cursor < size) && (data[cursor] != '\n'))
+				cursor++;
+
+		else
+			break;
+	}
+
+	if (cursor >= size)
+		return false;
+
+	// Unescape in place. The unescaped token is never longer than the raw one, so writing trails reading.
+	// As long as nothing got dropped yet, both are the same, and nothing has to be written at all.
+	const std::size_t begin = cursor;
+	std::size_t write = cursor;
+	char quote = 0;
+	out_isQuoted = false;
+
+	auto Put = [&](std::size_t read)
+	{
+		if (write != read)
+			data[write] = data[read];
+		write++;
+		return;
+	};
+
+	while (cursor < size)
+	{
+		const char c = data[cursor];
+
+		// Outside of quotes
+		if (quote == 0)
+		{
+			if (IsWhitespace(c))
+				break;
+
+			else if ((c == '"') || (c == '\''))
+			{
+				quote = c;
+				out_isQuoted = true;
+				cursor++;
+			}
+
+			else if ((c == '\\') && (cursor + 1 < size))
+			{
+				out_isQuoted = true;
+				Put(cursor + 1);
+				cursor += 2;
+			}
+
+			else
+				Put(cursor++);
+		}
+
+		// Closing quote
+		else if (c == quote)
+		{
+			quote = 0;
+			cursor++;
+		}
+
+		// Escape within double quotes
+		else if ((quote == '"') && (c == '\\') && (cursor + 1 < size))
+		{
+			Put(cursor + 1);
+			cursor += 2;
+		}
+
+		else
+			Put(cursor++);
+	}
+
+	if (quote != 0)
+		throw HazelnuppResponseFileException(path, std::string("Unterminated ") + quote + " quote.");
+
+	out_token = std::string_view(data + begin, write - begin);
+
+	return true;
+}
+
+const std::string& Internal::ResponseFile::GetPath() const
+{
+	return path;
+}
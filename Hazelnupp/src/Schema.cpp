@@ -0,0 +1,930 @@
+#include "Hazelnupp/Schema.h"
+#include "Hazelnupp/HazelnuppException.h"
+#include "Hazelnupp/Placeholders.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+using namespace Hazelnp;
+
+namespace
+{
+	// Will append text to out, wrapped at spaces to lines of at most width characters, if possible.
+	// Wrapped lines get indented by indent spaces. A width of 0 does not wrap at all.
+	void AppendWrapped(std::string& out, std::string_view text, std::size_t width, std::size_t indent)
+	{
+		if (width == 0)
+		{
+			out += text;
+			return;
+		}
+
+		// Line breaks in the text itself start over
+		const std::size_t lineBreak = text.find('\n');
+		if (lineBreak != std::string_view::npos)
+		{
+			AppendWrapped(out, text.substr(0, lineBreak), width, indent);
+			out += '\n';
+			AppendWrapped(out, text.substr(lineBreak + 1), width, indent);
+			return;
+		}
+
+		std::size_t lineLength = 0;
+		std::size_t pos = 0;
+		while (pos < text.length())
+		{
+			const std::size_t wordBegin = text.find_first_not_of(' ', pos);
+
+			// Trailing spaces are dropped
+			if (wordBegin == std::string_view::npos)
+				break;
+
+			std::size_t wordEnd = text.find(' ', wordBegin);
+			if (wordEnd == std::string_view::npos)
+				wordEnd = text.length();
+
+			const std::size_t numSpaces = wordBegin - pos;
+			const std::size_t wordLength = wordEnd - wordBegin;
+
+			// Words too long for any line get one of their own
+			if ((lineLength > indent) && (lineLength + numSpaces + wordLength > width))
+			{
+				out += '\n';
+				out.append(indent, ' ');
+				lineLength = indent;
+			}
+			else
+			{
+				out.append(numSpaces, ' ');
+				lineLength += numSpaces;
+			}
+
+			out += text.substr(wordBegin, wordLength);
+			lineLength += wordLength;
+			pos = wordEnd;
+		}
+
+		return;
+	}
+
+	// Will write all of data to fd, even if it takes multiple calls
+	bool WriteAll(int fd, const char* data, std::size_t length)
+	{
+		while (length > 0)
+		{
+#ifdef _WIN32
+			const int written = _write(fd, data, (unsigned int)length);
+#else
+			const ssize_t written = write(fd, data, length);
+			if ((written < 0) && (errno == EINTR))
+				continue;
+#endif
+			if (written <= 0)
+				return false;
+
+			data += written;
+			length -= (std::size_t)written;
+		}
+
+		return true;
+	}
+}
+
+Schema::Schema()
+{
+	return;
+}
+
+void Schema::RegisterAbbreviation(const std::string& abbrev, const std::string& target)
+{
+	BeginChange();
+
+	if (!parameterAbreviations.insert(std::pair<std::string, std::string>(abbrev, target)).second)
+		return;
+
+	if (IsShortFlag(abbrev))
+		UpdateShortFlag((unsigned char)abbrev[1]);
+	else
+		numLongAbbreviations++;
+
+	return;
+}
+
+const std::string& Schema::GetAbbreviation(const std::string& abbrev) const
+{
+	const auto abbreviation = parameterAbreviations.find(abbrev);
+	if (abbreviation == parameterAbreviations.end())
+		return Placeholders::g_emptyString;
+
+	return abbreviation->second;
+}
+
+bool Schema::HasAbbreviation(const std::string& abbrev) const
+{
+	return parameterAbreviations.find(abbrev) != parameterAbreviations.end();
+}
+
+void Schema::ClearAbbreviation(const std::string& abbrevation)
+{
+	BeginChange();
+
+	if (parameterAbreviations.erase(abbrevation) == 0)
+		return;
+
+	if (IsShortFlag(abbrevation))
+		UpdateShortFlag((unsigned char)abbrevation[1]);
+	else
+		numLongAbbreviations--;
+
+	return;
+}
+
+void Schema::ClearAbbreviations()
+{
+	BeginChange();
+
+	parameterAbreviations.clear();
+	UpdateShortFlags();
+
+	return;
+}
+
+void Schema::RegisterEnvironmentVariable(const std::string& key, const std::string& variable)
+{
+	BeginChange();
+
+	environmentVariables[key] = variable;
+	return;
+}
+
+const std::string& Schema::GetEnvironmentVariable(const std::string& key) const
+{
+	const auto variable = environmentVariables.find(key);
+	if (variable == environmentVariables.end())
+		return Placeholders::g_emptyString;
+
+	return variable->second;
+}
+
+bool Schema::HasEnvironmentVariable(const std::string& key) const
+{
+	return environmentVariables.find(key) != environmentVariables.end();
+}
+
+void Schema::ClearEnvironmentVariable(const std::string& key)
+{
+	BeginChange();
+
+	environmentVariables.erase(key);
+	return;
+}
+
+void Schema::ClearEnvironmentVariables()
+{
+	BeginChange();
+
+	environmentVariables.clear();
+	return;
+}
+
+void Schema::RegisterConstraint(const std::string& key, const ParamConstraint& constraint)
+{
+	BeginChange();
+
+	// Handles issued for this key must stay valid, so it keeps its id
+	const std::size_t id = AssignId(key);
+	unconstrainedIds.erase(key);
+
+	ParamConstraint& registered = parameterConstraints[key];
+
+	// Magic syntax, wooo
+	(registered = constraint).key = key;
+	registered.id = id;
+
+	constraintsById[id] = &registered;
+	CompileConstraint(id);
+
+	// Whether its abbreviations take values may have changed
+	UpdateShortFlagsOf(key);
+
+	return;
+}
+
+ParamConstraint Schema::GetConstraint(const std::string& parameter) const
+{
+	return parameterConstraints.find(parameter)->second;
+}
+
+void Schema::ClearConstraint(const std::string& parameter)
+{
+	BeginChange();
+
+	const auto constraint = parameterConstraints.find(parameter);
+	if (constraint != parameterConstraints.end())
+	{
+		UnregisterConstraint(constraint);
+		UpdateShortFlagsOf(parameter);
+	}
+
+	return;
+}
+
+void Schema::ClearConstraints()
+{
+	BeginChange();
+
+	while (!parameterConstraints.empty())
+		UnregisterConstraint(parameterConstraints.begin());
+
+	UpdateShortFlags();
+
+	return;
+}
+
+void Schema::UnregisterConstraint(const std::unordered_map<std::string, ParamConstraint>::iterator& constraint)
+{
+	const std::size_t id = constraint->second.id;
+
+	unconstrainedIds[constraint->first] = id;
+	parameterConstraints.erase(constraint);
+
+	constraintsById[id] = nullptr;
+	CompileConstraint(id);
+
+	return;
+}
+
+std::size_t Schema::AssignId(const std::string& key)
+{
+	const std::size_t id = FindId(key);
+	if (id != npos)
+		return id;
+
+	// Issue a new one, and make room for it in all masks
+	unconstrainedIds[key] = numIds;
+	numIds++;
+
+	const std::size_t numWords = (numIds + 63) / 64;
+	requiredMask.resize(numWords, 0);
+	defaultMask.resize(numWords, 0);
+	incompatibleMask.resize(numWords, 0);
+	constraintsById.push_back(nullptr);
+	incompatibilityMasks.emplace_back();
+
+	return numIds - 1;
+}
+
+std::size_t Schema::FindId(const std::string& key) const
+{
+	const auto constraint = parameterConstraints.find(key);
+	if (constraint != parameterConstraints.end())
+		return constraint->second.id;
+
+	const auto unconstrained = unconstrainedIds.find(key);
+	if (unconstrained != unconstrainedIds.end())
+		return unconstrained->second;
+
+	return npos;
+}
+
+void Schema::CompileConstraint(const std::size_t id)
+{
+	const ParamConstraint* constraint = constraintsById[id];
+	const std::size_t word = id / 64;
+	const std::uint64_t bit = (std::uint64_t)1 << (id % 64);
+
+	requiredMask[word] &= ~bit;
+	defaultMask[word] &= ~bit;
+	incompatibleMask[word] &= ~bit;
+
+	std::vector<std::uint64_t> incompatibilities;
+
+	if (constraint != nullptr)
+	{
+		// A default value satisfies the requirement
+		if (constraint->defaultValue.size() > 0)
+			defaultMask[word] |= bit;
+		else if (constraint->required)
+			requiredMask[word] |= bit;
+
+		// Incompatible keys get ids aswell, constrained or not
+		for (const std::string& incompatibility : constraint->incompatibleParameters)
+		{
+			const std::size_t other = AssignId(incompatibility);
+			if (incompatibilities.size() <= other / 64)
+				incompatibilities.resize(other / 64 + 1, 0);
+
+			incompatibilities[other / 64] |= (std::uint64_t)1 << (other % 64);
+		}
+
+		if (!incompatibilities.empty())
+			incompatibleMask[word] |= bit;
+	}
+
+	incompatibilityMasks[id] = std::move(incompatibilities);
+
+	return;
+}
+
+const ParamConstraint* Schema::GetConstraintForKey(const std::string& key) const
+{
+	const auto constraint = parameterConstraints.find(key);
+
+	if (constraint == parameterConstraints.end())
+		return nullptr;
+
+	return &constraint->second;
+}
+
+std::size_t Schema::AcquireHandle(const std::string& key, DATA_TYPE type) const
+{
+	const std::string typeError = "Parameter " + key + " is not constrained to type " + DataTypeToString(type) + "! Unable to create a handle.";
+
+	// Known to the static schema? Then the handle is just its id
+	bool isAbbreviation = false;
+	const std::size_t id = staticSchema.Find(key, isAbbreviation);
+	if ((id != Internal::StaticSchemaView::npos) && (!isAbbreviation))
+	{
+		const ParamSpec& spec = staticSchema.specs[id];
+		if ((!spec.constrainType) || (spec.requiredType != type))
+			throw HazelnuppException(typeError);
+
+		return id | staticHandleFlag;
+	}
+
+	auto constraint = parameterConstraints.find(key);
+	if ((constraint == parameterConstraints.end()) ||
+		(!constraint->second.constrainType) ||
+		(constraint->second.requiredType != type))
+		throw HazelnuppException(typeError);
+
+	// Every constrained parameter has a slot in the parse results already
+	return constraint->second.id;
+}
+
+void Schema::ClearStaticSchema()
+{
+	BeginChange();
+
+	staticSchema = Internal::StaticSchemaView();
+	UpdateShortFlags();
+
+	return;
+}
+
+bool Schema::HasStaticSchema() const
+{
+	return staticSchema.numSpecs > 0;
+}
+
+void Schema::SetBriefDescription(const std::string& description)
+{
+	BeginChange();
+
+	briefDescription = description;
+	return;
+}
+
+const std::string& Schema::GetBriefDescription() const
+{
+	return briefDescription;
+}
+
+void Schema::RegisterDescription(const std::string& parameter, const std::string& description)
+{
+	BeginChange();
+
+	parameterDescriptions[parameter] = description;
+	return;
+}
+
+const std::string& Schema::GetDescription(const std::string& parameter) const
+{
+	// Do we already have a description for this parameter?
+	const auto description = parameterDescriptions.find(parameter);
+	if (description == parameterDescriptions.end())
+		// No? Then return ""
+		return Placeholders::g_emptyString;
+
+	// We do? Then return it
+	return description->second;
+}
+
+std::string_view Schema::FindDescription(std::string_view key) const
+{
+	bool isAbbreviation = false;
+	const std::size_t id = staticSchema.Find(key, isAbbreviation);
+	if ((id != Internal::StaticSchemaView::npos) && (!isAbbreviation))
+		return staticSchema.specs[id].description;
+
+	return GetDescription(std::string(key));
+}
+
+bool Schema::HasDescription(const std::string& parameter) const
+{
+	return parameterDescriptions.find(parameter) != parameterDescriptions.end();
+}
+
+void Schema::ClearDescription(const std::string& parameter)
+{
+	BeginChange();
+
+	// This will just do nothing if the entry does not exist
+	parameterDescriptions.erase(parameter);
+	return;
+}
+
+void Schema::ClearDescriptions()
+{
+	BeginChange();
+
+	parameterDescriptions.clear();
+	return;
+}
+
+void Schema::SetMatchUniquePrefixes(bool matchUniquePrefixes)
+{
+	BeginChange();
+
+	this->matchUniquePrefixes = matchUniquePrefixes;
+	return;
+}
+
+bool Schema::GetMatchUniquePrefixes() const
+{
+	return matchUniquePrefixes;
+}
+
+const Internal::KeyIndex& Schema::GetKeyIndex() const
+{
+	// Frozen schemas got indexed on Freeze(), so this never writes to a schema shared between threads
+	if (keyIndexIsValid)
+		return keyIndex;
+
+	std::vector<std::string_view> keys;
+	keys.reserve(staticSchema.numSpecs + parameterDescriptions.size() + parameterAbreviations.size() + parameterConstraints.size() + environmentVariables.size());
+
+	for (std::size_t id = 0; id < staticSchema.numSpecs; id++)
+		keys.push_back(staticSchema.specs[id].key);
+
+	for (const auto& it : parameterDescriptions)
+		keys.push_back(it.first);
+
+	for (const auto& it : parameterAbreviations)
+		keys.push_back(it.second);
+
+	for (const auto& it : parameterConstraints)
+		keys.push_back(it.first);
+
+	for (const auto& it : environmentVariables)
+		keys.push_back(it.first);
+
+	keyIndex.Build(std::move(keys));
+	keyIndexIsValid = true;
+
+	return keyIndex;
+}
+
+void Schema::SetDocumentationWidth(std::size_t documentationWidth)
+{
+	BeginChange();
+
+	this->documentationWidth = documentationWidth;
+	return;
+}
+
+std::size_t Schema::GetDocumentationWidth() const
+{
+	return documentationWidth;
+}
+
+const std::string& Schema::GenerateDocumentation() const
+{
+	// Frozen schemas got rendered on Freeze(), so this never writes to a schema shared between threads
+	if (!documentationIsValid)
+		RenderDocumentation();
+
+	return documentation;
+}
+
+std::string Schema::GenerateParameterDocumentation(const std::string& key) const
+{
+	// Resolve abbreviations
+	std::string longForm = key;
+
+	bool isAbbreviation = false;
+	const std::size_t id = staticSchema.Find(key, isAbbreviation);
+	if ((id != Internal::StaticSchemaView::npos) && (isAbbreviation))
+		longForm = staticSchema.specs[id].key;
+
+	const auto abbreviation = parameterAbreviations.find(key);
+	if (abbreviation != parameterAbreviations.end())
+		longForm = abbreviation->second;
+
+	std::string out;
+	AppendParameterDocumentation(out, longForm, FindAbbreviationOf(longForm));
+
+	return out;
+}
+
+bool Schema::WriteDocumentation(int fd) const
+{
+	const std::string& text = GenerateDocumentation();
+
+	return WriteAll(fd, text.data(), text.length()) && WriteAll(fd, "\n", 1);
+}
+
+void Schema::RenderDocumentation() const
+{
+	std::chrono::steady_clock::time_point begin;
+	if constexpr (g_instrumentationEnabled)
+		begin = std::chrono::steady_clock::now();
+
+	documentation.clear();
+
+	// Add brief, if available
+	if (briefDescription.length() > 0)
+	{
+		AppendWrapped(documentation, briefDescription, documentationWidth, 0);
+		documentation += '\n';
+	}
+
+	// Collect every key anything is known about, sorted, to get the same document every time
+	std::vector<std::string> keys;
+	keys.reserve(staticSchema.numSpecs + parameterDescriptions.size() + parameterAbreviations.size() + parameterConstraints.size() + environmentVariables.size());
+
+	for (std::size_t id = 0; id < staticSchema.numSpecs; id++)
+		keys.emplace_back(staticSchema.specs[id].key);
+
+	for (const auto& it : parameterDescriptions)
+		keys.push_back(it.first);
+
+	// first value is abbreviation, second is long form
+	std::unordered_map<std::string_view, std::string_view> abbreviations;
+	for (const auto& it : parameterAbreviations)
+	{
+		keys.push_back(it.second);
+
+		// Take the first one in sorted order, if there are multiple
+		std::string_view& abbreviation = abbreviations[it.second];
+		if ((abbreviation.empty()) || (std::string_view(it.first) < abbreviation))
+			abbreviation = it.first;
+	}
+
+	for (const auto& it : parameterConstraints)
+		keys.push_back(it.first);
+
+	for (const auto& it : environmentVariables)
+		keys.push_back(it.first);
+
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+	// Now generate the documentation body
+	if (keys.size() > 0)
+	{
+		documentation += "\n==== AVAILABLE PARAMETERS ====\n\n";
+
+		for (std::size_t i = 0; i < keys.size(); i++)
+		{
+			std::string_view abbreviation;
+			const auto registered = abbreviations.find(keys[i]);
+			if (registered != abbreviations.end())
+				abbreviation = registered->second;
+			else
+				abbreviation = FindAbbreviationOf(keys[i]);
+
+			AppendParameterDocumentation(documentation, keys[i], abbreviation);
+
+			// Omit linebreaks when we're on the last element
+			if (i + 1 < keys.size())
+				documentation += "\n\n";
+		}
+	}
+
+	documentationIsValid = true;
+
+	if constexpr (g_instrumentationEnabled)
+		if (instrumentationSink != nullptr)
+		{
+			PhaseStats stats;
+			stats.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+			stats.numValues = keys.size();
+			instrumentationSink->OnRenderDocumentation(stats);
+		}
+
+	return;
+}
+
+void Schema::SetInstrumentationSink(InstrumentationSink* sink)
+{
+	BeginChange();
+
+	instrumentationSink = sink;
+	return;
+}
+
+InstrumentationSink* Schema::GetInstrumentationSink() const
+{
+	return instrumentationSink;
+}
+
+bool Schema::AppendParameterDocumentation(std::string& out, const std::string& key, std::string_view abbreviation) const
+{
+	std::string_view description;
+	DATA_TYPE type = DATA_TYPE::VOID;
+	bool required = false;
+	bool typeIsForced = false;
+	std::string defaultVal;
+	std::string incompatibilities;
+	std::string_view environmentVariable;
+	REPEAT_POLICY repeatPolicy = REPEAT_POLICY::KEEP_FIRST;
+	bool isKnown = !abbreviation.empty();
+
+	// Collect the static schema
+	bool isAbbreviation = false;
+	const std::size_t id = staticSchema.Find(key, isAbbreviation);
+	if ((id != Internal::StaticSchemaView::npos) && (!isAbbreviation))
+	{
+		const ParamSpec& spec = staticSchema.specs[id];
+		description = spec.description;
+		environmentVariable = spec.environmentVariable;
+		required = spec.required;
+		typeIsForced = spec.constrainType;
+		type = spec.requiredType;
+		repeatPolicy = spec.repeatPolicy;
+
+		// Build default-value string
+		for (std::size_t i = 0; i < spec.numDefaultValues; i++)
+		{
+			// Add a space if we are not at the first entry
+			if (i > 0)
+				defaultVal += ' ';
+
+			((defaultVal += '\'') += spec.defaultValue[i]) += '\'';
+		}
+
+		// Build incompatibilities string
+		for (std::size_t i = 0; i < spec.numIncompatibleParameters; i++)
+		{
+			// Add a comma-space if we are not at the first entry
+			if (i > 0)
+				incompatibilities += ", ";
+
+			incompatibilities += spec.incompatibleParameters[i];
+		}
+
+		isKnown = true;
+	}
+
+	// Collect the description
+	const auto registeredDescription = parameterDescriptions.find(key);
+	if (registeredDescription != parameterDescriptions.end())
+	{
+		description = registeredDescription->second;
+		isKnown = true;
+	}
+
+	// Collect the environment variable
+	const auto registeredVariable = environmentVariables.find(key);
+	if (registeredVariable != environmentVariables.end())
+	{
+		environmentVariable = registeredVariable->second;
+		isKnown = true;
+	}
+
+	// Collect the constraint
+	const ParamConstraint* constraint = GetConstraintForKey(key);
+	if (constraint != nullptr)
+	{
+		required = constraint->required;
+		typeIsForced = constraint->constrainType;
+		type = constraint->requiredType;
+		repeatPolicy = constraint->repeatPolicy;
+
+		// Build default-value string
+		defaultVal.clear();
+		for (const std::string& s : constraint->defaultValue)
+		{
+			// Add a space if we are not at the first entry
+			if (!defaultVal.empty())
+				defaultVal += ' ';
+
+			((defaultVal += '\'') += s) += '\'';
+		}
+
+		// Build incompatibilities string
+		incompatibilities.clear();
+		for (const std::string& s : constraint->incompatibleParameters)
+		{
+			// Add a comma-space if we are not at the first entry
+			if (!incompatibilities.empty())
+				incompatibilities += ", ";
+
+			incompatibilities += s;
+		}
+
+		isKnown = true;
+	}
+
+	if (!isKnown)
+		return false;
+
+	// Put name
+	std::string line = key + "   ";
+
+	// Put abbreviation
+	if (abbreviation.length() > 0)
+		(line += abbreviation) += "   ";
+
+	// Put type
+	if (typeIsForced)
+		(line += DataTypeToString(type)) += "   ";
+
+	// Put default value
+	if (defaultVal.length() > 0)
+		((line += "default=[") += defaultVal) += "]   ";
+
+	// Put environment variable
+	if (environmentVariable.length() > 0)
+		((line += "env=[") += environmentVariable) += "]   ";
+
+	// Put repeat policy, but only if it is not the default one
+	if (repeatPolicy != REPEAT_POLICY::KEEP_FIRST)
+		((line += "repeat=[") += RepeatPolicyToString(repeatPolicy)) += "]   ";
+
+	// Put incompatibilities
+	if (incompatibilities.length() > 0)
+		((line += "incompatibilities=[") += incompatibilities) += "]   ";
+
+	// Put required tag, but only if no default value
+	if ((required) && (defaultVal.length() == 0))
+		line += "[[REQUIRED]]    ";
+
+	// Put brief description
+	line += description;
+
+	// Continued lines get indented, to set them apart from the next key
+	AppendWrapped(out, line, documentationWidth, 4);
+
+	return true;
+}
+
+std::string_view Schema::FindAbbreviationOf(const std::string& key) const
+{
+	// Take the first one in sorted order, if there are multiple
+	std::string_view found;
+	for (const auto& it : parameterAbreviations)
+		if ((it.second == key) && ((found.empty()) || (std::string_view(it.first) < found)))
+			found = it.first;
+
+	if (!found.empty())
+		return found;
+
+	bool isAbbreviation = false;
+	const std::size_t id = staticSchema.Find(key, isAbbreviation);
+	if ((id != Internal::StaticSchemaView::npos) && (!isAbbreviation))
+		return staticSchema.specs[id].abbreviation;
+
+	return found;
+}
+
+void Schema::FindArity(const std::string& key, bool& out_takesValue, bool& out_takesSingleValue) const
+{
+	bool constrainType = false;
+	DATA_TYPE requiredType = DATA_TYPE::VOID;
+	REPEAT_POLICY repeatPolicy = REPEAT_POLICY::KEEP_FIRST;
+
+	bool isAbbreviation = false;
+	const std::size_t id = staticSchema.Find(key, isAbbreviation);
+	if ((id != Internal::StaticSchemaView::npos) && (!isAbbreviation))
+	{
+		const ParamSpec& spec = staticSchema.specs[id];
+		constrainType = spec.constrainType;
+		requiredType = spec.requiredType;
+		repeatPolicy = spec.repeatPolicy;
+	}
+	else if (const ParamConstraint* constraint = GetConstraintForKey(key))
+	{
+		constrainType = constraint->constrainType;
+		requiredType = constraint->requiredType;
+		repeatPolicy = constraint->repeatPolicy;
+	}
+
+	out_takesSingleValue = (constrainType) &&
+		((requiredType == DATA_TYPE::INT) ||
+		 (requiredType == DATA_TYPE::FLOAT) ||
+		 (requiredType == DATA_TYPE::STRING));
+
+	out_takesValue = (constrainType) ?
+		(requiredType != DATA_TYPE::VOID) :
+		(repeatPolicy == REPEAT_POLICY::APPEND);
+
+	return;
+}
+
+bool Schema::TakesSingleValue(const std::string& key) const
+{
+	bool takesValue;
+	bool takesSingleValue;
+	FindArity(key, takesValue, takesSingleValue);
+
+	return takesSingleValue;
+}
+
+bool Schema::IsShortFlag(std::string_view abbreviation)
+{
+	return (abbreviation.length() == 2) && (abbreviation[0] == '-') && (abbreviation[1] != '-');
+}
+
+void Schema::UpdateShortFlag(unsigned char c)
+{
+	Internal::ShortFlag& flag = shortFlags[c];
+	flag = Internal::ShortFlag();
+
+	const char name[] = { '-', (char)c };
+	const std::string_view abbreviation(name, 2);
+	if (!IsShortFlag(abbreviation))
+		return;
+
+	// The static schema goes first, just like when expanding abbreviations as a whole
+	bool isAbbreviation = false;
+	const std::size_t id = staticSchema.Find(abbreviation, isAbbreviation);
+	if ((id != Internal::StaticSchemaView::npos) && (isAbbreviation))
+	{
+		flag.longForm = staticSchema.specs[id].key;
+		flag.isStatic = true;
+	}
+	else
+	{
+		const auto registered = parameterAbreviations.find(std::string(abbreviation));
+		if (registered == parameterAbreviations.end())
+			return;
+
+		flag.longForm = registered->second;
+	}
+
+	FindArity(std::string(flag.longForm), flag.takesValue, flag.takesSingleValue);
+
+	return;
+}
+
+void Schema::UpdateShortFlags()
+{
+	for (std::size_t c = 0; c < shortFlags.size(); c++)
+		UpdateShortFlag((unsigned char)c);
+
+	numLongAbbreviations = 0;
+	for (const auto& it : parameterAbreviations)
+		if (!IsShortFlag(it.first))
+			numLongAbbreviations++;
+
+	for (std::size_t id = 0; id < staticSchema.numSpecs; id++)
+		if ((!staticSchema.specs[id].abbreviation.empty()) && (!IsShortFlag(staticSchema.specs[id].abbreviation)))
+			numLongAbbreviations++;
+
+	return;
+}
+
+void Schema::UpdateShortFlagsOf(const std::string& key)
+{
+	for (std::size_t c = 0; c < shortFlags.size(); c++)
+		if (shortFlags[c].longForm == key)
+			UpdateShortFlag((unsigned char)c);
+
+	return;
+}
+
+void Schema::Freeze()
+{
+	// Render the documentation now, so that a frozen schema is never written to again
+	if (!documentationIsValid)
+		RenderDocumentation();
+
+	if (matchUniquePrefixes)
+		GetKeyIndex();
+
+	frozen = true;
+	return;
+}
+
+bool Schema::IsFrozen() const
+{
+	return frozen;
+}
+
+void Schema::BeginChange()
+{
+	if (frozen)
+		throw HazelnuppException("This schema is frozen, and can not be changed anymore!");
+
+	documentationIsValid = false;
+	keyIndexIsValid = false;
+
+	return;
+}
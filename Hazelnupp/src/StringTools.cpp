@@ -1,8 +1,180 @@
 #include "Hazelnupp/StringTools.h"
+#include <charconv>
+#include <climits>
+#include <cfloat>
+#include <cstring>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define HAZELNUPP_SSE2
+#include <emmintrin.h>
+#endif
 
 using namespace Hazelnp;
 
-bool Internal::StringTools::Contains(const std::string& str, const char c)
+namespace
+{
+    // Most digits accumulated at once
+    constexpr std::size_t blockSize = 16;
+
+    // Most digits a decimal fraction may have, for its digits to be exact within a long double
+    constexpr std::size_t maxExactFractionDigits = (LDBL_MANT_DIG >= 64) ? 16 : 15;
+
+    // Exact powers of ten, to scale decimal fractions by
+    constexpr long double powersOfTen[blockSize + 1] = {
+        1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L, 1e8L,
+        1e9L, 1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L
+    };
+
+#ifdef HAZELNUPP_SSE2
+    // '0' in each lane of a qword
+    constexpr std::uint64_t zeroDigits = 0x3030303030303030ull;
+
+    // Will move the first length characters of chars to the top of a qword, and fill the lanes below with '0'. length is at most 8.
+    std::uint64_t AlignTop(const std::uint64_t chars, const std::size_t length)
+    {
+        if (length == 0)
+            return zeroDigits;
+
+        const std::size_t numPadded = 8 - length;
+        return (chars << (8 * numPadded)) | ((numPadded == 0) ? 0 : (zeroDigits >> (8 * length)));
+    }
+
+    // Will load the length characters ending at end into a block, right-aligned, and padded with '0'.
+    // Only the characters of the token are read, through overlapping loads of a fixed size. The block gets assembled in registers,
+    // because storing it to memory, and loading it whole, would stall on store forwarding.
+    __m128i LoadRightAligned(const char* end, const std::size_t length)
+    {
+        const char* const begin = end - length;
+
+        std::uint64_t high;
+        std::uint64_t low = zeroDigits;
+        if (length >= 8)
+        {
+            std::uint64_t first;
+            std::memcpy(&first, begin, 8);
+            std::memcpy(&high, end - 8, 8);
+            low = AlignTop(first, length - 8);
+        }
+        else
+        {
+            std::uint64_t chars = 0;
+            if (length >= 4)
+            {
+                std::uint32_t first;
+                std::uint32_t last;
+                std::memcpy(&first, begin, 4);
+                std::memcpy(&last, end - 4, 4);
+                chars = first | ((std::uint64_t)last << (8 * (length - 4)));
+            }
+            else if (length > 0)
+            {
+                // The first, middle and last character cover up to three
+                chars = (std::uint64_t)(unsigned char)begin[0] |
+                    ((std::uint64_t)(unsigned char)begin[length / 2] << (8 * (length / 2))) |
+                    ((std::uint64_t)(unsigned char)begin[length - 1] << (8 * (length - 1)));
+            }
+
+            high = AlignTop(chars, length);
+        }
+
+        return _mm_set_epi64x((long long int)high, (long long int)low);
+    }
+#endif
+
+    // Will validate and accumulate up to 16 digits. Returns false if any of them is no digit.
+    bool LexDigits(const char* begin, const std::size_t length, unsigned long long int& out)
+    {
+#ifdef HAZELNUPP_SSE2
+        if (length == 0)
+        {
+            out = 0;
+            return true;
+        }
+
+        const __m128i digits = _mm_sub_epi8(LoadRightAligned(begin + length, length), _mm_set1_epi8('0'));
+
+        // Characters below '0' wrap around, so that they exceed 9 aswell
+        const __m128i nine = _mm_set1_epi8(9);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(digits, nine), nine)) != 0xFFFF) return false;
+
+        // Combine neighbours, doubling the digits per lane each step. The more significant neighbour comes first.
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i pairWeights = _mm_set1_epi32((1 << 16) | 10);
+        const __m128i pairs = _mm_packs_epi32(
+            _mm_madd_epi16(_mm_unpacklo_epi8(digits, zero), pairWeights),
+            _mm_madd_epi16(_mm_unpackhi_epi8(digits, zero), pairWeights)
+        );
+
+        const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32((1 << 16) | 100));
+        const __m128i octets = _mm_madd_epi16(_mm_packs_epi32(quads, quads), _mm_set1_epi32((1 << 16) | 10000));
+
+        const unsigned long long int high = (unsigned int)_mm_cvtsi128_si32(octets);
+        const unsigned long long int low = (unsigned int)_mm_cvtsi128_si32(_mm_srli_si128(octets, 4));
+        out = high * 100000000ull + low;
+
+        return true;
+#else
+        unsigned long long int value = 0;
+        for (std::size_t i = 0; i < length; i++)
+        {
+            const unsigned int digit = (unsigned char)begin[i] - (unsigned int)'0';
+            if (digit > 9) return false;
+
+            value = value * 10 + digit;
+        }
+
+        out = value;
+        return true;
+#endif
+    }
+
+    // Will convert a decimal integer of up to 16 digits, like -1234.
+    // Returns false for anything else. LexNumber() has to classify it then.
+    bool LexShortInteger(std::string_view token, long long int& out)
+    {
+        const bool isNegative = (!token.empty()) && (token[0] == '-');
+        if (isNegative) token.remove_prefix(1);
+
+        if ((token.empty()) || (token.length() > blockSize)) return false;
+
+        unsigned long long int magnitude;
+        if (!LexDigits(token.data(), token.length(), magnitude)) return false;
+
+        out = isNegative ? -(long long int)magnitude : (long long int)magnitude;
+        return true;
+    }
+
+    // Will convert a decimal fraction whose digits are exact within a long double, like -12.375.
+    // Returns false for anything else. LexNumber() has to classify it then.
+    bool LexShortFraction(std::string_view token, long double& out)
+    {
+        const bool isNegative = (!token.empty()) && (token[0] == '-');
+        if (isNegative) token.remove_prefix(1);
+
+        // We need at least one digit before the point
+        const std::size_t point = token.find('.');
+        if ((point == 0) || (point == std::string_view::npos)) return false;
+
+        const std::size_t numFractionDigits = token.length() - point - 1;
+        if (point + numFractionDigits > maxExactFractionDigits) return false;
+
+        unsigned long long int whole;
+        unsigned long long int fraction;
+        if ((!LexDigits(token.data(), point, whole)) ||
+            (!LexDigits(token.data() + point + 1, numFractionDigits, fraction)))
+            return false;
+
+        // Both are exact, so this single division rounds just like from_chars() does
+        const long double magnitude = (long double)(whole * (unsigned long long int)powersOfTen[numFractionDigits] + fraction);
+        const long double value = magnitude / powersOfTen[numFractionDigits];
+        out = isNegative ? -value : value;
+
+        return true;
+    }
+}
+
+bool Internal::StringTools::Contains(std::string_view str, const char c)
 {
     for (const char& i : str)
         if (i == c)
@@ -53,7 +225,7 @@ std::string Internal::StringTools::Replace(const std::string& str, const std::st
 }
 
 
-bool Internal::StringTools::IsNumeric(const std::string& str, const bool allowDecimalPoint)
+bool Internal::StringTools::IsNumeric(std::string_view str, const bool allowDecimalPoint)
 {
     if (str.length() == 0) return false;
 
@@ -79,54 +251,137 @@ bool Internal::StringTools::IsNumeric(const std::string& str, const bool allowDe
     return digitCount > 0;
 }
 
-bool Internal::StringTools::ParseNumber(const std::string& str, bool& out_isInt, long double& out_number)
+bool Internal::StringTools::ParseNumber(std::string_view str, bool& out_isInt, long double& out_number)
 {
-    bool isDecimal = false;
+    long long int intNum;
+    const DATA_TYPE type = LexNumber(str, intNum, out_number);
 
-    if (str.length() == 0) return false;
-    if (Contains(str, '.')) isDecimal = true;
+    if (type == DATA_TYPE::STRING) return false;
 
-    if (isDecimal)
+    out_isInt = type == DATA_TYPE::INT;
+
+    return true;
+}
+
+DATA_TYPE Internal::StringTools::LexNumber(std::string_view str, long long int& out_int, long double& out_float)
+{
+    const char* const begin = str.data();
+    const char* const end = begin + str.length();
+    const char* p = begin;
+
+    const bool isNegative = (p != end) && (*p == '-');
+    if (isNegative) p++;
+
+    if (p == end) return DATA_TYPE::STRING;
+
+    // Prefixed integers, like 0x1F, 0o17 or 0b101
+    if ((*p == '0') && (end - p > 2))
     {
-        try
+        int base = 0;
+        switch (p[1])
         {
-            out_number = std::stold(str);
-            out_isInt = false;
-        }
-        catch (std::invalid_argument&)
-        {
-            return false;
+        case 'x': case 'X': base = 16; break;
+        case 'o': case 'O': base = 8;  break;
+        case 'b': case 'B': base = 2;  break;
         }
-        catch (std::out_of_range&)
+
+        if (base != 0)
         {
-            return false;
+            unsigned long long int magnitude;
+            const std::from_chars_result res = std::from_chars(p + 2, end, magnitude, base);
+            if ((res.ec != std::errc()) || (res.ptr != end)) return DATA_TYPE::STRING;
+
+            // Does it still fit into a long long int?
+            const unsigned long long int limit = isNegative ? (unsigned long long int)LLONG_MAX + 1 : (unsigned long long int)LLONG_MAX;
+            if (magnitude > limit) return DATA_TYPE::STRING;
+
+            out_int = isNegative ? (long long int)(0 - magnitude) : (long long int)magnitude;
+            out_float = (long double)out_int;
+            return DATA_TYPE::INT;
         }
     }
-    else
+
+    // Decimal numbers. We need at least one digit before anything else.
+    const char* digitsBegin = p;
+    while ((p != end) && (*p >= '0') && (*p <= '9')) p++;
+    if (p == digitsBegin) return DATA_TYPE::STRING;
+
+    bool isFloat = false;
+
+    // Fraction
+    if ((p != end) && (*p == '.'))
     {
-        try
-        {
-            out_number = (long double)std::stoll(str);
-            out_isInt = true;
-        }
-        catch (std::invalid_argument&)
-        {
-            return false;
-        }
-        catch (std::out_of_range&)
+        isFloat = true;
+        p++;
+        while ((p != end) && (*p >= '0') && (*p <= '9')) p++;
+    }
+
+    // Exponent
+    if ((p != end) && ((*p == 'e') || (*p == 'E')))
+    {
+        isFloat = true;
+        p++;
+        if ((p != end) && ((*p == '+') || (*p == '-'))) p++;
+
+        const char* exponentBegin = p;
+        while ((p != end) && (*p >= '0') && (*p <= '9')) p++;
+        if (p == exponentBegin) return DATA_TYPE::STRING;
+    }
+
+    // Trailing garbage
+    if (p != end) return DATA_TYPE::STRING;
+
+    // Exact integer path
+    if (!isFloat)
+    {
+        if (std::from_chars(begin, end, out_int).ec == std::errc())
         {
-            return false;
+            out_float = (long double)out_int;
+            return DATA_TYPE::INT;
         }
+
+        // Else it is too big for 64 bits. Fall back to floating point.
     }
 
-    return true;
+    const std::from_chars_result res = std::from_chars(begin, end, out_float);
+    if ((res.ec != std::errc()) || (res.ptr != end)) return DATA_TYPE::STRING;
+
+    return DATA_TYPE::FLOAT;
+}
+
+std::size_t Internal::StringTools::LexIntegers(const std::string_view* tokens, const std::size_t numTokens, long long int* out)
+{
+    for (std::size_t i = 0; i < numTokens; i++)
+    {
+        if (LexShortInteger(tokens[i], out[i])) continue;
+
+        // Prefixed, or long integers
+        long double floatNum;
+        if (LexNumber(tokens[i], out[i], floatNum) != DATA_TYPE::INT) return i;
+    }
+
+    return numTokens;
+}
+
+std::size_t Internal::StringTools::LexFloats(const std::string_view* tokens, const std::size_t numTokens, long double* out)
+{
+    for (std::size_t i = 0; i < numTokens; i++)
+    {
+        if (LexShortFraction(tokens[i], out[i])) continue;
+
+        // Exponents, long fractions, and integers exceeding 64 bits
+        long long int intNum;
+        if (LexNumber(tokens[i], intNum, out[i]) != DATA_TYPE::FLOAT) return i;
+    }
+
+    return numTokens;
 }
 
 std::vector<std::string> Internal::StringTools::SplitString(const std::string& str, const char delimiter)
 {
     if (str.length() == 0) return std::vector<std::string>();
 
-    return SplitString(str, delimiter);
+    return SplitString(str, std::string(1, delimiter));
 }
 
 std::vector<std::string> Internal::StringTools::SplitString(const std::string& str, const std::string& delimiter)
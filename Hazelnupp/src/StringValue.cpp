@@ -1,67 +1,39 @@
 #include "Hazelnupp/StringValue.h"
-#include "Hazelnupp/HazelnuppException.h"
-#include <sstream>
 
 using namespace Hazelnp;
 
 StringValue::StringValue(const std::string& value)
 	:
-	Value(DATA_TYPE::STRING),
-	value { value }
+	Value(DATA_TYPE::STRING)
 {
+	AssignString(value, true);
 	return;
 }
 
-Value* StringValue::Deepcopy() const
-{
-	return new StringValue(value);
-}
-
-std::string StringValue::GetAsOsString() const
+StringValue::StringValue(std::string_view value, bool copy)
+	:
+	Value(DATA_TYPE::STRING)
 {
-	std::stringstream ss;
-	ss << "StringValue: " << value;
-	return ss.str();
+	AssignString(value, copy);
+	return;
 }
 
 const std::string& StringValue::GetValue() const
 {
-	return value;
+	return GetCachedString();
 }
 
-StringValue::operator std::string() const
-{
-	return value;
-}
-
-
-
-long long int StringValue::GetInt64() const
+std::string_view StringValue::GetValueView() const
 {
-	throw HazelnuppValueNotConvertibleException();
+	return GetStringView();
 }
 
-int StringValue::GetInt32() const
+bool StringValue::IsOwning() const
 {
-	throw HazelnuppValueNotConvertibleException();
+	return isInline || isOwning;
 }
 
-long double StringValue::GetFloat64() const
-{
-	throw HazelnuppValueNotConvertibleException();
-}
-
-double StringValue::GetFloat32() const
-{
-	throw HazelnuppValueNotConvertibleException();
-}
-
-std::string StringValue::GetString() const
-{
-	return value;
-}
-
-const std::vector<Value*>& StringValue::GetList() const
+StringValue::operator std::string() const
 {
-	throw HazelnuppValueNotConvertibleException();
+	return GetString();
 }
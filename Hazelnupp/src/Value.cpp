@@ -1,15 +1,424 @@
 #include "Hazelnupp/Value.h"
+#include "Hazelnupp/IntValue.h"
+#include "Hazelnupp/FloatValue.h"
+#include "Hazelnupp/StringValue.h"
+#include "Hazelnupp/VoidValue.h"
+#include "Hazelnupp/ListValue.h"
+#include "Hazelnupp/HazelnuppException.h"
+#include "Hazelnupp/ParseResult.h"
+#include "Hazelnupp/StringTools.h"
+#include <sstream>
+#include <cstring>
+#include <thread>
+#include <algorithm>
 
 using namespace Hazelnp;
 
+const std::vector<Value*> Value::emptyList;
+
 Value::Value(DATA_TYPE type)
 	:
 	type{ type }
 {
+	data.intValue = 0;
+	return;
+}
+
+Value::Value(const Internal::LazySource* source)
+	:
+	type{ DATA_TYPE::VOID },
+	state{ PENDING_SOURCE }
+{
+	data.lazySource = source;
+	return;
+}
+
+Value::Value(const Value& other)
+	:
+	type{ DATA_TYPE::VOID }
+{
+	data.intValue = 0;
+	*this = other;
+
+	return;
+}
+
+Value& Value::operator=(const Value& other)
+{
+	if (this == &other)
+		return *this;
+
+	// Copies are always converted
+	other.ResolveIfPending();
+
+	Free();
+	state.store(RESOLVED, std::memory_order_relaxed);
+	type = other.type;
+
+	switch (type)
+	{
+	case DATA_TYPE::STRING:
+		// Copies always own their characters. The other one may just reference a buffer about to be overwritten, like the one of a ParseResult.
+		AssignString(other.GetStringView(), true);
+		break;
+
+	case DATA_TYPE::LIST:
+	{
+		// Copies always own their values, and their contiguous elements
+		const Internal::ListStorage& otherList = *other.data.listStorage;
+		Internal::ListStorage* list = new Internal::ListStorage();
+		data.listStorage = list;
+		isOwning = true;
+
+		list->elementType = otherList.elementType;
+		list->size = otherList.size;
+
+		switch (list->elementType)
+		{
+		case DATA_TYPE::INT:
+		{
+			long long int* ints = new long long int[otherList.size];
+			std::copy_n(otherList.ints, otherList.size, ints);
+			list->ints = ints;
+			break;
+		}
+
+		case DATA_TYPE::FLOAT:
+		{
+			long double* floats = new long double[otherList.size];
+			std::copy_n(otherList.floats, otherList.size, floats);
+			list->floats = floats;
+			break;
+		}
+
+		case DATA_TYPE::STRING:
+		{
+			// Just like string values, own the characters. All of them in one buffer.
+			std::size_t numCharacters = 0;
+			for (std::size_t i = 0; i < otherList.size; i++)
+				numCharacters += otherList.strings[i].length();
+
+			char* characters = new char[numCharacters];
+			std::string_view* strings = new std::string_view[otherList.size];
+
+			std::size_t offset = 0;
+			for (std::size_t i = 0; i < otherList.size; i++)
+			{
+				const std::string_view str = otherList.strings[i];
+				str.copy(characters + offset, str.length());
+				strings[i] = std::string_view(characters + offset, str.length());
+				offset += str.length();
+			}
+
+			list->strings = strings;
+			list->characters = characters;
+			break;
+		}
+
+		default:
+			break;
+		}
+
+		const std::vector<Value*>& otherElements = other.GetList();
+		std::vector<Value*>* elements = new std::vector<Value*>();
+		elements->reserve(otherElements.size());
+		for (const Value* val : otherElements)
+			elements->emplace_back(val->Deepcopy());
+
+		list->elements = elements;
+		break;
+	}
+
+	default:
+		// Ints, floats and voids are just bits
+		data = other.data;
+		break;
+	}
+
+	return *this;
+}
+
+Value::~Value()
+{
+	Free();
+	return;
+}
+
+void Value::Free()
+{
+	// Values of a ParseResult are never freed, so a cached std::string is always our own here
+	const std::uintptr_t cache = stringCache.exchange(0, std::memory_order_acq_rel);
+	if ((cache != 0) && ((cache & parseResultTag) == 0))
+		delete (const std::string*)cache;
+
+	if (isOwning)
+	{
+		if (type == DATA_TYPE::STRING)
+			delete[] data.stringData;
+
+		else if (type == DATA_TYPE::LIST)
+		{
+			std::vector<Value*>* elements = data.listStorage->elements.load();
+			for (Value* val : *elements)
+				delete val;
+
+			delete elements;
+			DropTypedElements();
+			delete data.listStorage;
+		}
+	}
+
+	isOwning = false;
+	isInline = false;
+	stringLength = 0;
+	data.intValue = 0;
+
+	return;
+}
+
+const std::string& Value::GetCachedString() const
+{
+	ResolveIfPending();
+
+	std::uintptr_t cache = stringCache.load(std::memory_order_acquire);
+	if ((cache != 0) && ((cache & parseResultTag) == 0))
+		return *(const std::string*)cache;
+
+	// Values of a ParseResult are never destructed, so it has to own theirs
+	ParseResult* const owner = (ParseResult*)(cache & ~parseResultTag);
+	const std::string* const str = (owner != nullptr) ? owner->NewCachedString(GetStringView()) : new std::string(GetStringView());
+
+	// Another thread may have been faster. Then use its std::string.
+	if (!stringCache.compare_exchange_strong(cache, (std::uintptr_t)str, std::memory_order_acq_rel, std::memory_order_acquire))
+	{
+		if (owner == nullptr)
+			delete str;
+
+		return *(const std::string*)cache;
+	}
+
+	return *str;
+}
+
+void Value::DropTypedElements()
+{
+	Internal::ListStorage* list = data.listStorage;
+
+	if (isOwning)
+		switch (list->elementType)
+		{
+		case DATA_TYPE::INT:
+			delete[] list->ints;
+			break;
+
+		case DATA_TYPE::FLOAT:
+			delete[] list->floats;
+			break;
+
+		case DATA_TYPE::STRING:
+			delete[] list->strings;
+			delete[] list->characters;
+			break;
+
+		default:
+			break;
+		}
+
+	list->elementType = DATA_TYPE::VOID;
+	list->ints = nullptr;
+	list->characters = nullptr;
+
+	return;
+}
+
+void Value::AssignString(std::string_view str, bool copy)
+{
+	stringLength = (std::uint32_t)str.length();
+
+	if (!copy)
+		data.stringData = str.data();
+
+	else if (str.length() <= inlineStringCapacity)
+	{
+		str.copy(data.inlineString, str.length());
+		isInline = true;
+	}
+
+	else
+	{
+		char* heapString = new char[str.length()];
+		str.copy(heapString, str.length());
+		data.stringData = heapString;
+		isOwning = true;
+	}
+
 	return;
 }
 
-DATA_TYPE Value::GetDataType() const
+void Value::ThrowNotConvertible()
+{
+	throw HazelnuppValueNotConvertibleException();
+}
+
+void Value::Resolve() const
 {
-	return type;
+	// Claim the conversion. If another thread claimed it already, wait for it to finish.
+	std::uint8_t pending;
+	while (true)
+	{
+		pending = state.load(std::memory_order_acquire);
+		if (pending == RESOLVED)
+			return;
+
+		if ((pending != RESOLVING) && (state.compare_exchange_weak(pending, RESOLVING, std::memory_order_acquire)))
+			break;
+
+		std::this_thread::yield();
+	}
+
+	// Lazy values are never const themselves, just accessed through const methods
+	Value& self = const_cast<Value&>(*this);
+
+	try
+	{
+		self.Adopt(*data.lazySource->owner->ConvertLazily(*data.lazySource));
+	}
+	catch (...)
+	{
+		// Nothing got changed. Whoever accesses this value next, gets the same error.
+		state.store(pending, std::memory_order_release);
+		throw;
+	}
+
+	state.store(RESOLVED, std::memory_order_release);
+
+	return;
+}
+
+const std::vector<Value*>& Value::BuildElements() const
+{
+	Internal::ListStorage& list = *data.listStorage;
+
+	// The arena is not thread-safe
+	std::lock_guard<std::mutex> lock(list.owner->lazyMutex);
+
+	// Another thread may have built them, whilst we were waiting
+	std::vector<Value*>* elements = list.elements.load(std::memory_order_acquire);
+	if (elements == nullptr)
+	{
+		elements = list.owner->NewListElements(list);
+		list.elements.store(elements, std::memory_order_release);
+	}
+
+	return *elements;
+}
+
+void Value::Adopt(const Value& converted)
+{
+	// Converted values live in an arena, and are never destructed. So we can just take over whatever they hold.
+	type = converted.type;
+	stringLength = converted.stringLength;
+	isInline = converted.isInline;
+	isOwning = converted.isOwning;
+	stringCache.store(converted.stringCache.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	data = converted.data;
+
+	return;
+}
+
+Value* Value::Deepcopy() const
+{
+	ResolveIfPending();
+
+	// Keep the facade type, so callers can still cast to it
+	switch (type)
+	{
+	case DATA_TYPE::INT:
+		return new IntValue(*(const IntValue*)this);
+
+	case DATA_TYPE::FLOAT:
+		return new FloatValue(*(const FloatValue*)this);
+
+	case DATA_TYPE::STRING:
+		return new StringValue(*(const StringValue*)this);
+
+	case DATA_TYPE::LIST:
+		return new ListValue(*(const ListValue*)this);
+
+	case DATA_TYPE::VOID:
+		break;
+	}
+
+	return new VoidValue();
+}
+
+std::string Value::GetAsOsString() const
+{
+	ResolveIfPending();
+
+	std::stringstream ss;
+
+	switch (type)
+	{
+	case DATA_TYPE::INT:
+		ss << "IntValue: " << data.intValue;
+		break;
+
+	case DATA_TYPE::FLOAT:
+		ss << "FloatValue: " << data.floatValue;
+		break;
+
+	case DATA_TYPE::STRING:
+		ss << "StringValue: " << GetStringView();
+		break;
+
+	case DATA_TYPE::VOID:
+		ss << "VoidValue";
+		break;
+
+	case DATA_TYPE::LIST:
+		ss << "ListValue: [";
+
+		const std::vector<Value*>& elements = GetList();
+		for (const Value* val : elements)
+		{
+			ss << *val;
+			if (val != elements.back())
+				ss << ", ";
+		}
+
+		ss << "]";
+		break;
+	}
+
+	return ss.str();
+}
+
+std::string Value::GetString() const
+{
+	ResolveIfPending();
+
+	std::stringstream ss;
+
+	switch (type)
+	{
+	case DATA_TYPE::INT:
+		ss << data.intValue;
+		return ss.str();
+
+	case DATA_TYPE::FLOAT:
+		ss << data.floatValue;
+		return ss.str();
+
+	case DATA_TYPE::STRING:
+		return std::string(GetStringView());
+
+	case DATA_TYPE::VOID:
+		return "";
+
+	case DATA_TYPE::LIST:
+		break;
+	}
+
+	ThrowNotConvertible();
 }
@@ -0,0 +1,175 @@
+#include "Hazelnupp/WorkStealingPool.h"
+#include "Hazelnupp/HazelnuppException.h"
+
+using namespace Hazelnp;
+
+namespace
+{
+	std::uint64_t Pack(std::uint64_t begin, std::uint64_t end)
+	{
+		return (begin << 32) | end;
+	}
+
+	std::uint64_t Begin(std::uint64_t bounds)
+	{
+		return bounds >> 32;
+	}
+
+	std::uint64_t End(std::uint64_t bounds)
+	{
+		return bounds & 0xffffffffull;
+	}
+}
+
+Internal::WorkStealingPool::WorkStealingPool(std::size_t numThreads)
+	:
+	numWorkers { numThreads }
+{
+	if (numWorkers == 0)
+		numWorkers = std::thread::hardware_concurrency();
+
+	// hardware_concurrency() may not know
+	if (numWorkers == 0)
+		numWorkers = 1;
+
+	ranges = std::make_unique<TaskRange[]>(numWorkers);
+
+	// Worker 0 is whoever calls Run()
+	threads.reserve(numWorkers - 1);
+	for (std::size_t i = 1; i < numWorkers; i++)
+		threads.emplace_back(&WorkStealingPool::WorkerLoop, this, i);
+
+	return;
+}
+
+Internal::WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	return;
+}
+
+void Internal::WorkStealingPool::Run(std::size_t numTasks, const std::function<void(std::size_t)>& task)
+{
+	if (numTasks > 0xffffffffull)
+		throw HazelnuppException("Too many tasks for one batch!");
+
+	std::lock_guard<std::mutex> runLock(runMutex);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		// Hand every worker an equal share
+		for (std::size_t i = 0; i < numWorkers; i++)
+			ranges[i].bounds.store(Pack(numTasks * i / numWorkers, numTasks * (i + 1) / numWorkers));
+
+		this->task = &task;
+		numBusy = threads.size();
+		generation++;
+	}
+	wake.notify_all();
+
+	// We are a worker aswell
+	Work(0);
+
+	// Wait for the others
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this] { return numBusy == 0; });
+	this->task = nullptr;
+
+	return;
+}
+
+std::size_t Internal::WorkStealingPool::GetNumThreads() const
+{
+	return numWorkers;
+}
+
+void Internal::WorkStealingPool::WorkerLoop(std::size_t worker)
+{
+	std::size_t seenGeneration = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [&] { return (stopping) || (generation != seenGeneration); });
+
+			if (stopping)
+				return;
+
+			seenGeneration = generation;
+		}
+
+		Work(worker);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			numBusy--;
+		}
+		done.notify_one();
+	}
+}
+
+void Internal::WorkStealingPool::Work(std::size_t worker)
+{
+	std::size_t current;
+
+	do
+	{
+		while (Pop(worker, current))
+			(*task)(current);
+
+	} while (Steal(worker));
+
+	return;
+}
+
+bool Internal::WorkStealingPool::Pop(std::size_t worker, std::size_t& out_task)
+{
+	std::atomic<std::uint64_t>& bounds = ranges[worker].bounds;
+	std::uint64_t expected = bounds.load();
+
+	while (Begin(expected) < End(expected))
+		if (bounds.compare_exchange_weak(expected, Pack(Begin(expected) + 1, End(expected))))
+		{
+			out_task = (std::size_t)Begin(expected);
+			return true;
+		}
+
+	return false;
+}
+
+bool Internal::WorkStealingPool::Steal(std::size_t worker)
+{
+	// Every task index belongs to exactly one range at any time, and finished ones never come back.
+	// So a range can never take on bounds it had before, and compare-exchange is safe from ABA.
+	for (std::size_t offset = 1; offset < numWorkers; offset++)
+	{
+		std::atomic<std::uint64_t>& victim = ranges[(worker + offset) % numWorkers].bounds;
+		std::uint64_t expected = victim.load();
+
+		while (Begin(expected) < End(expected))
+		{
+			// Take the back half, rounded up, so that a single task can be stolen aswell
+			const std::uint64_t numStolen = (End(expected) - Begin(expected) + 1) / 2;
+			const std::uint64_t newEnd = End(expected) - numStolen;
+
+			if (victim.compare_exchange_weak(expected, Pack(Begin(expected), newEnd)))
+			{
+				// Our own range is empty, and thieves leave empty ranges alone. So we can just overwrite it.
+				ranges[worker].bounds.store(Pack(newEnd, newEnd + numStolen));
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
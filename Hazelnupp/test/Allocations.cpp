@@ -0,0 +1,279 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// Replaces the global operator new, to count heap allocations. This affects the whole test binary,
+// so it can be switched off via HAZELNUPP_ALLOCATION_BUDGETS, like for running under a heap profiler.
+#ifdef HAZELNUPP_ALLOCATION_BUDGETS
+
+using namespace Hazelnp;
+
+namespace
+{
+	// Allocations made on this thread. Other tests parse on worker threads, which must not interfere.
+	thread_local std::size_t g_numAllocations = 0;
+
+	void* CountedAllocate(std::size_t size) noexcept
+	{
+		g_numAllocations++;
+		return std::malloc(size > 0 ? size : 1);
+	}
+}
+
+void* operator new(std::size_t size)
+{
+	if (void* p = CountedAllocate(size))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAllocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+	return;
+}
+
+void operator delete[](void* p) noexcept
+{
+	std::free(p);
+	return;
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+	return;
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+	std::free(p);
+	return;
+}
+
+namespace
+{
+	// Will return how many heap allocations scenario made. No assertions in there, Catch2 allocates itself.
+	template <typename T_Scenario>
+	std::size_t CountAllocations(T_Scenario scenario)
+	{
+		const std::size_t before = g_numAllocations;
+		scenario();
+		return g_numAllocations - before;
+	}
+
+	const ArgList g_args({
+		"/my/fake/path/to/the/executable/wahoo.out",
+		"--a-parameter-name-too-long-for-sso",
+		"1",
+		"2",
+		"3",
+		"-f",
+		"--string-parameter-too-long-for-sso",
+		"a string value that is too long for short string optimization",
+		"--number",
+		"0x1f",
+		"--ratio",
+		"1.5e3"
+	});
+
+	// A schema exercising abbreviations, defaults, environment variables, type safety and handles alike
+	struct Fixture
+	{
+		Fixture()
+		{
+			schema.RegisterAbbreviation("-f", "--force-all-the-things");
+			schema.RegisterConstraint("--default-parameter-too-long-for-sso", ParamConstraint::Require({ "1", "2", "a default value too long for sso" }));
+			schema.RegisterConstraint("--number", ParamConstraint::TypeSafety(DATA_TYPE::INT));
+			schema.RegisterConstraint("--ratio", ParamConstraint::TypeSafety(DATA_TYPE::FLOAT));
+			schema.RegisterDescription("--number", "Some number");
+			schema.RegisterEnvironmentVariable("--ratio", "HAZELNUPP_TEST_RATIO");
+			schema.RegisterEnvironmentVariable("--environment-parameter-too-long-for-sso", "HOME");
+			count = schema.RegisterParameter<long long>("--count", ParamConstraint::Require({ "5" }));
+
+			return;
+		}
+
+		Schema schema;
+		ParamHandle<long long> count;
+	};
+}
+
+// Tests that parsing again on a warmed instance does not touch the heap at all
+TEST_CASE(__FILE__"/Warm_Reparse", "[Allocations]")
+{
+	// Setup
+	Fixture fixture;
+	fixture.schema.Freeze();
+
+	ParseResult result(fixture.schema);
+	ParseResult borrowing(fixture.schema);
+	borrowing.SetBorrowArgv(true);
+	ParseResult lazy(fixture.schema);
+	lazy.SetLazyConversion(true);
+
+	CmdArgsInterface cmdArgsI;
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.RegisterAbbreviation("-f", "--force-all-the-things");
+	cmdArgsI.RegisterConstraint("--number", ParamConstraint::TypeSafety(DATA_TYPE::INT));
+
+	// Exercise
+	const std::size_t cold = CountAllocations([&] { result.Parse(C_Ify(g_args)); });
+
+	borrowing.Parse(C_Ify(g_args));
+	lazy.Parse(C_Ify(g_args));
+	lazy.Validate();
+	cmdArgsI.Parse(C_Ify(g_args));
+
+	const std::size_t warm = CountAllocations([&] { result.Parse(C_Ify(g_args)); });
+	const std::size_t warmBorrowing = CountAllocations([&] { borrowing.Parse(C_Ify(g_args)); });
+	const std::size_t warmLazy = CountAllocations([&] { lazy.Parse(C_Ify(g_args)); lazy.Validate(); });
+	const std::size_t warmCmdArgsI = CountAllocations([&] { cmdArgsI.Parse(C_Ify(g_args)); });
+
+	// Verify
+	// The first parse only reserves its arena and buffers, independent of the amount of tokens
+	REQUIRE(cold <= 8);
+	REQUIRE(warm == 0);
+	REQUIRE(warmBorrowing == 0);
+	REQUIRE(warmLazy == 0);
+	REQUIRE(warmCmdArgsI == 0);
+
+	return;
+}
+
+// Tests that streaming again on a warmed instance does not touch the heap at all
+TEST_CASE(__FILE__"/Warm_Stream", "[Allocations]")
+{
+	// Setup
+	Fixture fixture;
+	fixture.schema.Freeze();
+	ParseResult result(fixture.schema);
+
+	const auto stream = [&]
+	{
+		result.BeginStream("wahoo.out");
+		for (std::size_t i = 1; i < g_args.size(); i++)
+			result.Push(g_args[i]);
+		result.PushChunk("--chunked-parameter-too-long-for-sso\na chunked value that is too long for sso\n--ab");
+		result.PushChunk("c\n");
+		result.EndStream();
+
+		return;
+	};
+
+	stream();
+
+	// Exercise
+	const std::size_t warm = CountAllocations(stream);
+
+	// Verify
+	REQUIRE(warm == 0);
+
+	return;
+}
+
+// Tests that looking up parameters and reading their values does not touch the heap
+TEST_CASE(__FILE__"/Lookup_And_Conversion", "[Allocations]")
+{
+	// Setup
+	Fixture fixture;
+	fixture.schema.Freeze();
+	ParseResult result(fixture.schema);
+	result.Parse(C_Ify(g_args));
+
+	// Keys get built upfront, because building a long std::string from a literal allocates by itself
+	const std::string list = "--a-parameter-name-too-long-for-sso";
+	const std::string string = "--string-parameter-too-long-for-sso";
+	const std::string number = "--number";
+	const std::string ratio = "--ratio";
+
+	long long numberValue = 0;
+	long long countValue = 0;
+	long double ratioValue = 0;
+	std::size_t listSize = 0;
+	std::size_t stringSize = 0;
+	bool hasNumber = false;
+
+	// Exercise
+	const std::size_t lookup = CountAllocations([&] { hasNumber = result.HasParam(number); });
+	const std::size_t handle = CountAllocations([&] { countValue = result[fixture.count]; });
+	const std::size_t toInt = CountAllocations([&] { numberValue = result[number].GetInt64(); });
+	const std::size_t toFloat = CountAllocations([&] { ratioValue = result[ratio].GetFloat64(); });
+	const std::size_t toListFirst = CountAllocations([&] { listSize = result[list].GetList().size(); });
+	const std::size_t toStringView = CountAllocations([&] { stringSize = result[string].GetStringView().size(); });
+	const std::size_t toString = CountAllocations([&] { stringSize = result[string].GetString().size(); });
+
+	// Verify
+	REQUIRE(hasNumber);
+	REQUIRE(countValue == 5);
+	REQUIRE(numberValue == 0x1f);
+	REQUIRE(ratioValue == 1.5e3);
+	REQUIRE(listSize == 3);
+	REQUIRE(stringSize == 61);
+
+	REQUIRE(lookup == 0);
+	REQUIRE(handle == 0);
+	REQUIRE(toInt == 0);
+	REQUIRE(toFloat == 0);
+	REQUIRE(toStringView == 0);
+	// Only the copy itself
+	REQUIRE(toString <= 1);
+
+	// GetList() hands out a std::vector, which can not live in the arena. So the first one of a ParseResult allocates it,
+	// its buffer, and a slot to keep it in.
+	REQUIRE(toListFirst <= 3);
+
+	// Exercise
+	// The following parses reuse it
+	result.Parse(C_Ify(g_args));
+	const std::size_t toList = CountAllocations([&] { listSize = result[list].GetList().size(); });
+
+	// Verify
+	REQUIRE(listSize == 3);
+	REQUIRE(toList == 0);
+
+	return;
+}
+
+// Tests that the documentation gets rendered with few allocations, and reading it again allocates none
+TEST_CASE(__FILE__"/Documentation", "[Allocations]")
+{
+	// Setup
+	Fixture fixture;
+	std::size_t length = 0;
+
+	// Exercise
+	const std::size_t first = CountAllocations([&] { length = fixture.schema.GenerateDocumentation().length(); });
+	const std::size_t cached = CountAllocations([&] { length = fixture.schema.GenerateDocumentation().length(); });
+	const std::size_t single = CountAllocations([&] { length = fixture.schema.GenerateParameterDocumentation("--number").length(); });
+
+	// Verify
+	REQUIRE(length > 0);
+	// A handful per documented parameter
+	REQUIRE(first <= 8 * 5);
+	REQUIRE(cached == 0);
+	REQUIRE(single <= 4);
+
+	return;
+}
+
+#endif
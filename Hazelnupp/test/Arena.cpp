@@ -0,0 +1,189 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/ListValue.h>
+#include <Hazelnupp/StringValue.h>
+#include <cstdint>
+
+using namespace Hazelnp;
+
+// Tests that parse results are allocated from a caller-supplied memory resource, and given back all at once
+TEST_CASE(__FILE__"/Parse_Results_Use_Supplied_Resource", "[Arena]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--my_string",
+		"billybob",
+		"--my_num_list",
+		"1",
+		"2",
+		"3"
+	});
+
+	CountingResource resource;
+
+	{
+		CmdArgsInterface cmdArgsI(&resource);
+		cmdArgsI.SetCrashOnFail(false);
+		cmdArgsI.RegisterConstraint("--my_default", ParamConstraint::Require({ "peter" }));
+
+		// Exercise
+		cmdArgsI.Parse(C_Ify(args));
+
+		// Verify
+		REQUIRE(resource.numAllocations > 0);
+		REQUIRE(resource.bytesInUse > 0);
+		REQUIRE(cmdArgsI["--my_string"].GetString() == "billybob");
+		REQUIRE(cmdArgsI["--my_default"].GetString() == "peter");
+		REQUIRE(cmdArgsI["--my_num_list"].GetList().size() == 3);
+		REQUIRE(cmdArgsI["--my_num_list"].GetList()[2]->GetInt32() == 3);
+	}
+
+	// Everything has been given back
+	REQUIRE(resource.bytesInUse == 0);
+
+	return;
+}
+
+// Tests that parsing again releases the previous results, instead of piling them up
+TEST_CASE(__FILE__"/Reparse_Releases_Previous_Results", "[Arena]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--my_string",
+		"billybob"
+	});
+
+	CountingResource resource;
+	CmdArgsInterface cmdArgsI(&resource);
+	cmdArgsI.SetCrashOnFail(false);
+
+	cmdArgsI.Parse(C_Ify(args));
+	const std::size_t bytesAfterFirstParse = resource.bytesInUse;
+
+	// Exercise
+	for (int i = 0; i < 10; i++)
+		cmdArgsI.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(resource.bytesInUse <= bytesAfterFirstParse);
+	REQUIRE(cmdArgsI["--my_string"].GetString() == "billybob");
+
+	return;
+}
+
+// Tests that lists created by the parser do not own their values, but copies of them do, and outlive the next parse
+TEST_CASE(__FILE__"/Parsed_Lists_Live_In_Arena", "[Arena]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--my_str_list",
+		"apple",
+		"banana",
+		"--my_string",
+		"a string long enough to not be stored inline"
+	});
+
+	ArgList others({
+		"/my/fake/path/wahoo.out",
+		"--my_str_list",
+		"############",
+		"############",
+		"--my_string",
+		"##############################################"
+	});
+
+	// Exercise
+	CmdArgsInterface cmdArgsI(C_Ify(args));
+	cmdArgsI.SetCrashOnFail(false);
+
+	const ListValue& list = (const ListValue&)cmdArgsI["--my_str_list"];
+	Value* copy = list.Deepcopy();
+	Value* stringCopy = cmdArgsI["--my_string"].Deepcopy();
+
+	// Verify
+	REQUIRE_FALSE(list.IsOwning());
+	REQUIRE(((ListValue*)copy)->IsOwning());
+	REQUIRE(((StringValue*)stringCopy)->IsOwning());
+
+	// Exercise
+	// Overwrites the buffers the parsed values referenced
+	cmdArgsI.Parse(C_Ify(others));
+
+	// Verify
+	REQUIRE(copy->GetList()[1]->GetString() == "banana");
+	REQUIRE(copy->GetStringList()[0] == "apple");
+	REQUIRE(stringCopy->GetString() == "a string long enough to not be stored inline");
+
+	delete copy;
+	delete stringCopy;
+
+	return;
+}
+
+// Tests that the arena hands out properly aligned memory, and returns everything to upstream on release
+TEST_CASE(__FILE__"/Arena_Alignment_And_Release", "[Arena]")
+{
+	// Setup
+	CountingResource resource;
+	Internal::Arena arena(&resource);
+
+	// Exercise
+	for (std::size_t i = 0; i < 1000; i++)
+	{
+		const std::size_t alignment = (std::size_t)1 << (i % 5);
+		void* p = arena.allocate(i % 37 + 1, alignment);
+
+		// Verify
+		REQUIRE(((std::uintptr_t)p % alignment) == 0);
+	}
+
+	// Big allocations larger than any chunk have to work aswell
+	REQUIRE(arena.allocate(1024 * 1024) != nullptr);
+
+	arena.Release();
+	REQUIRE(resource.bytesInUse == 0);
+
+	return;
+}
+
+// Tests that a reset arena reuses its chunks, instead of requesting new ones
+TEST_CASE(__FILE__"/Arena_Reset_Keeps_Chunks", "[Arena]")
+{
+	// Setup
+	CountingResource resource;
+	Internal::Arena arena(&resource);
+
+	for (std::size_t i = 0; i < 1000; i++)
+		REQUIRE(arena.allocate(i % 37 + 1, 8) != nullptr);
+
+	const std::size_t numAllocations = resource.numAllocations;
+	const std::size_t capacity = arena.GetCapacity();
+
+	// Exercise
+	for (int round = 0; round < 10; round++)
+	{
+		arena.Reset();
+
+		for (std::size_t i = 0; i < 1000; i++)
+			REQUIRE(arena.allocate(i % 37 + 1, 8) != nullptr);
+	}
+
+	// Verify
+	REQUIRE(resource.numAllocations == numAllocations);
+	REQUIRE(arena.GetCapacity() == capacity);
+
+	// A request bigger than any kept chunk still works, and keeps the old chunks
+	arena.Reset();
+	REQUIRE(arena.allocate(1024 * 1024) != nullptr);
+	REQUIRE(arena.GetCapacity() > capacity + 1024 * 1024);
+
+	arena.Release();
+	REQUIRE(resource.bytesInUse == 0);
+	REQUIRE(arena.GetCapacity() == 0);
+
+	return;
+}
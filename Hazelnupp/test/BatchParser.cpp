@@ -0,0 +1,148 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/BatchParser.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+using namespace Hazelnp;
+
+// Tests that a batch yields results, and per-item errors, in input order, regardless of the amount of workers
+TEST_CASE(__FILE__"/Results_In_Input_Order", "[BatchParser]")
+{
+	// Setup
+	Schema schema;
+	schema.RegisterAbbreviation("-w", "--width");
+	const ParamHandle<long long int> width = schema.RegisterParameter<long long int>("--width", ParamConstraint::Require());
+	schema.Freeze();
+
+	// Every seventh command line misses its required width
+	std::vector<std::string> widths;
+	std::vector<ArgList> commandLines;
+	for (std::size_t i = 0; i < 1000; i++)
+		widths.push_back(std::to_string(i));
+
+	for (std::size_t i = 0; i < widths.size(); i++)
+		if (i % 7 == 0)
+			commandLines.push_back(ArgList({ "/my/fake/path/wahoo.out", "--name", "billybob" }));
+		else
+			commandLines.push_back(ArgList({ "/my/fake/path/wahoo.out", "-w", widths[i].c_str() }));
+
+	std::vector<ArgVector> batch;
+	for (const ArgList& commandLine : commandLines)
+		batch.push_back({ (int)commandLine.size(), commandLine.data() });
+
+	for (const std::size_t numThreads : { 1, 2, 3, 8 })
+	{
+		BatchParser parser(schema, numThreads);
+
+		// Exercise
+		const std::vector<BatchItem> outcomes = parser.Parse(batch);
+
+		// Verify
+		REQUIRE(parser.GetNumThreads() == numThreads);
+		REQUIRE(outcomes.size() == batch.size());
+
+		for (std::size_t i = 0; i < outcomes.size(); i++)
+			if (i % 7 == 0)
+			{
+				REQUIRE_FALSE(outcomes[i].Succeeded());
+				REQUIRE(outcomes[i].result == nullptr);
+				REQUIRE_THROWS_AS(std::rethrow_exception(outcomes[i].error), HazelnuppConstraintMissingValue);
+			}
+			else
+			{
+				REQUIRE(outcomes[i].Succeeded());
+				REQUIRE(outcomes[i].error == nullptr);
+				REQUIRE((*outcomes[i].result)[width] == (long long int)i);
+			}
+	}
+
+	return;
+}
+
+// Tests that a parser can be reused for several batches, and copes with empty ones
+TEST_CASE(__FILE__"/Several_Batches", "[BatchParser]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--name",
+		"billybob"
+	});
+
+	Schema schema;
+	schema.Freeze();
+
+	BatchParser parser(schema, 4);
+	parser.SetBorrowArgv(true);
+
+	// Exercise
+	REQUIRE(parser.Parse(nullptr, 0).empty());
+
+	for (std::size_t size = 1; size < 50; size++)
+	{
+		const std::vector<ArgVector> batch(size, ArgVector { (int)args.size(), args.data() });
+		const std::vector<BatchItem> outcomes = parser.Parse(batch);
+
+		// Verify
+		REQUIRE(outcomes.size() == size);
+		for (const BatchItem& outcome : outcomes)
+		{
+			REQUIRE(outcome.Succeeded());
+			REQUIRE(outcome.result->GetBorrowArgv());
+			REQUIRE(outcome.result->operator[]("--name").GetStringView().data() == args[2]);
+		}
+	}
+
+	return;
+}
+
+// Tests that parsing against a schema that is not frozen throws
+TEST_CASE(__FILE__"/Requires_Frozen_Schema", "[BatchParser]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out"
+	});
+
+	Schema schema;
+	BatchParser parser(schema, 2);
+	const std::vector<ArgVector> batch(3, ArgVector { (int)args.size(), args.data() });
+
+	// Exercise, Verify
+	REQUIRE_THROWS_AS(parser.Parse(batch), HazelnuppException);
+
+	schema.Freeze();
+	REQUIRE(parser.Parse(batch).size() == 3);
+
+	return;
+}
+
+// Tests that the pool runs every task exactly once, even if the tasks are very uneven
+TEST_CASE(__FILE__"/Pool_Runs_Every_Task_Once", "[BatchParser]")
+{
+	// Setup
+	Internal::WorkStealingPool pool(4);
+	std::vector<std::atomic<int>> runs(10000);
+
+	// Exercise
+	for (std::size_t round = 0; round < 3; round++)
+		pool.Run(runs.size(), [&](std::size_t i)
+			{
+				// The first tasks take way longer than all others, so their worker gets robbed
+				volatile std::size_t sink = 0;
+				for (std::size_t j = 0; j < ((i < 100) ? 20000 : 10); j++)
+					sink = sink + j;
+
+				runs[i]++;
+				return;
+			});
+
+	// Verify
+	for (const std::atomic<int>& count : runs)
+		REQUIRE(count == 3);
+
+	return;
+}
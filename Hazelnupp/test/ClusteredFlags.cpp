@@ -0,0 +1,262 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <string>
+#include <vector>
+
+using namespace Hazelnp;
+
+namespace
+{
+	// Will register the flags of ls -ltr, and some taking values
+	void RegisterFlags(Schema& schema)
+	{
+		schema.RegisterAbbreviation("-l", "--long");
+		schema.RegisterAbbreviation("-t", "--time");
+		schema.RegisterAbbreviation("-r", "--reverse");
+		schema.RegisterAbbreviation("-o", "--output");
+		schema.RegisterAbbreviation("-O", "--optimize");
+		schema.RegisterAbbreviation("-I", "--include");
+		schema.RegisterAbbreviation("-ms", "--my_string");
+
+		schema.RegisterConstraint("--output", ParamConstraint::TypeSafety(DATA_TYPE::STRING));
+		schema.RegisterConstraint("--optimize", ParamConstraint::TypeSafety(DATA_TYPE::INT));
+		schema.RegisterConstraint("--include", ParamConstraint::RepeatPolicy(REPEAT_POLICY::APPEND));
+
+		return;
+	}
+}
+
+// Tests that clusters of single character abbreviations expand into each of them
+TEST_CASE(__FILE__"/Clusters", "[ClusteredFlags]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out", "-ltr", "--files", "a.txt", "-ms", "billy" });
+
+	Schema schema;
+	RegisterFlags(schema);
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result.HasParam("--long"));
+	REQUIRE(result.HasParam("--time"));
+	REQUIRE(result["--reverse"].GetDataType() == DATA_TYPE::VOID);
+	REQUIRE(result["--files"].GetStringView() == "a.txt");
+
+	// Longer abbreviations still expand as a whole
+	REQUIRE(result["--my_string"].GetStringView() == "billy");
+
+	return;
+}
+
+// Tests that the first flag of a cluster taking values takes the rest of the cluster as its value
+TEST_CASE(__FILE__"/Attached_Values", "[ClusteredFlags]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out", "-O2", "-lofile.txt", "-I/usr/include", "-I", "vendor" });
+
+	Schema schema;
+	RegisterFlags(schema);
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result["--optimize"].GetInt64() == 2);
+	REQUIRE(result.HasParam("--long"));
+	REQUIRE(result["--output"].GetStringView() == "file.txt");
+
+	const Span<const std::string_view> include = result["--include"].GetStringList();
+	REQUIRE(std::vector<std::string>(include.begin(), include.end()) == std::vector<std::string>({ "/usr/include", "vendor" }));
+
+	// Exercise
+	// The last flag of a cluster takes the next arg, just like a lonely one
+	ArgList separate({ "/my/fake/path/wahoo.out", "-lo", "file.txt" });
+	result.Parse(C_Ify(separate));
+
+	// Verify
+	REQUIRE(result.HasParam("--long"));
+	REQUIRE(result["--output"].GetStringView() == "file.txt");
+
+	return;
+}
+
+// Tests that args which only look like abbreviations, or clusters of them, are left alone
+TEST_CASE(__FILE__"/Values_Are_Not_Expanded", "[ClusteredFlags]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out",
+		"--numbers", "-5", "-lx", "-lt",
+		"--output", "-l",
+		"--name", "-ltr",
+		"-o", "-t"
+	});
+
+	Schema schema;
+	RegisterFlags(schema);
+	schema.RegisterConstraint("--name", ParamConstraint::TypeSafety(DATA_TYPE::STRING));
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	// Not every character is a flag, so these are values
+	REQUIRE(result["--numbers"].GetList().size() == 2);
+	REQUIRE(result["--numbers"].GetList()[0]->GetInt64() == -5);
+	REQUIRE(result["--numbers"].GetList()[1]->GetStringView() == "-lx");
+	REQUIRE(result.HasParam("--long"));
+	REQUIRE(result.HasParam("--time"));
+
+	// The arg following a key taking exactly one value is its value
+	REQUIRE(result["--output"].GetStringView() == "-l");
+	REQUIRE(result["--name"].GetStringView() == "-ltr");
+	REQUIRE_FALSE(result.HasParam("--reverse"));
+
+	return;
+}
+
+// Tests that abbreviations beginning with "--" get expanded even following a key taking exactly one value, as they are keys aswell
+TEST_CASE(__FILE__"/Keys_Are_Always_Expanded", "[ClusteredFlags]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out", "--name", "--v", "--output", "-ms" });
+
+	Schema schema;
+	RegisterFlags(schema);
+	schema.RegisterAbbreviation("--v", "--verbose");
+	schema.RegisterConstraint("--name", ParamConstraint::TypeSafety(DATA_TYPE::STRING));
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result.HasParam("--name"));
+	REQUIRE(result.HasParam("--verbose"));
+	REQUIRE_FALSE(result.HasParam("--v"));
+
+	// Others following such a key are its value
+	REQUIRE(result["--output"].GetStringView() == "-ms");
+	REQUIRE_FALSE(result.HasParam("--my_string"));
+
+	return;
+}
+
+// Tests that the flags of a static schema may be clustered aswell, and take precedence
+TEST_CASE(__FILE__"/Static_Schema", "[ClusteredFlags]")
+{
+	// Setup
+	static constexpr ParamSpec specs[] = {
+		ParamSpec("--verbose").AddAbbreviation("-v"),
+		ParamSpec("--jobs").AddAbbreviation("-j").AddTypeSafety(DATA_TYPE::INT),
+		ParamSpec("--quiet").AddAbbreviation("-qq")
+	};
+	static constexpr StaticSchema staticSchema(specs);
+
+	ArgList args({ "/my/fake/path/wahoo.out", "-vlj8", "-qq" });
+
+	CmdArgsInterface cmdArgsI(staticSchema);
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.RegisterAbbreviation("-l", "--long");
+	cmdArgsI.RegisterAbbreviation("-v", "--very");
+
+	// Exercise
+	cmdArgsI.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(cmdArgsI.HasParam("--verbose"));
+	REQUIRE_FALSE(cmdArgsI.HasParam("--very"));
+	REQUIRE(cmdArgsI.HasParam("--long"));
+	REQUIRE(cmdArgsI["--jobs"].GetInt64() == 8);
+	REQUIRE(cmdArgsI.HasParam("--quiet"));
+
+	return;
+}
+
+// Tests that clusters get expanded within streams, and that the callers buffer may be reused right away
+TEST_CASE(__FILE__"/Streaming", "[ClusteredFlags]")
+{
+	// Setup
+	Schema schema;
+	RegisterFlags(schema);
+	schema.RegisterConstraint("--name", ParamConstraint::TypeSafety(DATA_TYPE::STRING));
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.BeginStream("/my/fake/path/wahoo.out");
+	for (const char* token : { "-ltofile.txt", "-o", "-r", "-O3", "--name", "-r" })
+	{
+		std::string buffer = token;
+		result.Push(buffer);
+		buffer.assign(buffer.length(), '#');
+	}
+	result.EndStream();
+
+	// Verify
+	REQUIRE(result.HasParam("--long"));
+	REQUIRE(result.HasParam("--time"));
+	REQUIRE(result["--output"].GetStringView() == "file.txt");
+	REQUIRE_FALSE(result.HasParam("--reverse"));
+	REQUIRE(result["--optimize"].GetInt64() == 3);
+	REQUIRE(result["--name"].GetStringView() == "-r");
+
+	return;
+}
+
+// Tests that the flags follow changes to the abbreviations and constraints they stem from
+TEST_CASE(__FILE__"/Schema_Changes", "[ClusteredFlags]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out", "-xy" });
+
+	Schema schema;
+	schema.RegisterAbbreviation("-x", "--extract");
+	schema.RegisterAbbreviation("-y", "--yes");
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result.HasParam("--extract"));
+	REQUIRE(result.HasParam("--yes"));
+
+	// Exercise
+	// Now -x takes a value, so y is its value
+	schema.RegisterConstraint("--extract", ParamConstraint::TypeSafety(DATA_TYPE::STRING));
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result["--extract"].GetStringView() == "y");
+	REQUIRE_FALSE(result.HasParam("--yes"));
+
+	// Exercise
+	schema.ClearConstraint("--extract");
+	schema.ClearAbbreviation("-y");
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE_FALSE(result.HasParam("--extract"));
+	REQUIRE(schema.GetAbbreviation("-x") == "--extract");
+
+	// Exercise
+	schema.ClearAbbreviations();
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE_FALSE(result.HasParam("--extract"));
+
+	return;
+}
@@ -0,0 +1,226 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <string>
+
+using namespace Hazelnp;
+
+// Tests that keys, sections, scalars, arrays, booleans and comments get read like arguments would
+TEST_CASE(__FILE__"/Parses_Config_File", "[ConfigFiles]")
+{
+	// Setup
+	const std::string contents =
+		"# Leading comment\n"
+		"; Another one\n"
+		"width = 800\n"
+		"--ratio=1.5 # trailing comment\n"
+		"name = billy bob\n"
+		"quoted = \"esc\\\"aped\\tvalue\" ; trailing comment\n"
+		"literal = 'C:\\path'\n"
+		"hash = mid#hash\n"
+		"empty =\n"
+		"verbose = true\n"
+		"quiet = false\n"
+		"\r\n"
+		"[render]\r\n"
+		"sizes = [1, 2,\n"
+		"    3, # comment within an array\n"
+		"]\n"
+		"names = [\"billy\", 'bob', joe ]\n";
+
+	const std::string path = WriteTestFile("config.ini", contents);
+
+	ArgList args({ "/my/fake/path/wahoo.out" });
+
+	const Schema schema;
+	ParseResult result(schema);
+	result.LoadConfigFile(path);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result["--width"].GetInt64() == 800);
+	REQUIRE(result["--ratio"].GetFloat64() == 1.5);
+	REQUIRE(result["--name"].GetStringView() == "billy bob");
+	REQUIRE(result["--quoted"].GetStringView() == "esc\"aped\tvalue");
+	REQUIRE(result["--literal"].GetStringView() == "C:\\path");
+	REQUIRE(result["--hash"].GetStringView() == "mid#hash");
+	REQUIRE(result["--empty"].GetDataType() == DATA_TYPE::VOID);
+	REQUIRE(result["--verbose"].GetDataType() == DATA_TYPE::VOID);
+	REQUIRE_FALSE(result.HasParam("--quiet"));
+
+	const Span<const long long int> sizes = result["--render.sizes"].GetIntList();
+	REQUIRE(std::vector<long long int>(sizes.begin(), sizes.end()) == std::vector<long long int>({ 1, 2, 3 }));
+
+	const Span<const std::string_view> names = result["--render.names"].GetStringList();
+	REQUIRE(names.size() == 3);
+	REQUIRE(names[0] == "billy");
+	REQUIRE(names[1] == "bob");
+	REQUIRE(names[2] == "joe");
+
+	// Unescaping in place must never write through to the file
+	REQUIRE(ReadTestFile(path) == contents);
+
+	return;
+}
+
+// Tests that the command line beats the environment, which beats config files, which beat default values
+TEST_CASE(__FILE__"/Precedence", "[ConfigFiles]")
+{
+	// Setup
+	const std::string base = WriteTestFile("base.toml", "a = base\nb = base\nc = base\nd = base\n");
+	const std::string local = WriteTestFile("local.toml", "a = local\nb = local\n");
+	const char* const environment[] = { "APP_C=environment", "APP_B=environment", nullptr };
+
+	ArgList args({ "/my/fake/path/wahoo.out", "--b", "argv" });
+
+	Schema schema;
+	schema.RegisterEnvironmentVariable("--b", "APP_B");
+	schema.RegisterEnvironmentVariable("--c", "APP_C");
+	schema.RegisterConstraint("--e", ParamConstraint::Require({ "default" }));
+	schema.RegisterConstraint("--d", ParamConstraint::Require({ "default" }));
+
+	ParseResult result(schema);
+	result.SetEnvironment(environment);
+	result.LoadConfigFile(base);
+	result.LoadConfigFile(local);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result["--b"].GetStringView() == "argv");
+	REQUIRE(result.GetSource("--b") == PARAM_SOURCE::COMMAND_LINE);
+	REQUIRE(result.GetOrigin("--b").empty());
+
+	REQUIRE(result["--c"].GetStringView() == "environment");
+	REQUIRE(result.GetSource("--c") == PARAM_SOURCE::ENVIRONMENT);
+	REQUIRE(result.GetOrigin("--c") == "APP_C");
+
+	// The file loaded last takes precedence
+	REQUIRE(result["--a"].GetStringView() == "local");
+	REQUIRE(result.GetSource("--a") == PARAM_SOURCE::CONFIG_FILE);
+	REQUIRE(result.GetOrigin("--a") == local);
+
+	REQUIRE(result["--d"].GetStringView() == "base");
+	REQUIRE(result.GetOrigin("--d") == base);
+
+	REQUIRE(result["--e"].GetStringView() == "default");
+	REQUIRE(result.GetSource("--e") == PARAM_SOURCE::DEFAULT_VALUE);
+
+	REQUIRE_THROWS_AS(result.GetSource("--f"), HazelnuppInvalidKeyException);
+
+	return;
+}
+
+// Tests that constraints get enforced over the merged result, just like over the command line
+TEST_CASE(__FILE__"/Constraints", "[ConfigFiles]")
+{
+	// Setup
+	const std::string path = WriteTestFile("constraints.ini", "width = 800\nname = 5\nforce =\n");
+	ArgList args({ "/my/fake/path/wahoo.out" });
+
+	Schema schema;
+	schema.RegisterConstraint("--width", ParamConstraint::Require().AddTypeSafety(DATA_TYPE::FLOAT));
+	const ParamHandle<std::string> name = schema.RegisterParameter<std::string>("--name");
+
+	ParseResult result(schema);
+	result.LoadConfigFile(path);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	// Required parameters may be supplied by config files, and type constraints apply
+	REQUIRE(result["--width"].GetDataType() == DATA_TYPE::FLOAT);
+	REQUIRE(result[name] == "5");
+	REQUIRE(result.GetSource(name) == PARAM_SOURCE::CONFIG_FILE);
+
+	// Exercise, Verify
+	// Incompatibilities apply across sources
+	ArgList gentle({ "/my/fake/path/wahoo.out", "--gentle" });
+	schema.RegisterConstraint("--gentle", ParamConstraint::Incompatibility("--force"));
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(gentle)), HazelnuppConstraintIncompatibleParameters);
+
+	schema.RegisterConstraint("--width", ParamConstraint::TypeSafety(DATA_TYPE::LIST));
+	schema.RegisterConstraint("--name", ParamConstraint::TypeSafety(DATA_TYPE::INT));
+	REQUIRE_NOTHROW(result.Parse(C_Ify(args)));
+	REQUIRE(result["--width"].GetIntList()[0] == 800);
+
+	schema.RegisterConstraint("--force", ParamConstraint::TypeSafety(DATA_TYPE::INT));
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(args)), HazelnuppConstraintTypeMissmatch);
+
+	return;
+}
+
+// Tests that keys of the static schema land in its slots, and that values survive parsing again
+TEST_CASE(__FILE__"/Static_Schema_And_Reparse", "[ConfigFiles]")
+{
+	// Setup
+	static constexpr ParamSpec specs[] = {
+		ParamSpec("--depth").AddTypeSafety(DATA_TYPE::INT).AddRequire()
+	};
+	static constexpr StaticSchema staticSchema(specs);
+
+	const std::string path = WriteTestFile("static.ini", "depth = 0x20\n");
+	ArgList args({ "/my/fake/path/wahoo.out" });
+
+	CmdArgsInterface cmdArgsI(staticSchema);
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.LoadConfigFile(path);
+
+	// Exercise
+	cmdArgsI.Parse(C_Ify(args));
+	cmdArgsI.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(cmdArgsI["--depth"].GetInt64() == 32);
+	REQUIRE(cmdArgsI.GetSource("--depth") == PARAM_SOURCE::CONFIG_FILE);
+
+	// Exercise, Verify
+	cmdArgsI.ClearConfigFiles();
+	REQUIRE_FALSE(cmdArgsI.HasParam("--depth"));
+	REQUIRE_THROWS_AS(cmdArgsI.Parse(C_Ify(args)), HazelnuppConstraintMissingValue);
+
+	return;
+}
+
+// Tests that malformed or missing files are reported with their path and line
+TEST_CASE(__FILE__"/Malformed_Files", "[ConfigFiles]")
+{
+	// Setup
+	const Schema schema;
+	ParseResult result(schema);
+
+	const auto Load = [&](const std::string& name, const std::string& contents)
+	{
+		result.LoadConfigFile(WriteTestFile(name, contents));
+		return;
+	};
+
+	// Exercise, Verify
+	REQUIRE_THROWS_AS(Load("no_value.ini", "a = 1\njust a key\n"), HazelnuppConfigFileException);
+	REQUIRE_THROWS_AS(Load("no_key.ini", " = 1\n"), HazelnuppConfigFileException);
+	REQUIRE_THROWS_AS(Load("quote.ini", "a = \"unterminated\nb = 1\n"), HazelnuppConfigFileException);
+	REQUIRE_THROWS_AS(Load("array.ini", "a = [1, 2\n"), HazelnuppConfigFileException);
+	REQUIRE_THROWS_AS(Load("element.ini", "a = [1,, 2]\n"), HazelnuppConfigFileException);
+	REQUIRE_THROWS_AS(Load("trailing.ini", "a = \"quoted\" trailing\n"), HazelnuppConfigFileException);
+	REQUIRE_THROWS_AS(Load("section.ini", "[render\n"), HazelnuppConfigFileException);
+	REQUIRE_THROWS_AS(result.LoadConfigFile("/this/file/does/not/exist.ini"), HazelnuppConfigFileException);
+
+	try
+	{
+		Load("line.ini", "# Comment\n\na = 1\n[b]\nc\n");
+	}
+	catch (const HazelnuppConfigFileException& e)
+	{
+		REQUIRE(e.What().find("line.ini\" (line 5)") != std::string::npos);
+	}
+
+	// Empty files are fine
+	REQUIRE_NOTHROW(Load("empty.ini", ""));
+
+	return;
+}
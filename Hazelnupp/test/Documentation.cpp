@@ -0,0 +1,162 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+using namespace Hazelnp;
+
+namespace
+{
+	// Will register a few parameters, in no particular order
+	void RegisterParameters(Schema& schema)
+	{
+		schema.SetBriefDescription("Does things.");
+		schema.RegisterDescription("--width", "The width of the output, in pixels");
+		schema.RegisterAbbreviation("-w", "--width");
+		schema.RegisterConstraint("--width", ParamConstraint(true, DATA_TYPE::INT, { "800" }, false, {}));
+		schema.RegisterConstraint("--force", ParamConstraint::Incompatibility("--gentle"));
+		schema.RegisterDescription("--alpha", "Comes first");
+		schema.RegisterConstraint("--name", ParamConstraint::Require());
+
+		return;
+	}
+}
+
+// Tests that the documentation is sorted by key, and the same every time
+TEST_CASE(__FILE__"/Sorted_Documentation", "[Documentation]")
+{
+	// Setup
+	Schema schema;
+	RegisterParameters(schema);
+
+	// Exercise
+	const std::string& docs = schema.GenerateDocumentation();
+
+	// Verify
+	REQUIRE(docs ==
+		"Does things.\n"
+		"\n==== AVAILABLE PARAMETERS ====\n\n"
+		"--alpha   Comes first\n\n"
+		"--force   incompatibilities=[--gentle]   \n\n"
+		"--name   [[REQUIRED]]    \n\n"
+		"--width   -w   INT   default=['800']   The width of the output, in pixels"
+	);
+
+	return;
+}
+
+// Tests that the documentation is rendered once, and again only after something changed
+TEST_CASE(__FILE__"/Cached_Documentation", "[Documentation]")
+{
+	// Setup
+	Schema schema;
+	RegisterParameters(schema);
+
+	// Exercise, Verify
+	const std::string& docs = schema.GenerateDocumentation();
+	const char* const rendered = docs.data();
+	REQUIRE(schema.GenerateDocumentation().data() == rendered);
+
+	schema.RegisterDescription("--force", "Do it forcefully");
+	REQUIRE(schema.GenerateDocumentation().find("--force   incompatibilities=[--gentle]   Do it forcefully") != std::string::npos);
+
+	schema.ClearAbbreviations();
+	REQUIRE(schema.GenerateDocumentation().find("--width   INT") != std::string::npos);
+
+	// Freezing renders it right away, and it can not change anymore
+	schema.Freeze();
+	const std::string frozen = schema.GenerateDocumentation();
+	REQUIRE(schema.GenerateDocumentation() == frozen);
+	REQUIRE_THROWS_AS(schema.SetDocumentationWidth(40), HazelnuppException);
+
+	return;
+}
+
+// Tests that lines get wrapped at the documentation width, and continued lines indented
+TEST_CASE(__FILE__"/Wrapped_Documentation", "[Documentation]")
+{
+	// Setup
+	Schema schema;
+	RegisterParameters(schema);
+	schema.RegisterDescription("--long", "Averyveryveryveryveryverylongword fits on no line at all");
+
+	// Exercise
+	schema.SetDocumentationWidth(30);
+	const std::string& docs = schema.GenerateDocumentation();
+
+	// Verify
+	REQUIRE(docs.find(
+		"--width   -w   INT\n"
+		"    default=['800']   The\n"
+		"    width of the output, in\n"
+		"    pixels"
+	) != std::string::npos);
+
+	REQUIRE(docs.find(
+		"--long\n"
+		"    Averyveryveryveryveryverylongword\n"
+		"    fits on no line at all"
+	) != std::string::npos);
+
+	// Only single words too long for any line exceed the width, and no line ends with spaces
+	std::stringstream ss(docs);
+	std::string line;
+	while (std::getline(ss, line))
+	{
+		REQUIRE(((line.length() <= 30) || (line.find(' ', 4) == std::string::npos)));
+		REQUIRE(((line.empty()) || (line.back() != ' ')));
+	}
+
+	// Width 0 does not wrap
+	schema.SetDocumentationWidth(0);
+	REQUIRE(schema.GenerateDocumentation().find("--width   -w   INT   default=['800']   The width of the output, in pixels") != std::string::npos);
+
+	return;
+}
+
+// Tests that a single parameter can be documented, by key or abbreviation
+TEST_CASE(__FILE__"/Parameter_Documentation", "[Documentation]")
+{
+	// Setup
+	CmdArgsInterface cmdArgsI;
+	RegisterParameters(cmdArgsI.GetSchema());
+
+	// Exercise, Verify
+	const std::string expected = "--width   -w   INT   default=['800']   The width of the output, in pixels";
+	REQUIRE(cmdArgsI.GenerateParameterDocumentation("--width") == expected);
+	REQUIRE(cmdArgsI.GenerateParameterDocumentation("-w") == expected);
+	REQUIRE(cmdArgsI.GenerateParameterDocumentation("--alpha") == "--alpha   Comes first");
+	REQUIRE(cmdArgsI.GenerateParameterDocumentation("--gentle") == "");
+	REQUIRE(cmdArgsI.GenerateParameterDocumentation("--unknown") == "");
+
+	return;
+}
+
+// Tests that the documentation can be written straight to a file descriptor
+TEST_CASE(__FILE__"/Write_Documentation", "[Documentation]")
+{
+	// Setup
+	Schema schema;
+	RegisterParameters(schema);
+
+	std::FILE* file = std::tmpfile();
+	REQUIRE(file != nullptr);
+
+	// Exercise
+	REQUIRE(schema.WriteDocumentation(fileno(file)));
+
+	// Verify
+	std::rewind(file);
+	std::string written;
+	for (int c = std::fgetc(file); c != EOF; c = std::fgetc(file))
+		written += (char)c;
+
+	std::fclose(file);
+
+	REQUIRE(written == schema.GenerateDocumentation() + "\n");
+
+	return;
+}
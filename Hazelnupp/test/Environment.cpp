@@ -0,0 +1,245 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace Hazelnp;
+
+namespace
+{
+	// Like the envp of main()
+	const char* const g_environment[] = {
+		"HOME=/home/billybob",
+		"APP_WIDTH=1920",
+		"APP_NAME=billy bob",
+		"APP_SIZES= 1  2\t3 ",
+		"APP_EMPTY=",
+		"APP_WORDS=",
+		"APP_RATIO=wide",
+		"APP_WIDTH=1080",
+		"NOT_A_VARIABLE",
+		nullptr
+	};
+
+	constexpr std::string_view heightDefault[] = { "600" };
+
+	constexpr ParamSpec specs[] = {
+		ParamSpec("--height").AddTypeSafety(DATA_TYPE::INT).AddRequire(heightDefault).AddEnvironmentVariable("APP_HEIGHT"),
+		ParamSpec("--home").AddTypeSafety(DATA_TYPE::STRING).AddRequire().AddEnvironmentVariable("HOME")
+	};
+
+	constexpr StaticSchema staticSchema(specs);
+
+	// Will set a variable of the process environment. nullptr unsets it.
+	void SetProcessVariable(const char* name, const char* value)
+	{
+#ifdef _WIN32
+		_putenv_s(name, (value != nullptr) ? value : "");
+#else
+		if (value != nullptr)
+			setenv(name, value, 1);
+		else
+			unsetenv(name);
+#endif
+
+		return;
+	}
+}
+
+// Tests that values get taken from argv first, then from the environment, then from the default value
+TEST_CASE(__FILE__"/Fallback_Order", "[Environment]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out", "--name", "joe" });
+
+	Schema schema;
+	schema.RegisterEnvironmentVariable("--width", "APP_WIDTH");
+	schema.RegisterEnvironmentVariable("--name", "APP_NAME");
+	schema.RegisterEnvironmentVariable("--depth", "APP_DEPTH");
+	schema.RegisterConstraint("--width", ParamConstraint(true, DATA_TYPE::INT, { "800" }, false, {}));
+	schema.RegisterConstraint("--depth", ParamConstraint(true, DATA_TYPE::INT, { "32" }, false, {}));
+
+	ParseResult result(schema);
+	result.SetEnvironment(g_environment);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result["--name"].GetString() == "joe");
+	// The first occurrence counts, just like for getenv()
+	REQUIRE(result["--width"].GetInt64() == 1920);
+	REQUIRE(result["--depth"].GetInt64() == 32);
+
+	return;
+}
+
+// Tests that values of the environment get converted and constrained just like values of argv
+TEST_CASE(__FILE__"/Conversion_And_Constraints", "[Environment]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out" });
+
+	Schema schema;
+	schema.RegisterEnvironmentVariable("--sizes", "APP_SIZES");
+	schema.RegisterEnvironmentVariable("--name", "APP_NAME");
+	schema.RegisterEnvironmentVariable("--empty", "APP_EMPTY");
+	schema.RegisterEnvironmentVariable("--words", "APP_WORDS");
+	schema.RegisterEnvironmentVariable("--width", "APP_WIDTH");
+	schema.RegisterConstraint("--sizes", ParamConstraint::TypeSafety(DATA_TYPE::LIST));
+	schema.RegisterConstraint("--words", ParamConstraint::TypeSafety(DATA_TYPE::LIST));
+	schema.RegisterConstraint("--width", ParamConstraint::Require());
+
+	ParseResult result(schema);
+	result.SetEnvironment(g_environment);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	// Lists get split at whitespace. Anything else is one value.
+	const Span<const long long int> sizes = result["--sizes"].GetIntList();
+	REQUIRE(std::vector<long long int>(sizes.begin(), sizes.end()) == std::vector<long long int>({ 1, 2, 3 }));
+	REQUIRE(result["--name"].GetString() == "billy bob");
+
+	// Empty variables have no values
+	REQUIRE(result["--empty"].GetDataType() == DATA_TYPE::VOID);
+	REQUIRE(result["--words"].GetList().empty());
+
+	// Required parameters may be supplied by the environment
+	REQUIRE(result["--width"].GetInt64() == 1920);
+
+	// Exercise, Verify
+	schema.RegisterEnvironmentVariable("--ratio", "APP_RATIO");
+	schema.RegisterConstraint("--ratio", ParamConstraint::TypeSafety(DATA_TYPE::FLOAT));
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(args)), HazelnuppConstraintTypeMissmatch);
+
+	return;
+}
+
+// Tests that values of the environment count as present, and conflict with incompatible parameters supplied
+TEST_CASE(__FILE__"/Incompatibilities", "[Environment]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out", "--gentle" });
+
+	Schema schema;
+	schema.RegisterEnvironmentVariable("--width", "APP_WIDTH");
+	schema.RegisterConstraint("--gentle", ParamConstraint::Incompatibility("--width"));
+
+	ParseResult result(schema);
+	result.SetEnvironment(g_environment);
+
+	// Exercise, Verify
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(args)), HazelnuppConstraintIncompatibleParameters);
+
+	// Exercise
+	schema.RegisterConstraint("--gentle", ParamConstraint());
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result.HasParam("--gentle"));
+	REQUIRE(result.HasParam("--width"));
+
+	return;
+}
+
+// Tests that parameters of a static schema may be bound to environment variables aswell
+TEST_CASE(__FILE__"/Static_Schema", "[Environment]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out" });
+
+	Schema schema;
+	schema.SetStaticSchema(staticSchema);
+
+	ParseResult result(schema);
+	result.SetEnvironment(g_environment);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result["--home"].GetString() == "/home/billybob");
+	REQUIRE(result["--height"].GetInt64() == 600);
+
+	// Exercise, Verify
+	const char* const noHome[] = { "APP_HEIGHT=0x100", nullptr };
+	result.SetEnvironment(noHome);
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(args)), HazelnuppConstraintMissingValue);
+
+	return;
+}
+
+// Tests that the environment of the process is used by default, and read again on each parse
+TEST_CASE(__FILE__"/Process_Environment", "[Environment]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out" });
+
+	CmdArgsInterface cmdArgsI;
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.RegisterEnvironmentVariable("--threads", "HAZELNUPP_TEST_THREADS");
+	REQUIRE(cmdArgsI.GetEnvironment() == nullptr);
+
+	// Exercise
+	SetProcessVariable("HAZELNUPP_TEST_THREADS", "4");
+	cmdArgsI.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(cmdArgsI["--threads"].GetInt64() == 4);
+
+	// Exercise
+	SetProcessVariable("HAZELNUPP_TEST_THREADS", "8");
+	cmdArgsI.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(cmdArgsI["--threads"].GetInt64() == 8);
+
+	// Exercise
+	SetProcessVariable("HAZELNUPP_TEST_THREADS", nullptr);
+	cmdArgsI.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE_FALSE(cmdArgsI.HasParam("--threads"));
+
+	return;
+}
+
+// Tests that bindings can be queried, cleared, and show up in the documentation
+TEST_CASE(__FILE__"/Bindings", "[Environment]")
+{
+	// Setup
+	Schema schema;
+	schema.RegisterEnvironmentVariable("--width", "APP_WIDTH");
+	schema.RegisterConstraint("--width", ParamConstraint(true, DATA_TYPE::INT, { "800" }, false, {}));
+	schema.RegisterEnvironmentVariable("--name", "APP_NAME");
+
+	// Exercise, Verify
+	REQUIRE(schema.HasEnvironmentVariable("--width"));
+	REQUIRE(schema.GetEnvironmentVariable("--width") == "APP_WIDTH");
+	REQUIRE(schema.GenerateDocumentation() ==
+		"\n==== AVAILABLE PARAMETERS ====\n\n"
+		"--name   env=[APP_NAME]   \n\n"
+		"--width   INT   default=['800']   env=[APP_WIDTH]   "
+	);
+
+	// Exercise
+	schema.ClearEnvironmentVariable("--name");
+
+	// Verify
+	REQUIRE_FALSE(schema.HasEnvironmentVariable("--name"));
+	REQUIRE(schema.GetEnvironmentVariable("--name") == "");
+	REQUIRE(schema.GenerateParameterDocumentation("--name") == "");
+
+	// Exercise
+	schema.ClearEnvironmentVariables();
+
+	// Verify
+	REQUIRE_FALSE(schema.HasEnvironmentVariable("--width"));
+
+	return;
+}
@@ -0,0 +1,128 @@
+#include "Catch2.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/HazelnuppException.h>
+
+using namespace Hazelnp;
+
+// Tests that registering a parameter returns a handle, that reads the parsed value
+TEST_CASE(__FILE__"/Read_Through_Handles", "[Handles]")
+{
+	// Setup
+	const char* argv[] = {
+		"/my/fake/path/wahoo.out",
+		"--width",
+		"800",
+		"--ratio",
+		"2",
+		"--name",
+		"billybob",
+		"--force"
+	};
+
+	CmdArgsInterface cmdArgsI;
+	cmdArgsI.SetCrashOnFail(false);
+
+	const ParamHandle<long long int> width = cmdArgsI.RegisterParameter<long long int>("--width");
+	const ParamHandle<double> ratio = cmdArgsI.RegisterParameter<double>("--ratio");
+	const ParamHandle<std::string_view> name = cmdArgsI.RegisterParameter<std::string_view>("--name");
+	const ParamHandle<void> force = cmdArgsI.RegisterParameter<void>("--force");
+	const ParamHandle<int> height = cmdArgsI.RegisterParameter<int>("--height", ParamConstraint::Require({ "600" }));
+	const ParamHandle<std::string> missing = cmdArgsI.RegisterParameter<std::string>("--missing");
+
+	// Exercise
+	cmdArgsI.Parse(sizeof(argv) / sizeof(*argv), argv);
+
+	// Verify
+	REQUIRE(cmdArgsI[width] == 800);
+	REQUIRE(cmdArgsI[ratio] == 2.0);
+	REQUIRE(cmdArgsI[name] == "billybob");
+	REQUIRE(cmdArgsI.HasParam(force));
+	REQUIRE(cmdArgsI[height] == 600);
+
+	REQUIRE_FALSE(cmdArgsI.HasParam(missing));
+	REQUIRE_THROWS_AS(cmdArgsI[missing], HazelnuppInvalidKeyException);
+
+	// The type-safety constraint got applied
+	REQUIRE(cmdArgsI["--ratio"].GetDataType() == DATA_TYPE::FLOAT);
+
+	return;
+}
+
+// Tests that handles can be acquired for existing registrations, and for the static schema
+TEST_CASE(__FILE__"/Acquire_Handles", "[Handles]")
+{
+	// Setup
+	static constexpr ParamSpec specs[] = {
+		ParamSpec("--depth").AddTypeSafety(DATA_TYPE::INT),
+		ParamSpec("--untyped")
+	};
+	static constexpr StaticSchema schema(specs);
+
+	const char* argv[] = {
+		"/my/fake/path/wahoo.out",
+		"--depth",
+		"3",
+		"--label",
+		"hi"
+	};
+
+	CmdArgsInterface cmdArgsI(schema);
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.RegisterConstraint("--label", ParamConstraint::TypeSafety(DATA_TYPE::STRING));
+
+	// Exercise
+	const ParamHandle<long long int> depth = cmdArgsI.GetHandle<long long int>("--depth");
+	const ParamHandle<std::string> label = cmdArgsI.GetHandle<std::string>("--label");
+
+	// Re-registering must not invalidate the handle
+	cmdArgsI.RegisterConstraint("--label", ParamConstraint::TypeSafety(DATA_TYPE::STRING).AddRequire());
+
+	cmdArgsI.Parse(sizeof(argv) / sizeof(*argv), argv);
+
+	// Verify
+	REQUIRE(cmdArgsI[depth] == 3);
+	REQUIRE(cmdArgsI[label] == "hi");
+
+	// Wrong type, no type constraint, or not registered at all
+	REQUIRE_THROWS_AS(cmdArgsI.GetHandle<std::string>("--depth"), HazelnuppException);
+	REQUIRE_THROWS_AS(cmdArgsI.GetHandle<int>("--untyped"), HazelnuppException);
+	REQUIRE_THROWS_AS(cmdArgsI.GetHandle<int>("--unknown"), HazelnuppException);
+
+	// Invalid handles read nothing
+	const ParamHandle<int> invalid;
+	REQUIRE_FALSE(invalid.IsValid());
+	REQUIRE_FALSE(cmdArgsI.HasParam(invalid));
+
+	return;
+}
+
+// Tests that handles issued after a parse work on the next one
+TEST_CASE(__FILE__"/Handles_Across_Parses", "[Handles]")
+{
+	// Setup
+	const char* argv[] = {
+		"/my/fake/path/wahoo.out",
+		"--a",
+		"1",
+		"--b",
+		"2"
+	};
+
+	CmdArgsInterface cmdArgsI;
+	cmdArgsI.SetCrashOnFail(false);
+	const ParamHandle<int> a = cmdArgsI.RegisterParameter<int>("--a");
+	cmdArgsI.Parse(sizeof(argv) / sizeof(*argv), argv);
+
+	// Exercise
+	const ParamHandle<int> b = cmdArgsI.RegisterParameter<int>("--b");
+
+	// Verify
+	REQUIRE(cmdArgsI[a] == 1);
+	REQUIRE_FALSE(cmdArgsI.HasParam(b)); // Not parsed yet
+
+	cmdArgsI.Parse(sizeof(argv) / sizeof(*argv), argv);
+	REQUIRE(cmdArgsI[a] == 1);
+	REQUIRE(cmdArgsI[b] == 2);
+
+	return;
+}
@@ -0,0 +1,143 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/ParseResult.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <string>
+#include <vector>
+
+using namespace Hazelnp;
+
+namespace
+{
+	// Will build a schema with thousands of options. Every third is required, every fifth has a default value,
+	// and every seventh is incompatible with its successor.
+	void BuildHugeSchema(Schema& schema, std::vector<std::string>& keys)
+	{
+		for (std::size_t i = 0; i < 3000; i++)
+			keys.push_back("--option-" + std::to_string(i));
+
+		for (std::size_t i = 0; i < keys.size(); i++)
+		{
+			ParamConstraint constraint;
+			constraint.required = i % 3 == 0;
+			if (i % 5 == 0)
+				constraint.defaultValue = { std::to_string(i) };
+			if (i % 7 == 0)
+				constraint.incompatibleParameters = { keys[i + 1] };
+
+			schema.RegisterConstraint(keys[i], constraint);
+		}
+
+		return;
+	}
+}
+
+// Tests that required, default and incompatibility checks work across thousands of constraints
+TEST_CASE(__FILE__"/Huge_Schema", "[IndexedConstraints]")
+{
+	// Setup
+	Schema schema;
+	std::vector<std::string> keys;
+	BuildHugeSchema(schema, keys);
+	schema.Freeze();
+
+	// Supply all required ones without a default, and none incompatible
+	ArgList args({ "/my/fake/path/wahoo.out" });
+	for (std::size_t i = 0; i < keys.size(); i += 3)
+		if (i % 5 != 0)
+			args.push_back(keys[i].c_str());
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	for (std::size_t i = 0; i < keys.size(); i++)
+		if (i % 5 == 0)
+			REQUIRE(result[keys[i]].GetInt64() == (long long int)i);
+		else
+			REQUIRE(result.HasParam(keys[i]) == (i % 3 == 0));
+
+	// Drop the very last required one
+	args.pop_back();
+	try
+	{
+		result.Parse(C_Ify(args));
+		FAIL();
+	}
+	catch (const HazelnuppConstraintMissingValue& exc)
+	{
+		REQUIRE(exc.What().find(keys[2997]) != std::string::npos);
+	}
+
+	// Add an incompatible pair far down the id space
+	args.push_back(keys[2997].c_str());
+	args.push_back(keys[2996].c_str());
+	args.push_back(keys[2995].c_str());
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(args)), HazelnuppConstraintIncompatibleParameters);
+
+	return;
+}
+
+// Tests that parameters listed as incompatible count, even if they have no constraint themselves
+TEST_CASE(__FILE__"/Unconstrained_Incompatibility", "[IndexedConstraints]")
+{
+	// Setup
+	Schema schema;
+	schema.RegisterConstraint("--gentle", ParamConstraint::Incompatibility("--force"));
+	schema.Freeze();
+
+	ParseResult result(schema);
+
+	// Exercise, Verify
+	result.Parse(C_Ify(ArgList({ "/my/fake/path/wahoo.out", "--gentle", "--other" })));
+	result.Parse(C_Ify(ArgList({ "/my/fake/path/wahoo.out", "--force", "--other" })));
+
+	try
+	{
+		result.Parse(C_Ify(ArgList({ "/my/fake/path/wahoo.out", "--force", "--gentle" })));
+		FAIL();
+	}
+	catch (const HazelnuppConstraintIncompatibleParameters& exc)
+	{
+		REQUIRE(exc.What() == "Parameter \"--gentle\" is NOT compatible with parameter \"--force\"!");
+	}
+
+	return;
+}
+
+// Tests that ids stay the same when constraints get replaced, cleared and registered again, so that handles stay valid
+TEST_CASE(__FILE__"/Stable_Ids", "[IndexedConstraints]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--width",
+		"800"
+	});
+
+	Schema schema;
+	const ParamHandle<int> width = schema.RegisterParameter<int>("--width", ParamConstraint::Require());
+
+	// Exercise
+	schema.RegisterConstraint("--width", ParamConstraint::TypeSafety(DATA_TYPE::INT));
+	schema.ClearConstraints();
+	schema.RegisterConstraint("--other", ParamConstraint::Require({ "1" }));
+	const ParamHandle<int> again = schema.RegisterParameter<int>("--width", ParamConstraint::Require());
+
+	ParseResult result(schema);
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result[width] == 800);
+	REQUIRE(result[again] == 800);
+	REQUIRE(result["--other"].GetInt64() == 1);
+
+	// It is not required anymore, once cleared
+	schema.ClearConstraint("--width");
+	result.Parse(C_Ify(ArgList({ "/my/fake/path/wahoo.out" })));
+	REQUIRE_FALSE(result.HasParam(width));
+
+	return;
+}
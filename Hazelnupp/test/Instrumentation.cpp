@@ -0,0 +1,162 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <vector>
+
+using namespace Hazelnp;
+
+namespace
+{
+	// Will keep everything it gets passed
+	class CollectingSink : public InstrumentationSink
+	{
+	public:
+		void OnParse(const ParseStats& stats) override
+		{
+			parses.push_back(stats);
+			return;
+		}
+
+		void OnRenderDocumentation(const PhaseStats& stats) override
+		{
+			renderings.push_back(stats);
+			return;
+		}
+
+		std::vector<ParseStats> parses;
+		std::vector<PhaseStats> renderings;
+	};
+}
+
+// Tests that each phase of a parse gets recorded, and passed to the sink
+TEST_CASE(__FILE__"/Parse_Phases", "[Instrumentation]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"-f",
+		"--names",
+		"billy",
+		"bob",
+		"--depth",
+		"12"
+	});
+
+	Schema schema;
+	schema.RegisterAbbreviation("-f", "--force");
+	schema.RegisterConstraint("--width", ParamConstraint::Require({ "800" }));
+	schema.RegisterConstraint("--user", ParamConstraint::Require());
+	schema.Freeze();
+
+	CollectingSink sink;
+	ParseResult result(schema);
+	result.SetInstrumentationSink(&sink);
+
+	// Exercise
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(args)), HazelnuppConstraintMissingValue);
+
+	args.push_back("--user");
+	result.Parse(C_Ify(args));
+	result.Parse(C_Ify(args));
+
+	// Verify
+	if constexpr (!g_instrumentationEnabled)
+	{
+		// Nothing gets recorded at all
+		REQUIRE(sink.parses.empty());
+		REQUIRE(result.GetParseStats().duration.count() == 0);
+		REQUIRE(result.GetParseStats()[PARSE_PHASE::PARSE_VALUES].numTokens == 0);
+		return;
+	}
+
+	REQUIRE(sink.parses.size() == 3);
+	REQUIRE_FALSE(sink.parses[0].succeeded);
+	REQUIRE(sink.parses[1].succeeded);
+
+	const ParseStats& stats = result.GetParseStats();
+	REQUIRE(stats[PARSE_PHASE::POPULATE_RAW_ARGS].numTokens == 8);
+	REQUIRE(stats[PARSE_PHASE::EXPAND_ABBREVIATIONS].numTokens == 8);
+	REQUIRE(stats[PARSE_PHASE::PARSE_VALUES].numTokens == 7);
+	REQUIRE(stats[PARSE_PHASE::PARSE_VALUES].numValues == 4);
+	REQUIRE(stats[PARSE_PHASE::PARSE_VALUES].numAllocations > 0);
+	REQUIRE(stats[PARSE_PHASE::APPLY_CONSTRAINTS].numValues == 1);
+	REQUIRE(stats[PARSE_PHASE::RENDER_DOCUMENTATION].duration.count() == 0);
+
+	// The whole call takes at least as long as its phases
+	std::chrono::nanoseconds phases(0);
+	for (const PhaseStats& phase : stats.phases)
+		phases += phase.duration;
+	REQUIRE(stats.duration >= phases);
+
+	// Parsing again reuses the memory of the last parse
+	for (const PhaseStats& phase : stats.phases)
+		REQUIRE(phase.numUpstreamAllocations == 0);
+
+	return;
+}
+
+// Tests that streams get recorded aswell
+TEST_CASE(__FILE__"/Streams", "[Instrumentation]")
+{
+	// Setup
+	Schema schema;
+	schema.RegisterConstraint("--width", ParamConstraint::Require({ "800" }));
+	schema.Freeze();
+
+	CollectingSink sink;
+	ParseResult result(schema);
+	result.SetInstrumentationSink(&sink);
+
+	// Exercise
+	result.BeginStream();
+	result.PushChunk("--a\n1\n--b\n");
+	result.EndStream();
+
+	// Verify
+	if constexpr (!g_instrumentationEnabled)
+	{
+		REQUIRE(sink.parses.empty());
+		return;
+	}
+
+	REQUIRE(sink.parses.size() == 1);
+	REQUIRE(sink.parses[0].succeeded);
+	REQUIRE(sink.parses[0][PARSE_PHASE::APPLY_CONSTRAINTS].numValues == 1);
+
+	return;
+}
+
+// Tests that rendering the documentation gets recorded, but reading the cached one does not
+TEST_CASE(__FILE__"/Documentation", "[Instrumentation]")
+{
+	// Setup
+	CollectingSink sink;
+	CmdArgsInterface cmdArgsI;
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.SetInstrumentationSink(&sink);
+	cmdArgsI.RegisterDescription("--force", "Do it forcefully");
+	cmdArgsI.RegisterDescription("--width", "How wide");
+
+	// Exercise
+	cmdArgsI.GenerateDocumentation();
+	cmdArgsI.GenerateDocumentation();
+	cmdArgsI.Parse(C_Ify(ArgList({ "/my/fake/path/wahoo.out", "--force" })));
+
+	// Verify
+	REQUIRE(cmdArgsI.GetInstrumentationSink() == &sink);
+
+	if constexpr (!g_instrumentationEnabled)
+	{
+		REQUIRE(sink.renderings.empty());
+		REQUIRE(sink.parses.empty());
+		return;
+	}
+
+	REQUIRE(sink.renderings.size() == 1);
+	REQUIRE(sink.renderings[0].numValues == 2);
+	REQUIRE(sink.parses.size() == 1);
+	REQUIRE(cmdArgsI.GetParseStats()[PARSE_PHASE::PARSE_VALUES].numValues == 1);
+
+	return;
+}
@@ -0,0 +1,222 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/ParseResult.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Hazelnp;
+
+// Tests that lazily converted values end up just like eagerly converted ones
+TEST_CASE(__FILE__"/Same_As_Eager", "[Lazy]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--int", "-23",
+		"--float", "1.5e3",
+		"--string", "billybob",
+		"--void",
+		"--list", "1", "2.5", "three",
+		"--forced-int", "9.9",
+		"--forced-list", "single"
+	});
+
+	Schema schema;
+	schema.RegisterConstraint("--forced-int", ParamConstraint::TypeSafety(DATA_TYPE::INT));
+	schema.RegisterConstraint("--forced-list", ParamConstraint::TypeSafety(DATA_TYPE::LIST));
+	schema.Freeze();
+
+	ParseResult eager(schema);
+	ParseResult lazy(schema);
+	lazy.SetLazyConversion(true);
+
+	// Exercise
+	eager.Parse(C_Ify(args));
+	lazy.Parse(C_Ify(args));
+
+	// Verify
+	for (const char* key : { "--int", "--float", "--string", "--void", "--list", "--forced-int", "--forced-list" })
+	{
+		REQUIRE(lazy[key].GetDataType() == eager[key].GetDataType());
+		REQUIRE(lazy[key].GetAsOsString() == eager[key].GetAsOsString());
+	}
+
+	REQUIRE(lazy["--int"].GetInt64() == -23);
+	REQUIRE(lazy["--float"].GetFloat64() == 1500);
+	REQUIRE(lazy["--string"].GetStringView() == "billybob");
+	REQUIRE(lazy["--forced-int"].GetInt64() == 9);
+
+	// Lists are converted as a whole, on first access
+	const std::vector<Value*>& list = lazy["--list"].GetList();
+	REQUIRE(list.size() == 3);
+	REQUIRE(list[2]->GetString() == "three");
+	REQUIRE(list[0]->GetInt64() == 1);
+	REQUIRE(list[1]->GetDataType() == DATA_TYPE::FLOAT);
+
+	// Copies are converted aswell
+	const std::unique_ptr<Value> copy(lazy["--list"].Deepcopy());
+	REQUIRE(copy->GetList()[1]->GetFloat64() == 2.5);
+
+	return;
+}
+
+// Tests that type-constraint violations throw on access, or right away on Validate()
+TEST_CASE(__FILE__"/Deferred_Type_Errors", "[Lazy]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--depth",
+		"deep",
+		"--name",
+		"billybob"
+	});
+
+	Schema schema;
+	const ParamHandle<int> depth = schema.RegisterParameter<int>("--depth");
+	schema.Freeze();
+
+	ParseResult result(schema);
+	result.SetLazyConversion(true);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result["--name"].GetStringView() == "billybob");
+	REQUIRE(result.HasParam(depth));
+
+	// Failing conversions are not cached. They fail again.
+	REQUIRE_THROWS_AS(result[depth], HazelnuppConstraintTypeMissmatch);
+	REQUIRE_THROWS_AS(result["--depth"].GetInt64(), HazelnuppConstraintTypeMissmatch);
+	REQUIRE_THROWS_AS(result.Validate(), HazelnuppConstraintTypeMissmatch);
+
+	args[2] = "12";
+	result.Parse(C_Ify(args));
+	result.Validate();
+	REQUIRE(result[depth] == 12);
+
+	return;
+}
+
+// Tests that type-constraint violations name their key, even after the constraints got cleared
+TEST_CASE(__FILE__"/Type_Errors_After_Clearing_Constraints", "[Lazy]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out", "--a-depth-key-too-long-to-be-stored-inline", "deep" });
+
+	Schema schema;
+	schema.RegisterConstraint("--a-depth-key-too-long-to-be-stored-inline", ParamConstraint::TypeSafety(DATA_TYPE::INT));
+
+	ParseResult result(schema);
+	result.SetLazyConversion(true);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// The value names its key, even if the constraint it stems from is gone
+	schema.ClearConstraints();
+	schema.RegisterConstraint("--another-key-too-long-to-be-stored-inline", ParamConstraint::TypeSafety(DATA_TYPE::FLOAT));
+
+	// Verify
+	REQUIRE_THROWS_AS(result.Validate(), HazelnuppConstraintTypeMissmatch);
+
+	try
+	{
+		result.Validate();
+	}
+	catch (const HazelnuppConstraintTypeMissmatch& e)
+	{
+		REQUIRE(e.What() == "Cannot convert parameter --a-depth-key-too-long-to-be-stored-inline to type INT. You supplied type: STRING.");
+	}
+
+	return;
+}
+
+// Tests that many threads may access the same lazy values at once, and all see the same results
+TEST_CASE(__FILE__"/Concurrent_Access", "[Lazy]")
+{
+	// Setup
+	std::vector<std::string> numbers;
+	for (std::size_t i = 0; i < 20000; i++)
+		numbers.push_back(std::to_string(i));
+
+	ArgList args({ "/my/fake/path/wahoo.out", "--numbers" });
+	for (const std::string& number : numbers)
+		args.push_back(number.c_str());
+
+	args.push_back("--constrained");
+	args.push_back("7");
+
+	Schema schema;
+	schema.RegisterConstraint("--constrained", ParamConstraint::TypeSafety(DATA_TYPE::LIST));
+	schema.Freeze();
+
+	for (std::size_t round = 0; round < 5; round++)
+	{
+		ParseResult result(schema);
+		result.SetLazyConversion(true);
+		result.Parse(C_Ify(args));
+
+		// Exercise
+		std::vector<std::thread> threads;
+		std::vector<long long int> sums(8, 0);
+		std::vector<long long int> constrained(8, 0);
+
+		for (std::size_t t = 0; t < sums.size(); t++)
+			threads.emplace_back([&, t]
+				{
+					constrained[t] = result["--constrained"].GetList()[0]->GetInt64();
+
+					const std::vector<Value*>& list = result["--numbers"].GetList();
+					for (std::size_t i = 0; i < list.size(); i++)
+						sums[t] += list[(i + t * 997) % list.size()]->GetInt64();
+
+					return;
+				});
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		// Verify
+		for (std::size_t t = 0; t < sums.size(); t++)
+		{
+			REQUIRE(sums[t] == 19999ll * 20000ll / 2);
+			REQUIRE(constrained[t] == 7);
+		}
+	}
+
+	return;
+}
+
+// Tests that lazy values of a stream survive the stream dropping its tokens
+TEST_CASE(__FILE__"/Streams", "[Lazy]")
+{
+	// Setup
+	const Schema schema;
+	ParseResult result(schema);
+	result.SetLazyConversion(true);
+
+	// Exercise
+	result.BeginStream();
+	result.PushChunk("--a\n1\n2\n--b\n3.5\n--c\nfour\n");
+
+	std::string reused = "--d";
+	result.Push(reused);
+	reused = "5";
+	result.Push(reused);
+	reused = "XXXX";
+
+	result.EndStream();
+
+	// Verify
+	REQUIRE(result["--a"].GetList()[1]->GetInt64() == 2);
+	REQUIRE(result["--b"].GetFloat64() == 3.5);
+	REQUIRE(result["--c"].GetStringView() == "four");
+	REQUIRE(result["--d"].GetInt64() == 5);
+
+	return;
+}
@@ -0,0 +1,232 @@
+#include "Catch2.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/StringTools.h>
+#include <climits>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Hazelnp;
+
+// Tests that prefixed integer literals get recognized
+TEST_CASE(__FILE__"/Prefixed_Integers", "[Numbers]")
+{
+	// Setup
+	long long int i;
+	long double f;
+
+	// Exercise, Verify
+	REQUIRE(Internal::StringTools::LexNumber("0x1F", i, f) == DATA_TYPE::INT);
+	REQUIRE(i == 31);
+	REQUIRE(Internal::StringTools::LexNumber("0XfF", i, f) == DATA_TYPE::INT);
+	REQUIRE(i == 255);
+	REQUIRE(Internal::StringTools::LexNumber("0o17", i, f) == DATA_TYPE::INT);
+	REQUIRE(i == 15);
+	REQUIRE(Internal::StringTools::LexNumber("0b101", i, f) == DATA_TYPE::INT);
+	REQUIRE(i == 5);
+	REQUIRE(Internal::StringTools::LexNumber("-0x10", i, f) == DATA_TYPE::INT);
+	REQUIRE(i == -16);
+	REQUIRE(Internal::StringTools::LexNumber("-0x8000000000000000", i, f) == DATA_TYPE::INT);
+	REQUIRE(i == LLONG_MIN);
+
+	REQUIRE(Internal::StringTools::LexNumber("0x", i, f) == DATA_TYPE::STRING);
+	REQUIRE(Internal::StringTools::LexNumber("0b102", i, f) == DATA_TYPE::STRING);
+	REQUIRE(Internal::StringTools::LexNumber("0xG", i, f) == DATA_TYPE::STRING);
+	REQUIRE(Internal::StringTools::LexNumber("0x8000000000000000", i, f) == DATA_TYPE::STRING);
+
+	return;
+}
+
+// Tests that decimal numbers, fractions and exponents get recognized
+TEST_CASE(__FILE__"/Decimals_And_Exponents", "[Numbers]")
+{
+	// Setup
+	long long int i;
+	long double f;
+
+	// Exercise, Verify
+	REQUIRE(Internal::StringTools::LexNumber("0", i, f) == DATA_TYPE::INT);
+	REQUIRE(i == 0);
+	REQUIRE(Internal::StringTools::LexNumber("-39", i, f) == DATA_TYPE::INT);
+	REQUIRE(i == -39);
+	REQUIRE(Internal::StringTools::LexNumber("1.5", i, f) == DATA_TYPE::FLOAT);
+	REQUIRE(f == 1.5);
+	REQUIRE(Internal::StringTools::LexNumber("1.", i, f) == DATA_TYPE::FLOAT);
+	REQUIRE(f == 1);
+	REQUIRE(Internal::StringTools::LexNumber("1e3", i, f) == DATA_TYPE::FLOAT);
+	REQUIRE(f == 1000);
+	REQUIRE(Internal::StringTools::LexNumber("-2.5E-1", i, f) == DATA_TYPE::FLOAT);
+	REQUIRE(f == -0.25);
+
+	REQUIRE(Internal::StringTools::LexNumber("", i, f) == DATA_TYPE::STRING);
+	REQUIRE(Internal::StringTools::LexNumber("-", i, f) == DATA_TYPE::STRING);
+	REQUIRE(Internal::StringTools::LexNumber(".5", i, f) == DATA_TYPE::STRING);
+	REQUIRE(Internal::StringTools::LexNumber("+5", i, f) == DATA_TYPE::STRING);
+	REQUIRE(Internal::StringTools::LexNumber("1e", i, f) == DATA_TYPE::STRING);
+	REQUIRE(Internal::StringTools::LexNumber("1.2.3", i, f) == DATA_TYPE::STRING);
+	REQUIRE(Internal::StringTools::LexNumber("12abc", i, f) == DATA_TYPE::STRING);
+	REQUIRE(Internal::StringTools::LexNumber("1,5", i, f) == DATA_TYPE::STRING);
+	REQUIRE(Internal::StringTools::LexNumber("inf", i, f) == DATA_TYPE::STRING);
+	REQUIRE(Internal::StringTools::LexNumber("nan", i, f) == DATA_TYPE::STRING);
+
+	return;
+}
+
+// Tests that integers are converted exactly, without a detour through floating point
+TEST_CASE(__FILE__"/Exact_Integers", "[Numbers]")
+{
+	// Setup
+	long long int i;
+	long double f;
+
+	// Exercise, Verify
+	REQUIRE(Internal::StringTools::LexNumber("9007199254740993", i, f) == DATA_TYPE::INT);
+	REQUIRE(i == 9007199254740993ll);
+	REQUIRE(Internal::StringTools::LexNumber("9223372036854775807", i, f) == DATA_TYPE::INT);
+	REQUIRE(i == LLONG_MAX);
+	REQUIRE(Internal::StringTools::LexNumber("-9223372036854775808", i, f) == DATA_TYPE::INT);
+	REQUIRE(i == LLONG_MIN);
+
+	// Too big for 64 bits: falls back to floating point
+	REQUIRE(Internal::StringTools::LexNumber("99999999999999999999", i, f) == DATA_TYPE::FLOAT);
+	REQUIRE(f > (long double)LLONG_MAX);
+
+	return;
+}
+
+// Tests that parsing delivers the exact integer, and respects type constraints
+TEST_CASE(__FILE__"/Parse_Uses_Lexed_Numbers", "[Numbers]")
+{
+	// Setup
+	const char* argv[] = {
+		"/my/fake/path/wahoo.out",
+		"--big",
+		"9223372036854775807",
+		"--hex",
+		"0xff",
+		"--exp",
+		"2.5e2",
+		"--as-float",
+		"0x10",
+		"--as-int",
+		"7.9",
+		"--word",
+		"1e"
+	};
+
+	CmdArgsInterface cmdArgsI;
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.RegisterConstraint("--as-float", ParamConstraint::TypeSafety(DATA_TYPE::FLOAT));
+	cmdArgsI.RegisterConstraint("--as-int", ParamConstraint::TypeSafety(DATA_TYPE::INT));
+
+	// Exercise
+	cmdArgsI.Parse(sizeof(argv) / sizeof(*argv), argv);
+
+	// Verify
+	REQUIRE(cmdArgsI["--big"].GetDataType() == DATA_TYPE::INT);
+	REQUIRE(cmdArgsI["--big"].GetInt64() == LLONG_MAX);
+	REQUIRE(cmdArgsI["--hex"].GetInt64() == 255);
+	REQUIRE(cmdArgsI["--exp"].GetDataType() == DATA_TYPE::FLOAT);
+	REQUIRE(cmdArgsI["--exp"].GetFloat64() == 250);
+	REQUIRE(cmdArgsI["--as-float"].GetDataType() == DATA_TYPE::FLOAT);
+	REQUIRE(cmdArgsI["--as-float"].GetFloat64() == 16);
+	REQUIRE(cmdArgsI["--as-int"].GetDataType() == DATA_TYPE::INT);
+	REQUIRE(cmdArgsI["--as-int"].GetInt64() == 7);
+	REQUIRE(cmdArgsI["--word"].GetDataType() == DATA_TYPE::STRING);
+
+	return;
+}
+
+// Tests that bulk conversion of integer batches matches converting each token on its own
+TEST_CASE(__FILE__"/Bulk_Integers", "[Numbers]")
+{
+	// Setup
+	std::vector<std::string> tokens = {
+		"0", "-0", "7", "-39", "007", "1234567890123456", "-9999999999999999",
+		"12345678901234567", "9223372036854775807", "-9223372036854775808", "0x1F", "-0b101"
+	};
+
+	std::mt19937_64 random(42);
+	for (std::size_t i = 0; i < 10000; i++)
+	{
+		const long long int value = (long long int)(random() >> (random() % 64));
+		tokens.push_back(std::to_string((i % 2) ? value : -value));
+	}
+
+	const std::vector<std::string_view> views(tokens.begin(), tokens.end());
+	std::vector<long long int> converted(views.size());
+
+	// Exercise
+	const std::size_t numConverted = Internal::StringTools::LexIntegers(views.data(), views.size(), converted.data());
+
+	// Verify
+	REQUIRE(numConverted == views.size());
+	for (std::size_t i = 0; i < views.size(); i++)
+	{
+		long long int expected;
+		long double f;
+		REQUIRE(Internal::StringTools::LexNumber(views[i], expected, f) == DATA_TYPE::INT);
+		REQUIRE(converted[i] == expected);
+	}
+
+	return;
+}
+
+// Tests that bulk conversion of float batches matches converting each token on its own, to the last bit
+TEST_CASE(__FILE__"/Bulk_Floats", "[Numbers]")
+{
+	// Setup
+	std::vector<std::string> tokens = {
+		"1.", "-0.0", "1.5", "-2.25", "0.1", "3.14159265358979", "123456789012345.6", "1234567890.12345678",
+		"1e3", "-2.5E-1", "99999999999999999999"
+	};
+
+	std::mt19937_64 random(42);
+	for (std::size_t i = 0; i < 10000; i++)
+	{
+		const std::string digits = std::to_string(random() % 10000000000000000ull);
+		const std::size_t point = 1 + random() % digits.length();
+		tokens.push_back(((i % 2) ? "-" : "") + digits.substr(0, point) + "." + digits.substr(point));
+	}
+
+	const std::vector<std::string_view> views(tokens.begin(), tokens.end());
+	std::vector<long double> converted(views.size());
+
+	// Exercise
+	const std::size_t numConverted = Internal::StringTools::LexFloats(views.data(), views.size(), converted.data());
+
+	// Verify
+	REQUIRE(numConverted == views.size());
+	for (std::size_t i = 0; i < views.size(); i++)
+	{
+		long long int n;
+		long double expected;
+		REQUIRE(Internal::StringTools::LexNumber(views[i], n, expected) == DATA_TYPE::FLOAT);
+		REQUIRE(converted[i] == expected);
+		REQUIRE(std::signbit(converted[i]) == std::signbit(expected));
+	}
+
+	return;
+}
+
+// Tests that bulk conversion stops at the first token of another type
+TEST_CASE(__FILE__"/Bulk_Stops_At_Other_Types", "[Numbers]")
+{
+	// Setup
+	const std::string_view ints[] = { "1", "22", "-3", "4.5", "6" };
+	const std::string_view floats[] = { "1.5", "2e2", "3", "4.5" };
+	const std::string_view strings[] = { "12", "1-2", "7" };
+	long long int intOut[5];
+	long double floatOut[4];
+
+	// Exercise, Verify
+	REQUIRE(Internal::StringTools::LexIntegers(ints, 5, intOut) == 3);
+	REQUIRE(intOut[2] == -3);
+	REQUIRE(Internal::StringTools::LexFloats(floats, 4, floatOut) == 2);
+	REQUIRE(floatOut[1] == 200);
+	REQUIRE(Internal::StringTools::LexIntegers(strings, 3, intOut) == 1);
+	REQUIRE(Internal::StringTools::LexIntegers(strings, 0, intOut) == 0);
+
+	return;
+}
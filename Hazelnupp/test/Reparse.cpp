@@ -0,0 +1,108 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/HazelnuppException.h>
+
+using namespace Hazelnp;
+
+// Tests that parsing again drops all parameters of the previous parse, but keeps the schema
+TEST_CASE(__FILE__"/Reparse_Drops_Stale_Parameters", "[Reparse]")
+{
+	// Setup
+	ArgList first({
+		"/my/fake/path/wahoo.out",
+		"--first",
+		"-n",
+		"5"
+	});
+
+	ArgList second({
+		"/my/fake/path/wahoo.out",
+		"--second",
+		"-n",
+		"7"
+	});
+
+	CmdArgsInterface cmdArgsI;
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.RegisterAbbreviation("-n", "--number");
+	cmdArgsI.RegisterConstraint("--number", ParamConstraint::TypeSafety(DATA_TYPE::FLOAT));
+	cmdArgsI.Parse(C_Ify(first));
+
+	// Exercise
+	cmdArgsI.Parse(C_Ify(second));
+
+	// Verify
+	REQUIRE_FALSE(cmdArgsI.HasParam("--first"));
+	REQUIRE(cmdArgsI.HasParam("--second"));
+	REQUIRE(cmdArgsI["--number"].GetDataType() == DATA_TYPE::FLOAT);
+	REQUIRE(cmdArgsI["--number"].GetFloat64() == 7);
+
+	return;
+}
+
+// Tests that Reset() drops all parse results, but keeps the schema
+TEST_CASE(__FILE__"/Reset_Keeps_Schema", "[Reparse]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--name",
+		"billybob"
+	});
+
+	CmdArgsInterface cmdArgsI;
+	cmdArgsI.SetCrashOnFail(false);
+	const ParamHandle<std::string_view> name = cmdArgsI.RegisterParameter<std::string_view>("--name");
+	cmdArgsI.Parse(C_Ify(args));
+
+	// Exercise
+	cmdArgsI.Reset();
+
+	// Verify
+	REQUIRE_FALSE(cmdArgsI.HasParam("--name"));
+	REQUIRE_FALSE(cmdArgsI.HasParam(name));
+	REQUIRE(cmdArgsI.GetExecutableName().empty());
+
+	cmdArgsI.Parse(C_Ify(args));
+	REQUIRE(cmdArgsI[name] == "billybob");
+
+	return;
+}
+
+// Tests that, once warmed up, reparsing does not request any more memory
+TEST_CASE(__FILE__"/Warm_Reparse_Reuses_Memory", "[Reparse]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--my_string",
+		"a string that is way too long to be stored inline",
+		"--my_num_list",
+		"1",
+		"2",
+		"3",
+		"-f"
+	});
+
+	CountingResource resource;
+	CmdArgsInterface cmdArgsI(&resource);
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.RegisterAbbreviation("-f", "--force");
+	cmdArgsI.RegisterConstraint("--my_default", ParamConstraint::Require({ "peter", "jake" }));
+
+	cmdArgsI.Parse(C_Ify(args));
+	const std::size_t numAllocations = resource.numAllocations;
+
+	// Exercise
+	for (int i = 0; i < 100; i++)
+		cmdArgsI.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(resource.numAllocations == numAllocations);
+	REQUIRE(cmdArgsI.HasParam("--force"));
+	REQUIRE(cmdArgsI["--my_default"].GetList().size() == 2);
+	REQUIRE(cmdArgsI["--my_num_list"].GetList()[2]->GetInt32() == 3);
+
+	return;
+}
@@ -0,0 +1,239 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <string>
+#include <vector>
+
+using namespace Hazelnp;
+
+namespace
+{
+	std::vector<std::string> ToStrings(const Span<const std::string_view>& list)
+	{
+		return std::vector<std::string>(list.begin(), list.end());
+	}
+}
+
+// Tests that the values of all occurrences get appended to one list, in order
+TEST_CASE(__FILE__"/Append", "[RepeatedParameters]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out",
+		"-i", "a.h",
+		"--define", "DEBUG",
+		"-i", "b.h", "c.h",
+		"--single", "lonely",
+		"-i",
+		"--sizes", "1",
+		"-i", "d.h",
+		"--sizes", "2", "3"
+	});
+
+	Schema schema;
+	schema.RegisterAbbreviation("-i", "--include");
+	schema.RegisterConstraint("--include", ParamConstraint::RepeatPolicy(REPEAT_POLICY::APPEND));
+	schema.RegisterConstraint("--sizes", ParamConstraint::RepeatPolicy(REPEAT_POLICY::APPEND));
+	schema.RegisterConstraint("--single", ParamConstraint::RepeatPolicy(REPEAT_POLICY::APPEND));
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(ToStrings(result["--include"].GetStringList()) == std::vector<std::string>({ "a.h", "b.h", "c.h", "d.h" }));
+	REQUIRE(result.GetSource("--include") == PARAM_SOURCE::COMMAND_LINE);
+
+	// Elements sharing a type are still stored contiguously
+	const Span<const long long int> sizes = result["--sizes"].GetIntList();
+	REQUIRE(std::vector<long long int>(sizes.begin(), sizes.end()) == std::vector<long long int>({ 1, 2, 3 }));
+
+	// Appended parameters are lists, no matter how often they were supplied
+	REQUIRE(result["--single"].GetDataType() == DATA_TYPE::LIST);
+	REQUIRE(ToStrings(result["--single"].GetStringList()) == std::vector<std::string>({ "lonely" }));
+
+	// Others are unaffected
+	REQUIRE(result["--define"].GetStringView() == "DEBUG");
+
+	return;
+}
+
+// Tests that the first occurrence is kept by default, and the last one on request
+TEST_CASE(__FILE__"/Keep_First_And_Last", "[RepeatedParameters]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out",
+		"--first", "1",
+		"--last", "1",
+		"--first", "2",
+		"--last", "2",
+		"--last", "3"
+	});
+
+	Schema schema;
+	schema.RegisterConstraint("--last", ParamConstraint::RepeatPolicy(REPEAT_POLICY::KEEP_LAST));
+	schema.RegisterConstraint("--gentle", ParamConstraint::Incompatibility("--last"));
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result["--first"].GetInt64() == 1);
+	REQUIRE(result["--last"].GetInt64() == 3);
+
+	// The replacement still counts as present
+	ArgList gentle({ "/my/fake/path/wahoo.out", "--last", "1", "--gentle", "--last", "2" });
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(gentle)), HazelnuppConstraintIncompatibleParameters);
+
+	return;
+}
+
+// Tests that repeating a parameter whose policy rejects that throws
+TEST_CASE(__FILE__"/Reject", "[RepeatedParameters]")
+{
+	// Setup
+	ArgList once({ "/my/fake/path/wahoo.out", "--output", "a.txt" });
+	ArgList twice({ "/my/fake/path/wahoo.out", "--output", "a.txt", "--output", "b.txt" });
+
+	Schema schema;
+	schema.RegisterConstraint("--output", ParamConstraint::RepeatPolicy(REPEAT_POLICY::REJECT));
+	schema.RegisterDescription("--output", "Where to write to");
+
+	ParseResult result(schema);
+
+	// Exercise, Verify
+	REQUIRE_NOTHROW(result.Parse(C_Ify(once)));
+	REQUIRE(result["--output"].GetStringView() == "a.txt");
+
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(twice)), HazelnuppConstraintRepeatedParameter);
+
+	try
+	{
+		result.Parse(C_Ify(twice));
+	}
+	catch (const HazelnuppConstraintRepeatedParameter& e)
+	{
+		REQUIRE(e.What().find("Where to write to") != std::string::npos);
+	}
+
+	return;
+}
+
+// Tests that parameters of a static schema follow their policies aswell
+TEST_CASE(__FILE__"/Static_Schema", "[RepeatedParameters]")
+{
+	// Setup
+	static constexpr ParamSpec specs[] = {
+		ParamSpec("--include").AddAbbreviation("-I").AddRepeatPolicy(REPEAT_POLICY::APPEND),
+		ParamSpec("--level").AddTypeSafety(DATA_TYPE::INT).AddRepeatPolicy(REPEAT_POLICY::KEEP_LAST),
+		ParamSpec("--output").AddRepeatPolicy(REPEAT_POLICY::REJECT)
+	};
+	static constexpr StaticSchema staticSchema(specs);
+
+	ArgList args({ "/my/fake/path/wahoo.out", "-I", "a", "--level", "1", "-I", "b", "--level", "2", "--output", "x" });
+	ArgList twice({ "/my/fake/path/wahoo.out", "--output", "x", "--output", "y" });
+
+	CmdArgsInterface cmdArgsI(staticSchema);
+	cmdArgsI.SetCrashOnFail(false);
+
+	// Exercise
+	cmdArgsI.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(ToStrings(cmdArgsI["--include"].GetStringList()) == std::vector<std::string>({ "a", "b" }));
+	REQUIRE(cmdArgsI["--level"].GetInt64() == 2);
+	REQUIRE(cmdArgsI["--output"].GetStringView() == "x");
+
+	// Exercise, Verify
+	REQUIRE_THROWS_AS(cmdArgsI.Parse(C_Ify(twice)), HazelnuppConstraintRepeatedParameter);
+
+	return;
+}
+
+// Tests that appending works with type constraints, streams, lazy conversion and the parameter callback
+TEST_CASE(__FILE__"/Streams_And_Lazy_Conversion", "[RepeatedParameters]")
+{
+	// Setup
+	Schema schema;
+	schema.RegisterConstraint("--sizes", ParamConstraint::TypeSafety(DATA_TYPE::LIST).AddRepeatPolicy(REPEAT_POLICY::APPEND));
+	schema.RegisterConstraint("--depth", ParamConstraint::TypeSafety(DATA_TYPE::INT).AddRepeatPolicy(REPEAT_POLICY::APPEND));
+
+	ParseResult result(schema);
+	result.SetLazyConversion(true);
+
+	std::vector<std::string> announced;
+	result.SetParameterCallback([&](const Parameter& param)
+		{
+			announced.emplace_back(param.Key());
+			return;
+		});
+
+	// Exercise
+	result.BeginStream("/my/fake/path/wahoo.out");
+	for (const char* token : { "--sizes", "1", "--name", "billy", "--sizes", "2", "3", "--sizes", "4" })
+	{
+		// The callers buffer is transient
+		std::string buffer = token;
+		result.Push(buffer);
+	}
+	result.EndStream();
+
+	// Verify
+	// Appended ones are announced once, when all of their occurrences are known
+	REQUIRE(announced == std::vector<std::string>({ "--name", "--sizes" }));
+
+	const Span<const long long int> sizes = result["--sizes"].GetIntList();
+	REQUIRE(std::vector<long long int>(sizes.begin(), sizes.end()) == std::vector<long long int>({ 1, 2, 3, 4 }));
+
+	// Exercise, Verify
+	// The type constraint applies to all values together
+	ArgList args({ "/my/fake/path/wahoo.out", "--depth", "1", "--depth", "2" });
+	result.Parse(C_Ify(args));
+	REQUIRE_THROWS_AS(result.Validate(), HazelnuppConstraintTypeMissmatch);
+
+	result.SetLazyConversion(false);
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(args)), HazelnuppConstraintTypeMissmatch);
+
+	return;
+}
+
+// Tests that thousands of occurrences get appended to one list, and that policies show up in the documentation
+TEST_CASE(__FILE__"/Many_Occurrences_And_Documentation", "[RepeatedParameters]")
+{
+	// Setup
+	std::vector<std::string> strings;
+	strings.reserve(20000);
+	for (std::size_t i = 0; i < 10000; i++)
+	{
+		strings.emplace_back("-D");
+		strings.emplace_back(std::to_string(i));
+	}
+
+	ArgList args({ "/my/fake/path/wahoo.out" });
+	for (const std::string& s : strings)
+		args.emplace_back(s.c_str());
+
+	CmdArgsInterface cmdArgsI;
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.RegisterAbbreviation("-D", "--define");
+	cmdArgsI.RegisterConstraint("--define", ParamConstraint::RepeatPolicy(REPEAT_POLICY::APPEND));
+
+	// Exercise
+	cmdArgsI.Parse(C_Ify(args));
+
+	// Verify
+	const Span<const long long int> defines = cmdArgsI["--define"].GetIntList();
+	REQUIRE(defines.size() == 10000);
+	for (std::size_t i = 0; i < defines.size(); i++)
+		REQUIRE(defines[i] == (long long int)i);
+
+	REQUIRE(cmdArgsI.GenerateDocumentation() ==
+		"\n==== AVAILABLE PARAMETERS ====\n\n"
+		"--define   -D   repeat=[APPEND]   "
+	);
+
+	return;
+}
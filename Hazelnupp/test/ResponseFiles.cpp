@@ -0,0 +1,188 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <filesystem>
+#include <string>
+
+using namespace Hazelnp;
+
+// Tests that a response file gets replaced by its tokens, with quoting, escaping and comments
+TEST_CASE(__FILE__"/Tokenizes_Response_File", "[ResponseFiles]")
+{
+	// Setup
+	const std::string contents =
+		"# Leading comment\n"
+		"--names billy \"bob the builder\" 'it''s' a\\ b # trailing comment\n"
+		"\t\"esc\\\"aped\" pre\"fix\"ed '' mid#hash\r\n"
+		"--depth 12";
+
+	const std::string path = WriteTestFile("tokens.txt", contents);
+	const std::string arg = "@" + path;
+
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--first",
+		arg.c_str(),
+		"--last"
+	});
+
+	CmdArgsInterface nupp;
+	nupp.SetCrashOnFail(false);
+	nupp.SetExpandResponseFiles(true);
+
+	// Exercise
+	nupp.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(nupp.HasParam("--first"));
+	REQUIRE(nupp.HasParam("--last"));
+	REQUIRE(nupp["--depth"].GetInt32() == 12);
+
+	const std::vector<Value*>& names = nupp["--names"].GetList();
+	REQUIRE(names.size() == 8);
+	REQUIRE(names[0]->GetStringView() == "billy");
+	REQUIRE(names[1]->GetStringView() == "bob the builder");
+	REQUIRE(names[2]->GetStringView() == "its");
+	REQUIRE(names[3]->GetStringView() == "a b");
+	REQUIRE(names[4]->GetStringView() == "esc\"aped");
+	REQUIRE(names[5]->GetStringView() == "prefixed");
+	REQUIRE(names[6]->GetStringView() == "");
+	REQUIRE(names[7]->GetStringView() == "mid#hash");
+
+	// Unescaping in place must never write through to the file
+	REQUIRE(ReadTestFile(path) == contents);
+
+	return;
+}
+
+// Tests that response files can list further ones, relative to themselves, and that a quoted @ stays literal
+TEST_CASE(__FILE__"/Nested_Response_Files", "[ResponseFiles]")
+{
+	// Setup
+	WriteTestFile("nested/inner.txt", "--inner yes");
+	const std::string outer = WriteTestFile("outer.txt", "--outer @nested/inner.txt --literal \"@nested/inner.txt\"");
+	const std::string arg = "@" + outer;
+
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		arg.c_str()
+	});
+
+	const Schema schema;
+	ParseResult result(schema);
+	result.SetExpandResponseFiles(true);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result.HasParam("--outer"));
+	REQUIRE(result["--inner"].GetStringView() == "yes");
+	REQUIRE(result["--literal"].GetStringView() == "@nested/inner.txt");
+
+	return;
+}
+
+// Tests that response files are nested no deeper than allowed
+TEST_CASE(__FILE__"/Depth_Limit", "[ResponseFiles]")
+{
+	// Setup
+	const std::string self = WriteTestFile("self.txt", "--again @self.txt");
+	WriteTestFile("two.txt", "--two @nested/../one.txt");
+	WriteTestFile("one.txt", "--one");
+
+	const std::string selfArg = "@" + self;
+	const std::string twoArg = "@" + std::filesystem::path(self).replace_filename("two.txt").string();
+
+	const Schema schema;
+	ParseResult result(schema);
+	result.SetExpandResponseFiles(true);
+
+	// Exercise, Verify
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(ArgList({ "/my/fake/path/wahoo.out", selfArg.c_str() }))), HazelnuppResponseFileException);
+
+	result.SetMaxResponseFileDepth(1);
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(ArgList({ "/my/fake/path/wahoo.out", twoArg.c_str() }))), HazelnuppResponseFileException);
+
+	result.SetMaxResponseFileDepth(2);
+	result.Parse(C_Ify(ArgList({ "/my/fake/path/wahoo.out", twoArg.c_str() })));
+	REQUIRE(result.HasParam("--two"));
+	REQUIRE(result.HasParam("--one"));
+
+	return;
+}
+
+// Tests that unreadable and malformed response files throw
+TEST_CASE(__FILE__"/Bad_Response_Files", "[ResponseFiles]")
+{
+	// Setup
+	const std::string unterminated = "@" + WriteTestFile("unterminated.txt", "--a \"oops");
+	const std::string empty = "@" + WriteTestFile("empty.txt", "");
+	const std::string missing = "@" + WriteTestFile("empty.txt", "") + ".missing";
+
+	const Schema schema;
+	ParseResult result(schema);
+	result.SetExpandResponseFiles(true);
+
+	// Exercise, Verify
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(ArgList({ "/my/fake/path/wahoo.out", unterminated.c_str() }))), HazelnuppResponseFileException);
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(ArgList({ "/my/fake/path/wahoo.out", missing.c_str() }))), HazelnuppResponseFileException);
+
+	result.Parse(C_Ify(ArgList({ "/my/fake/path/wahoo.out", empty.c_str(), "--b" })));
+	REQUIRE(result.HasParam("--b"));
+
+	return;
+}
+
+// Tests that @args are just values, unless expanding response files is enabled
+TEST_CASE(__FILE__"/Disabled_By_Default", "[ResponseFiles]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--mention",
+		"@billybob"
+	});
+
+	const Schema schema;
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE_FALSE(result.GetExpandResponseFiles());
+	REQUIRE(result["--mention"].GetStringView() == "@billybob");
+
+	return;
+}
+
+// Tests that a huge response file makes it into one list, and that its tokens reference the mapping
+TEST_CASE(__FILE__"/Huge_Response_File", "[ResponseFiles]")
+{
+	// Setup
+	std::string contents = "--files";
+	for (std::size_t i = 0; i < 100000; i++)
+		contents += "\n/data/shard/" + std::to_string(i) + ".bin";
+
+	const std::string arg = "@" + WriteTestFile("huge.txt", contents);
+
+	const Schema schema;
+	ParseResult result(schema);
+	result.SetExpandResponseFiles(true);
+
+	// Exercise
+	result.Parse(C_Ify(ArgList({ "/my/fake/path/wahoo.out", arg.c_str() })));
+
+	// Verify
+	const std::vector<Value*>& files = result["--files"].GetList();
+	REQUIRE(files.size() == 100000);
+	REQUIRE(files[0]->GetStringView() == "/data/shard/0.bin");
+	REQUIRE(files[99999]->GetStringView() == "/data/shard/99999.bin");
+
+	// Consecutive tokens are consecutive within the mapping. Nothing got copied.
+	REQUIRE(files[1]->GetStringView().data() == files[0]->GetStringView().data() + files[0]->GetStringView().length() + 1);
+
+	return;
+}
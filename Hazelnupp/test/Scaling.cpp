@@ -0,0 +1,100 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#ifdef _WIN32
+// Windows limits the whole command line to 32767 characters
+#define HAZELNUPP_TEST_ARG_MAX 32767
+#else
+#include <unistd.h>
+#define HAZELNUPP_TEST_ARG_MAX sysconf(_SC_ARG_MAX)
+#endif
+
+using namespace Hazelnp;
+
+namespace
+{
+	// Will create an argv of roughly totalBytes bytes. Every eighth arg is a key, followed by a mixed value list.
+	std::vector<std::string> MakeArgs(const std::size_t totalBytes)
+	{
+		std::vector<std::string> args = { "/my/fake/path/wahoo.out" };
+
+		std::size_t bytes = 0;
+		for (std::size_t i = 0; bytes < totalBytes; i++)
+		{
+			std::string arg;
+			switch (i % 8)
+			{
+			case 0:
+				arg = "--key" + std::to_string(i);
+				break;
+			case 1:
+			case 2:
+				arg = std::to_string(i);
+				break;
+			case 3:
+				arg = "-" + std::to_string(i) + ".5";
+				break;
+			default:
+				arg = "value" + std::to_string(i);
+				break;
+			}
+
+			// The os needs the terminator and a pointer per arg aswell
+			bytes += arg.length() + 1 + sizeof(char*);
+			args.emplace_back(std::move(arg));
+		}
+
+		return args;
+	}
+
+	// Will return the best of a few runs, in seconds, to parse args
+	double TimeParse(const std::vector<std::string>& args)
+	{
+		ArgList argv;
+		argv.reserve(args.size());
+		for (const std::string& s : args)
+			argv.emplace_back(s.c_str());
+
+		double best = 1e30;
+		for (int run = 0; run < 3; run++)
+		{
+			const auto begin = std::chrono::steady_clock::now();
+
+			CmdArgsInterface cmdArgsI;
+			cmdArgsI.SetCrashOnFail(false);
+			cmdArgsI.Parse(C_Ify(argv));
+
+			const auto end = std::chrono::steady_clock::now();
+			best = std::min(best, std::chrono::duration<double>(end - begin).count());
+		}
+
+		return best;
+	}
+}
+
+// Tests that parsing time grows linearly with the size of argv, up to an ARG_MAX sized argv.
+// It measures wall-clock time, so it is hidden from the default run. Run it with the tag [benchmark].
+TEST_CASE(__FILE__"/Parse_Time_Grows_Linearly", "[Scaling][.benchmark]")
+{
+	// Setup
+	const std::size_t argMax = (std::size_t)std::min<long>(HAZELNUPP_TEST_ARG_MAX, 2 * 1024 * 1024);
+	const std::vector<std::string> smallArgs = MakeArgs(argMax / 16);
+	const std::vector<std::string> bigArgs = MakeArgs(argMax);
+
+	// Exercise
+	const double smallTime = TimeParse(smallArgs);
+	const double bigTime = TimeParse(bigArgs);
+
+	// Verify
+	// 16 times the input should take about 16 times as long. Anything quadratic would take 256 times as long.
+	// Allow plenty of headroom for caches, allocators, and noisy machines.
+	const double inputRatio = (double)bigArgs.size() / (double)smallArgs.size();
+	INFO("input ratio: " << inputRatio << ", time ratio: " << bigTime / smallTime);
+	REQUIRE(bigTime / smallTime < inputRatio * 4);
+
+	return;
+}
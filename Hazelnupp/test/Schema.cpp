@@ -0,0 +1,151 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/Schema.h>
+#include <Hazelnupp/ParseResult.h>
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <thread>
+#include <vector>
+#include <string>
+#include <atomic>
+
+using namespace Hazelnp;
+
+// Tests that a ParseResult parses against a schema on its own, and throws instead of crashing
+TEST_CASE(__FILE__"/ParseResult_Against_Schema", "[Schema]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"-w",
+		"800",
+		"--name",
+		"billybob"
+	});
+
+	ArgList missing({
+		"/my/fake/path/wahoo.out",
+		"--name",
+		"billybob"
+	});
+
+	Schema schema;
+	schema.RegisterAbbreviation("-w", "--width");
+	const ParamHandle<long long int> width = schema.RegisterParameter<long long int>("--width", ParamConstraint::Require());
+	schema.Freeze();
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result.GetExecutableName() == "/my/fake/path/wahoo.out");
+	REQUIRE(result[width] == 800);
+	REQUIRE(result["--name"].GetStringView() == "billybob");
+	REQUIRE(&result.GetSchema() == &schema);
+
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(missing)), HazelnuppConstraintMissingValue);
+
+	return;
+}
+
+// Tests that a frozen schema rejects any change
+TEST_CASE(__FILE__"/Frozen_Schema_Is_Immutable", "[Schema]")
+{
+	// Setup
+	Schema schema;
+	schema.RegisterConstraint("--a", ParamConstraint::TypeSafety(DATA_TYPE::INT));
+	schema.RegisterConstraint("--b", ParamConstraint::TypeSafety(DATA_TYPE::INT));
+	const ParamHandle<int> a = schema.GetHandle<int>("--a");
+
+	// Exercise
+	schema.Freeze();
+
+	// Verify
+	REQUIRE(schema.IsFrozen());
+	REQUIRE_THROWS_AS(schema.RegisterAbbreviation("-a", "--a"), HazelnuppException);
+	REQUIRE_THROWS_AS(schema.RegisterConstraint("--c", ParamConstraint()), HazelnuppException);
+	REQUIRE_THROWS_AS(schema.RegisterDescription("--a", "Hi"), HazelnuppException);
+	REQUIRE_THROWS_AS(schema.ClearConstraints(), HazelnuppException);
+	REQUIRE_THROWS_AS(schema.SetBriefDescription("Hi"), HazelnuppException);
+
+	// Ids are assigned on registration. So taking handles changes nothing, and works on frozen schemas aswell.
+	REQUIRE(schema.GetHandle<int>("--a").IsValid());
+	REQUIRE(a.IsValid());
+	REQUIRE(schema.GetHandle<int>("--b").IsValid());
+
+	return;
+}
+
+// Tests that many threads can parse against one frozen schema at the same time
+TEST_CASE(__FILE__"/Concurrent_Parsing", "[Schema]")
+{
+	// Setup
+	Schema schema;
+	schema.RegisterAbbreviation("-n", "--number");
+	schema.RegisterConstraint("--list", ParamConstraint::Require({ "1", "2", "3" }));
+	const ParamHandle<long long int> number = schema.RegisterParameter<long long int>("--number");
+	const ParamHandle<std::string_view> name = schema.RegisterParameter<std::string_view>("--name");
+	schema.Freeze();
+
+	constexpr int numThreads = 8;
+	constexpr int numParses = 500;
+	std::atomic<int> numFailures { 0 };
+
+	// Exercise
+	std::vector<std::thread> threads;
+	for (int t = 0; t < numThreads; t++)
+		threads.emplace_back([&, t]()
+		{
+			ParseResult result(schema);
+
+			for (int i = 0; i < numParses; i++)
+			{
+				const std::string num = std::to_string(t * numParses + i);
+				const std::string nam = "thread_" + std::to_string(t) + "_with_a_long_name";
+				const char* argv[] = { "/my/fake/path/wahoo.out", "-n", num.c_str(), "--name", nam.c_str() };
+
+				result.Parse(sizeof(argv) / sizeof(*argv), argv);
+
+				if ((result[number] != t * numParses + i) ||
+					(result[name] != nam) ||
+					(result["--list"].GetList().size() != 3))
+					numFailures++;
+			}
+
+			return;
+		});
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	// Verify
+	REQUIRE(numFailures == 0);
+
+	return;
+}
+
+// Tests that CmdArgsInterface exposes the schema and result it wraps
+TEST_CASE(__FILE__"/Wrapper_Exposes_Schema_And_Result", "[Schema]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--width",
+		"800"
+	});
+
+	CmdArgsInterface cmdArgsI;
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.RegisterDescription("--width", "How wide");
+
+	// Exercise
+	cmdArgsI.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(cmdArgsI.GetSchema().GetDescription("--width") == "How wide");
+	REQUIRE(cmdArgsI.GetParseResult()["--width"].GetInt32() == 800);
+
+	return;
+}
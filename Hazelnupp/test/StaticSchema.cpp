@@ -0,0 +1,159 @@
+#include "Catch2.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/HazelnuppException.h>
+
+using namespace Hazelnp;
+
+namespace
+{
+	constexpr std::string_view widthDefault[] = { "800" };
+	constexpr std::string_view forceIncompatibilities[] = { "--gentle" };
+
+	constexpr ParamSpec specs[] = {
+		ParamSpec("--force").AddAbbreviation("-f").AddDescription("Do it forcefully").AddIncompatibilities(forceIncompatibilities),
+		ParamSpec("--gentle").AddAbbreviation("-g"),
+		ParamSpec("--width").AddAbbreviation("-w").AddTypeSafety(DATA_TYPE::INT).AddRequire(widthDefault),
+		ParamSpec("--name").AddTypeSafety(DATA_TYPE::STRING).AddRequire().AddDescription("Your name"),
+		ParamSpec("--ratio").AddTypeSafety(DATA_TYPE::FLOAT)
+	};
+
+	constexpr StaticSchema schema(specs);
+
+	// The whole lookup table gets built, and can be queried, at compile time
+	static_assert(schema.Size() == 5);
+	static_assert(schema.Find("--force") == 0);
+	static_assert(schema.Find("--ratio") == 4);
+	static_assert(schema.Find("-f") == StaticSchema<5>::npos);
+	static_assert(schema.Find("--forc") == StaticSchema<5>::npos);
+	static_assert(schema.Find("--unknown") == StaticSchema<5>::npos);
+	static_assert(schema.GetSpec(2).numDefaultValues == 1);
+}
+
+// Tests that every key and abbreviation of the schema is found, and nothing else
+TEST_CASE(__FILE__"/Perfect_Hash_Lookup", "[StaticSchema]")
+{
+	// Setup
+	const Internal::StaticSchemaView view = schema.View();
+	bool isAbbreviation = false;
+
+	// Exercise, Verify
+	for (std::size_t id = 0; id < schema.Size(); id++)
+	{
+		REQUIRE(view.Find(schema.GetSpec(id).key, isAbbreviation) == id);
+		REQUIRE_FALSE(isAbbreviation);
+
+		if (schema.GetSpec(id).abbreviation.length() > 0)
+		{
+			REQUIRE(view.Find(schema.GetSpec(id).abbreviation, isAbbreviation) == id);
+			REQUIRE(isAbbreviation);
+		}
+	}
+
+	// Many unknown names. None of them may be mistaken for a known one.
+	for (int i = 0; i < 10000; i++)
+	{
+		const std::string name = "--" + std::to_string(i);
+		REQUIRE(view.Find(name, isAbbreviation) == Internal::StaticSchemaView::npos);
+	}
+
+	REQUIRE(view.Find("", isAbbreviation) == Internal::StaticSchemaView::npos);
+
+	return;
+}
+
+// Tests that parsing against a static schema behaves like registering it all at runtime
+TEST_CASE(__FILE__"/Parse_With_Static_Schema", "[StaticSchema]")
+{
+	// Setup
+	const char* argv[] = {
+		"/my/fake/path/wahoo.out",
+		"-f",
+		"--name",
+		"billybob",
+		"--ratio",
+		"5",
+		"--other",
+		"1",
+		"2"
+	};
+
+	CmdArgsInterface cmdArgsI(schema);
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.RegisterConstraint("--other", ParamConstraint::TypeSafety(DATA_TYPE::LIST));
+
+	// Exercise
+	cmdArgsI.Parse(sizeof(argv) / sizeof(*argv), argv);
+
+	// Verify
+	REQUIRE(cmdArgsI.HasStaticSchema());
+
+	REQUIRE(cmdArgsI.HasParam("--force"));
+	REQUIRE(cmdArgsI["--force"].GetDataType() == DATA_TYPE::VOID);
+	REQUIRE_FALSE(cmdArgsI.HasParam("-f"));
+	REQUIRE_FALSE(cmdArgsI.HasParam("--gentle"));
+
+	REQUIRE(cmdArgsI["--name"].GetStringView() == "billybob");
+
+	// Type safety
+	REQUIRE(cmdArgsI["--ratio"].GetDataType() == DATA_TYPE::FLOAT);
+	REQUIRE(cmdArgsI["--ratio"].GetFloat64() == 5);
+
+	// Default value
+	REQUIRE(cmdArgsI["--width"].GetDataType() == DATA_TYPE::INT);
+	REQUIRE(cmdArgsI["--width"].GetInt32() == 800);
+
+	// Keys unknown to the schema still work, and respect runtime registrations
+	REQUIRE(cmdArgsI["--other"].GetDataType() == DATA_TYPE::LIST);
+	REQUIRE(cmdArgsI["--other"].GetList().size() == 2);
+
+	REQUIRE_THROWS_AS(cmdArgsI["--nope"], HazelnuppInvalidKeyException);
+
+	return;
+}
+
+// Tests that the constraints of a static schema are enforced
+TEST_CASE(__FILE__"/Static_Schema_Constraints", "[StaticSchema]")
+{
+	// Setup
+	CmdArgsInterface cmdArgsI(schema);
+	cmdArgsI.SetCrashOnFail(false);
+
+	const char* missing[] = { "/my/fake/path/wahoo.out", "-f" };
+	const char* incompatible[] = { "/my/fake/path/wahoo.out", "--name", "a", "-f", "-g" };
+	const char* mistyped[] = { "/my/fake/path/wahoo.out", "--name", "a", "--width", "wide" };
+
+	// Exercise, Verify
+	REQUIRE_THROWS_AS(
+		cmdArgsI.Parse(sizeof(missing) / sizeof(*missing), missing),
+		HazelnuppConstraintMissingValue
+	);
+
+	REQUIRE_THROWS_AS(
+		cmdArgsI.Parse(sizeof(incompatible) / sizeof(*incompatible), incompatible),
+		HazelnuppConstraintIncompatibleParameters
+	);
+
+	REQUIRE_THROWS_AS(
+		cmdArgsI.Parse(sizeof(mistyped) / sizeof(*mistyped), mistyped),
+		HazelnuppConstraintTypeMissmatch
+	);
+
+	return;
+}
+
+// Tests that the documentation includes the static schema
+TEST_CASE(__FILE__"/Static_Schema_Documentation", "[StaticSchema]")
+{
+	// Setup
+	CmdArgsInterface cmdArgsI(schema);
+
+	// Exercise
+	const std::string docs = cmdArgsI.GenerateDocumentation();
+
+	// Verify
+	REQUIRE(docs.find("--force   -f   incompatibilities=[--gentle]   Do it forcefully") != std::string::npos);
+	REQUIRE(docs.find("--width   -w   INT   default=['800']") != std::string::npos);
+	REQUIRE(docs.find("--name   STRING   [[REQUIRED]]    Your name") != std::string::npos);
+
+	return;
+}
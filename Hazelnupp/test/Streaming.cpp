@@ -0,0 +1,181 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/ParseResult.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <string>
+#include <vector>
+
+using namespace Hazelnp;
+
+// Tests that each parameter gets announced as soon as the next key arrives, not later
+TEST_CASE(__FILE__"/Callback_Fires_When_Complete", "[Streaming]")
+{
+	// Setup
+	Schema schema;
+	schema.RegisterAbbreviation("-o", "--output");
+	schema.Freeze();
+
+	ParseResult result(schema);
+
+	std::vector<std::string> announced;
+	result.SetParameterCallback([&](const Parameter& param)
+		{
+			announced.emplace_back(param.Key());
+			return;
+		});
+
+	// Exercise, Verify
+	result.BeginStream("/my/fake/path/wahoo.out");
+	REQUIRE(result.IsStreaming());
+
+	result.Push("--input");
+	result.Push("a.txt");
+	result.Push("b.txt");
+	REQUIRE(announced.empty());
+
+	result.Push("-o");
+	REQUIRE(announced == std::vector<std::string>({ "--input" }));
+	REQUIRE(result["--input"].GetList().size() == 2);
+
+	result.Push("out.txt");
+	result.Push("--input"); // Repeated keys only fire once
+	result.Push("c.txt");
+	REQUIRE(announced == std::vector<std::string>({ "--input", "--output" }));
+
+	result.EndStream();
+	REQUIRE_FALSE(result.IsStreaming());
+	REQUIRE(announced == std::vector<std::string>({ "--input", "--output" }));
+
+	REQUIRE(result.GetExecutableName() == "/my/fake/path/wahoo.out");
+	REQUIRE(result["--output"].GetStringView() == "out.txt");
+	REQUIRE(result["--input"].GetList()[1]->GetStringView() == "b.txt");
+
+	return;
+}
+
+// Tests that tokens may arrive in arbitrarily split chunks, and that the callers buffers can be reused right away
+TEST_CASE(__FILE__"/Chunks", "[Streaming]")
+{
+	// Setup
+	const std::string stream = "--files\n/data/a.bin\n/data/b.bin\n--\nignored\n--depth\n12\n--name\nbilly bob";
+
+	const Schema schema;
+
+	for (std::size_t chunkSize = 1; chunkSize <= stream.length(); chunkSize++)
+	{
+		ParseResult result(schema);
+
+		// Exercise
+		result.BeginStream();
+
+		std::string buffer;
+		for (std::size_t i = 0; i < stream.length(); i += chunkSize)
+		{
+			buffer.assign(stream, i, chunkSize);
+			result.PushChunk(buffer);
+			buffer.assign(buffer.length(), 'X');
+		}
+
+		result.EndStream();
+
+		// Verify
+		REQUIRE(result["--files"].GetList().size() == 2);
+		REQUIRE(result["--files"].GetList()[1]->GetStringView() == "/data/b.bin");
+		REQUIRE(result["--depth"].GetInt64() == 12);
+		REQUIRE(result["--name"].GetStringView() == "billy bob");
+	}
+
+	return;
+}
+
+// Tests that streams enforce the same constraints Parse() does
+TEST_CASE(__FILE__"/Constraints", "[Streaming]")
+{
+	// Setup
+	Schema schema;
+	schema.RegisterConstraint("--depth", ParamConstraint::TypeSafety(DATA_TYPE::INT));
+	schema.RegisterConstraint("--mode", ParamConstraint::Require({ "fast" }));
+	schema.RegisterConstraint("--user", ParamConstraint::Require());
+	schema.Freeze();
+
+	ParseResult result(schema);
+
+	// Exercise, Verify
+	// Types get enforced as soon as the parameter is complete
+	result.BeginStream();
+	result.Push("--depth");
+	result.Push("deep");
+	REQUIRE_THROWS_AS(result.Push("--user"), HazelnuppConstraintTypeMissmatch);
+
+	// Required parameters and defaults once the stream ends
+	result.BeginStream();
+	result.Push("--depth");
+	result.Push("12");
+	REQUIRE_THROWS_AS(result.EndStream(), HazelnuppConstraintMissingValue);
+
+	const std::string_view tokens[] = { "--user", "billybob" };
+	result.BeginStream();
+	result.Push(tokens, 2);
+	result.EndStream();
+	REQUIRE(result["--mode"].GetStringView() == "fast");
+	REQUIRE(result["--user"].GetStringView() == "billybob");
+
+	return;
+}
+
+// Tests that pushing to a stream that has not begun throws
+TEST_CASE(__FILE__"/Requires_Begin", "[Streaming]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--a"
+	});
+
+	const Schema schema;
+	ParseResult result(schema);
+
+	// Exercise, Verify
+	REQUIRE_THROWS_AS(result.Push("--a"), HazelnuppException);
+	REQUIRE_THROWS_AS(result.PushChunk("--a\n"), HazelnuppException);
+	REQUIRE_THROWS_AS(result.EndStream(), HazelnuppException);
+
+	// Parse() ends a stream aswell
+	result.BeginStream();
+	result.Parse(C_Ify(args));
+	REQUIRE_FALSE(result.IsStreaming());
+	REQUIRE_THROWS_AS(result.Push("--b"), HazelnuppException);
+
+	return;
+}
+
+// Tests that Parse() announces parameters aswell
+TEST_CASE(__FILE__"/Callback_During_Parse", "[Streaming]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--a",
+		"--b",
+		"1",
+		"--a"
+	});
+
+	const Schema schema;
+	ParseResult result(schema);
+
+	std::vector<std::string> announced;
+	result.SetParameterCallback([&](const Parameter& param)
+		{
+			announced.emplace_back(param.Key());
+			return;
+		});
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(announced == std::vector<std::string>({ "--a", "--b" }));
+
+	return;
+}
@@ -0,0 +1,206 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/ParseResult.h>
+#include <Hazelnupp/ListValue.h>
+#include <Hazelnupp/IntValue.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Hazelnp;
+
+// Tests that lists whose elements share a type are stored contiguously, and read just like before
+TEST_CASE(__FILE__"/Homogeneous_Lists", "[TypedLists]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--ints", "1", "-2", "0x10",
+		"--floats", "1.5", "-2.25", "3e2",
+		"--strings", "billy", "bob", "joe"
+	});
+
+	const Schema schema;
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result["--ints"].GetListElementType() == DATA_TYPE::INT);
+	const Span<const long long int> ints = result["--ints"].GetIntList();
+	REQUIRE(std::vector<long long int>(ints.begin(), ints.end()) == std::vector<long long int>({ 1, -2, 16 }));
+
+	REQUIRE(result["--floats"].GetListElementType() == DATA_TYPE::FLOAT);
+	const Span<const long double> floats = result["--floats"].GetFloatList();
+	REQUIRE(floats.size() == 3);
+	REQUIRE(floats[0] == 1.5);
+	REQUIRE(floats[1] == -2.25);
+	REQUIRE(floats[2] == 300);
+
+	REQUIRE(result["--strings"].GetListElementType() == DATA_TYPE::STRING);
+	const Span<const std::string_view> strings = result["--strings"].GetStringList();
+	REQUIRE(strings.size() == 3);
+	REQUIRE(strings[0] == "billy");
+	REQUIRE(strings[2] == "joe");
+
+	// The values get built on demand, and match
+	const std::vector<Value*>& list = result["--ints"].GetList();
+	REQUIRE(list.size() == 3);
+	REQUIRE(list[1]->GetDataType() == DATA_TYPE::INT);
+	REQUIRE(list[2]->GetInt64() == 16);
+	REQUIRE(&result["--ints"].GetList() == &list);
+	REQUIRE(result["--strings"].GetList()[1]->GetStringView() == "bob");
+	REQUIRE(result["--floats"].GetAsOsString() == "ListValue: [FloatValue: 1.5, FloatValue: -2.25, FloatValue: 300]");
+
+	// Typed accessors of another type do not convert
+	REQUIRE_THROWS_AS(result["--ints"].GetFloatList(), HazelnuppValueNotConvertibleException);
+	REQUIRE_THROWS_AS(result["--floats"].GetStringList(), HazelnuppValueNotConvertibleException);
+
+	return;
+}
+
+// Tests that lists of differing types keep their elements as values, and that edge cases still get a span
+TEST_CASE(__FILE__"/Mixed_And_Empty_Lists", "[TypedLists]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--mixed", "1", "2.5", "three",
+		"--empty",
+		"--single", "7",
+		"--void"
+	});
+
+	Schema schema;
+	schema.RegisterConstraint("--empty", ParamConstraint::TypeSafety(DATA_TYPE::LIST));
+	schema.RegisterConstraint("--single", ParamConstraint::TypeSafety(DATA_TYPE::LIST));
+	schema.Freeze();
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result["--mixed"].GetListElementType() == DATA_TYPE::VOID);
+	REQUIRE_THROWS_AS(result["--mixed"].GetIntList(), HazelnuppValueNotConvertibleException);
+	REQUIRE(result["--mixed"].GetList()[1]->GetFloat64() == 2.5);
+
+	REQUIRE(result["--empty"].GetIntList().empty());
+	REQUIRE(result["--empty"].GetStringList().empty());
+	REQUIRE(result["--empty"].GetList().empty());
+
+	REQUIRE(result["--single"].GetListElementType() == DATA_TYPE::INT);
+	REQUIRE(result["--single"].GetIntList()[0] == 7);
+
+	REQUIRE(result["--void"].GetFloatList().empty());
+	REQUIRE_THROWS_AS(result["--single"].GetList()[0]->GetIntList(), HazelnuppValueNotConvertibleException);
+
+	return;
+}
+
+// Tests that copies keep their contiguous elements, and that assembling a list by hand drops them
+TEST_CASE(__FILE__"/Copies", "[TypedLists]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out", "--ints", "1", "2", "3" });
+	const Schema schema;
+	ParseResult result(schema);
+	result.Parse(C_Ify(args));
+
+	// Exercise
+	std::unique_ptr<Value> copy(result["--ints"].Deepcopy());
+	const Span<const long long int> copied = copy->GetIntList();
+
+	// Verify
+	REQUIRE(copied.size() == 3);
+	REQUIRE(copied.data() != result["--ints"].GetIntList().data());
+	REQUIRE(copied[2] == 3);
+	REQUIRE(copy->GetList()[0]->GetInt64() == 1);
+
+	// Exercise
+	const IntValue four(4);
+	((ListValue*)copy.get())->AddValue(&four);
+
+	// Verify
+	REQUIRE(copy->GetListElementType() == DATA_TYPE::VOID);
+	REQUIRE_THROWS_AS(copy->GetIntList(), HazelnuppValueNotConvertibleException);
+	REQUIRE(copy->GetList().size() == 4);
+	REQUIRE(copy->GetList()[3]->GetInt64() == 4);
+
+	return;
+}
+
+// Tests that many threads may build the values of the same list at once, lazily converted or not
+TEST_CASE(__FILE__"/Concurrent_Element_Access", "[TypedLists]")
+{
+	// Setup
+	std::vector<std::string> numbers;
+	for (std::size_t i = 0; i < 20000; i++)
+		numbers.push_back(std::to_string(i));
+
+	ArgList args({ "/my/fake/path/wahoo.out", "--numbers" });
+	for (const std::string& number : numbers)
+		args.push_back(number.c_str());
+
+	const Schema schema;
+
+	for (const bool lazy : { false, true })
+	{
+		ParseResult result(schema);
+		result.SetLazyConversion(lazy);
+		result.Parse(C_Ify(args));
+
+		// Exercise
+		std::vector<std::thread> threads;
+		std::vector<long long int> sums(8, 0);
+		std::vector<const std::vector<Value*>*> lists(8, nullptr);
+
+		for (std::size_t t = 0; t < sums.size(); t++)
+			threads.emplace_back([&, t]
+				{
+					lists[t] = &result["--numbers"].GetList();
+					for (const Value* value : *lists[t])
+						sums[t] += value->GetInt64();
+
+					return;
+				});
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		// Verify
+		for (std::size_t t = 0; t < sums.size(); t++)
+		{
+			REQUIRE(sums[t] == 19999ll * 20000ll / 2);
+			REQUIRE(lists[t] == lists[0]);
+		}
+	}
+
+	return;
+}
+
+// Tests that streamed lists of strings survive the stream dropping its tokens
+TEST_CASE(__FILE__"/Streams", "[TypedLists]")
+{
+	// Setup
+	const Schema schema;
+	ParseResult result(schema);
+
+	// Exercise
+	result.BeginStream();
+	result.PushChunk("--names\nbilly\nbob\n--ids\n4\n5\n");
+	result.EndStream();
+
+	// Verify
+	const Span<const std::string_view> names = result["--names"].GetStringList();
+	REQUIRE(names.size() == 2);
+	REQUIRE(names[0] == "billy");
+	REQUIRE(names[1] == "bob");
+	REQUIRE(result["--ids"].GetIntList()[1] == 5);
+
+	return;
+}
@@ -0,0 +1,295 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <Hazelnupp/KeyIndex.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace Hazelnp;
+
+namespace
+{
+	// Will make keys known through each way there is
+	void RegisterKeys(Schema& schema)
+	{
+		schema.RegisterConstraint("--verbose", ParamConstraint());
+		schema.RegisterDescription("--version", "Prints the version");
+		schema.RegisterAbbreviation("-o", "--output");
+		schema.RegisterEnvironmentVariable("--threads", "APP_THREADS");
+		schema.SetMatchUniquePrefixes(true);
+
+		return;
+	}
+}
+
+// Tests that unique prefixes of known keys resolve to them
+TEST_CASE(__FILE__"/Unique_Prefixes", "[UniquePrefixes]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out", "--verb", "--vers", "--out", "a.txt", "--th", "4", "--unknown", "5" });
+
+	Schema schema;
+	RegisterKeys(schema);
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result.HasParam("--verbose"));
+	REQUIRE(result.HasParam("--version"));
+	REQUIRE(result["--output"].GetStringView() == "a.txt");
+	REQUIRE(result["--threads"].GetInt64() == 4);
+
+	// Keys nothing is known about stay as they are
+	REQUIRE(result["--unknown"].GetInt64() == 5);
+	REQUIRE_FALSE(result.HasParam("--verb"));
+
+	return;
+}
+
+// Tests that prefixes of several keys throw, and that exact keys win
+TEST_CASE(__FILE__"/Ambiguous_And_Exact_Keys", "[UniquePrefixes]")
+{
+	// Setup
+	ArgList ambiguous({ "/my/fake/path/wahoo.out", "--ver" });
+	ArgList exact({ "/my/fake/path/wahoo.out", "--verb", "--ver" });
+
+	Schema schema;
+	RegisterKeys(schema);
+
+	ParseResult result(schema);
+
+	// Exercise, Verify
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(ambiguous)), HazelnuppAmbiguousKeyException);
+
+	try
+	{
+		result.Parse(C_Ify(ambiguous));
+	}
+	catch (const HazelnuppAmbiguousKeyException& e)
+	{
+		REQUIRE(e.What() == "Parameter --ver is ambiguous. It may stand for --verbose, --version.");
+	}
+
+	// Exercise
+	// Now --verb and --ver are keys of their own
+	schema.RegisterConstraint("--verb", ParamConstraint());
+	schema.RegisterDescription("--ver", "Prints the version, briefly");
+	result.Parse(C_Ify(exact));
+
+	// Verify
+	REQUIRE(result.HasParam("--verb"));
+	REQUIRE(result.HasParam("--ver"));
+	REQUIRE_FALSE(result.HasParam("--verbose"));
+	REQUIRE_FALSE(result.HasParam("--version"));
+
+	return;
+}
+
+// Tests that args beginning with "--" are matched even following a key taking exactly one value, as they are keys aswell
+TEST_CASE(__FILE__"/Keys_Following_Keys_Taking_A_Value", "[UniquePrefixes]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out", "--name", "--verb" });
+	ArgList abbreviated({ "/my/fake/path/wahoo.out", "--name", "--v" });
+
+	Schema schema;
+	RegisterKeys(schema);
+	schema.RegisterConstraint("--name", ParamConstraint::TypeSafety(DATA_TYPE::STRING));
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result.HasParam("--name"));
+	REQUIRE(result.HasParam("--verbose"));
+	REQUIRE_FALSE(result.HasParam("--verb"));
+
+	// Exercise
+	// Abbreviations get expanded there aswell
+	schema.RegisterAbbreviation("--v", "--verbose");
+	result.Parse(C_Ify(abbreviated));
+
+	// Verify
+	REQUIRE(result.HasParam("--name"));
+	REQUIRE(result.HasParam("--verbose"));
+	REQUIRE_FALSE(result.HasParam("--v"));
+
+	return;
+}
+
+// Tests that abbreviations beginning with "--" are expanded, instead of matched as a prefix
+TEST_CASE(__FILE__"/Abbreviations_Go_First", "[UniquePrefixes]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out", "--v", "--o", "a.txt" });
+
+	Schema schema;
+	RegisterKeys(schema);
+	schema.RegisterAbbreviation("--v", "--verbose");
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	// It is a prefix of --verbose and --version aswell
+	REQUIRE(result.HasParam("--verbose"));
+	REQUIRE_FALSE(result.HasParam("--version"));
+	REQUIRE_FALSE(result.HasParam("--v"));
+
+	// Others still get matched
+	REQUIRE(result["--output"].GetStringView() == "a.txt");
+
+	return;
+}
+
+// Tests that prefixes are only matched on request, and follow changes to the schema
+TEST_CASE(__FILE__"/Opt_In_And_Schema_Changes", "[UniquePrefixes]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out", "--verb" });
+
+	Schema schema;
+	schema.RegisterConstraint("--verbose", ParamConstraint());
+
+	ParseResult result(schema);
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result.HasParam("--verb"));
+	REQUIRE_FALSE(result.HasParam("--verbose"));
+
+	// Exercise
+	schema.SetMatchUniquePrefixes(true);
+	result.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(result.HasParam("--verbose"));
+
+	// Exercise, Verify
+	schema.RegisterConstraint("--verbatim", ParamConstraint());
+	REQUIRE_THROWS_AS(result.Parse(C_Ify(args)), HazelnuppAmbiguousKeyException);
+
+	schema.ClearConstraints();
+	result.Parse(C_Ify(args));
+	REQUIRE(result.HasParam("--verb"));
+
+	// Frozen schemas got indexed beforehand
+	schema.RegisterConstraint("--verbose", ParamConstraint());
+	schema.Freeze();
+	result.Parse(C_Ify(args));
+	REQUIRE(result.HasParam("--verbose"));
+
+	return;
+}
+
+// Tests that keys of a static schema get matched aswell, alongside abbreviations, streams and value arity
+TEST_CASE(__FILE__"/Static_Schema_And_Streams", "[UniquePrefixes]")
+{
+	// Setup
+	static constexpr ParamSpec specs[] = {
+		ParamSpec("--jobs").AddAbbreviation("-j").AddTypeSafety(DATA_TYPE::INT),
+		ParamSpec("--name").AddTypeSafety(DATA_TYPE::STRING)
+	};
+	static constexpr StaticSchema staticSchema(specs);
+
+	ArgList args({ "/my/fake/path/wahoo.out", "--jo", "8", "--na", "-j", "--verbo" });
+
+	CmdArgsInterface cmdArgsI(staticSchema);
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.RegisterConstraint("--verbose", ParamConstraint());
+	cmdArgsI.RegisterConstraint("--verbatim", ParamConstraint());
+	cmdArgsI.SetMatchUniquePrefixes(true);
+
+	// Exercise
+	cmdArgsI.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(cmdArgsI["--jobs"].GetInt64() == 8);
+
+	// The arg following a key taking exactly one value is its value
+	REQUIRE(cmdArgsI["--name"].GetStringView() == "-j");
+	REQUIRE(cmdArgsI.HasParam("--verbose"));
+
+	// Exercise, Verify
+	ArgList ambiguous({ "/my/fake/path/wahoo.out", "--verb" });
+	REQUIRE_THROWS_AS(cmdArgsI.Parse(C_Ify(ambiguous)), HazelnuppAmbiguousKeyException);
+
+	// Exercise
+	Schema schema;
+	schema.SetStaticSchema(staticSchema);
+	schema.RegisterConstraint("--verbose", ParamConstraint());
+	schema.SetMatchUniquePrefixes(true);
+
+	ParseResult result(schema);
+	result.BeginStream("/my/fake/path/wahoo.out");
+	for (const char* token : { "--verbo", "--j", "3" })
+	{
+		// The callers buffer is transient
+		std::string buffer = token;
+		result.Push(buffer);
+		buffer.assign(buffer.length(), '#');
+	}
+	result.EndStream();
+
+	// Verify
+	REQUIRE(result.HasParam("--verbose"));
+	REQUIRE(result["--jobs"].GetInt64() == 3);
+
+	return;
+}
+
+// Tests that the index finds exactly the keys beginning with a prefix, going by a plain scan over thousands of them
+TEST_CASE(__FILE__"/Index_Matches_Scan", "[UniquePrefixes]")
+{
+	// Setup
+	std::vector<std::string> keys;
+	for (std::size_t i = 0; i < 3000; i++)
+		keys.push_back("--" + std::string(1, (char)('a' + i % 5)) + "-" + std::to_string(i * 7 % 1000) + ((i % 3 == 0) ? "x" : ""));
+
+	keys.push_back("--");
+	keys.push_back("--a");
+	keys.push_back("--a-1");
+
+	std::vector<std::string_view> views(keys.begin(), keys.end());
+
+	Internal::KeyIndex index;
+	index.Build(views);
+
+	std::vector<std::string> prefixes = { "", "-", "--", "--a", "--a-", "--a-1", "--a-10", "--b-99", "--e-999x", "--f", "--a-1000", "--c-5" };
+	for (std::size_t i = 0; i < 200; i++)
+		prefixes.push_back(keys[i * 13].substr(0, 2 + i % 6));
+
+	for (const std::string& prefix : prefixes)
+	{
+		// Exercise
+		const Span<const std::string_view> found = index.FindPrefixed(prefix);
+
+		// Verify
+		std::vector<std::string> expected;
+		for (const std::string& key : keys)
+			if (key.compare(0, prefix.length(), prefix) == 0)
+				expected.push_back(key);
+
+		std::sort(expected.begin(), expected.end());
+		expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+		REQUIRE(std::vector<std::string>(found.begin(), found.end()) == expected);
+	}
+
+	// Exercise, Verify
+	Internal::KeyIndex empty;
+	REQUIRE(empty.FindPrefixed("--a").empty());
+
+	return;
+}
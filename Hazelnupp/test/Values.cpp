@@ -0,0 +1,115 @@
+#include "Catch2.h"
+#include <Hazelnupp/IntValue.h>
+#include <Hazelnupp/FloatValue.h>
+#include <Hazelnupp/StringValue.h>
+#include <Hazelnupp/VoidValue.h>
+#include <Hazelnupp/ListValue.h>
+#include <Hazelnupp/HazelnuppException.h>
+#include <type_traits>
+
+using namespace Hazelnp;
+
+// Tests that values are compact, and the facades add nothing on top
+TEST_CASE(__FILE__"/Values_Are_Compact", "[Values]")
+{
+	// Verify
+	REQUIRE_FALSE(std::is_polymorphic<Value>::value);
+	REQUIRE(sizeof(Value) <= 32);
+	REQUIRE(sizeof(IntValue) == sizeof(Value));
+	REQUIRE(sizeof(FloatValue) == sizeof(Value));
+	REQUIRE(sizeof(StringValue) == sizeof(Value));
+	REQUIRE(sizeof(VoidValue) == sizeof(Value));
+	REQUIRE(sizeof(ListValue) == sizeof(Value));
+
+	return;
+}
+
+// Tests that short strings are stored inline, and long strings are copied aswell
+TEST_CASE(__FILE__"/String_Storage", "[Values]")
+{
+	// Setup
+	const std::string shortStr = "peter";
+	const std::string longStr = "this string is way too long to be stored inline";
+
+	// Exercise
+	const StringValue shortVal(shortStr);
+	const StringValue longVal(longStr);
+	const StringValue shortCopy(shortVal);
+	StringValue longCopy(std::string_view("x"), false);
+	longCopy = longVal;
+
+	// Verify
+	REQUIRE(shortVal.IsOwning());
+	REQUIRE(shortVal.GetStringView().data() != shortStr.data());
+	REQUIRE(shortVal.GetStringView() == shortStr);
+	REQUIRE(longVal.IsOwning());
+	REQUIRE(longVal.GetStringView() == longStr);
+	REQUIRE(shortCopy.GetString() == shortStr);
+	REQUIRE(longCopy.GetString() == longStr);
+	REQUIRE(longCopy.GetStringView().data() != longVal.GetStringView().data());
+
+	return;
+}
+
+// Tests that the generic Value& accessors still behave like they used to
+TEST_CASE(__FILE__"/Value_Reference_Accessors", "[Values]")
+{
+	// Setup
+	const IntValue intVal(39);
+	const FloatValue floatVal(-3.5);
+	const StringValue stringVal("billybob");
+	const VoidValue voidVal;
+
+	const Value& intRef = intVal;
+	const Value& floatRef = floatVal;
+	const Value& stringRef = stringVal;
+	const Value& voidRef = voidVal;
+
+	// Verify
+	REQUIRE(intRef.GetDataType() == DATA_TYPE::INT);
+	REQUIRE(intRef.GetInt64() == 39);
+	REQUIRE(intRef.GetFloat32() == 39.0);
+	REQUIRE(intRef.GetString() == "39");
+
+	REQUIRE(floatRef.GetDataType() == DATA_TYPE::FLOAT);
+	REQUIRE(floatRef.GetInt32() == -3);
+	REQUIRE(floatRef.GetFloat64() == -3.5);
+
+	REQUIRE(stringRef.GetDataType() == DATA_TYPE::STRING);
+	REQUIRE(stringRef.GetString() == "billybob");
+	REQUIRE_THROWS_AS(stringRef.GetInt64(), HazelnuppValueNotConvertibleException);
+	REQUIRE_THROWS_AS(stringRef.GetList(), HazelnuppValueNotConvertibleException);
+
+	REQUIRE(voidRef.GetDataType() == DATA_TYPE::VOID);
+	REQUIRE(voidRef.GetString() == "");
+	REQUIRE(voidRef.GetList().size() == 0);
+	REQUIRE_THROWS_AS(voidRef.GetFloat64(), HazelnuppValueNotConvertibleException);
+
+	return;
+}
+
+// Tests that copies of lists are deep, and keep the facade types
+TEST_CASE(__FILE__"/List_Copies_Are_Deep", "[Values]")
+{
+	// Setup
+	ListValue list;
+	const IntValue intVal(5);
+	const StringValue stringVal("this string is way too long to be stored inline");
+	list.AddValue(&intVal);
+	list.AddValue(&stringVal);
+
+	// Exercise
+	Value* copy = list.Deepcopy();
+
+	// Verify
+	REQUIRE(copy->GetDataType() == DATA_TYPE::LIST);
+	REQUIRE(copy->GetList().size() == 2);
+	REQUIRE(copy->GetList()[0] != list.GetList()[0]);
+	REQUIRE(copy->GetList()[0]->GetInt64() == 5);
+	REQUIRE(copy->GetList()[1]->GetString() == stringVal.GetString());
+	REQUIRE(((ListValue*)copy)->IsOwning());
+
+	delete copy;
+
+	return;
+}
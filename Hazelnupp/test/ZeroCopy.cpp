@@ -0,0 +1,174 @@
+#include "Catch2.h"
+#include "helper.h"
+#include <Hazelnupp/CmdArgsInterface.h>
+#include <Hazelnupp/StringValue.h>
+#include <string>
+#include <vector>
+
+using namespace Hazelnp;
+
+// Tests that string values reference the callers argv, if borrowArgv is set
+TEST_CASE(__FILE__"/BorrowArgv_References_Argv", "[ZeroCopy]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"--name",
+		"peter",
+		"--fruits",
+		"apple",
+		"banana"
+	});
+
+	// Exercise
+	CmdArgsInterface cmdArgsI;
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.SetBorrowArgv(true);
+	cmdArgsI.Parse(C_Ify(args));
+
+	// Verify
+	REQUIRE(cmdArgsI["--name"].GetStringView().data() == args[2]);
+	REQUIRE(cmdArgsI["--fruits"].GetList()[0]->GetStringView().data() == args[4]);
+	REQUIRE(cmdArgsI["--fruits"].GetList()[1]->GetStringView().data() == args[5]);
+
+	return;
+}
+
+// Tests that, per default, values stay valid even if the callers argv does not
+TEST_CASE(__FILE__"/Owned_Buffer_Outlives_Argv", "[ZeroCopy]")
+{
+	// Setup
+	std::string name = "peter";
+	std::string key = "--name";
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		key.c_str(),
+		name.c_str()
+	});
+
+	// Exercise
+	CmdArgsInterface cmdArgsI;
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.Parse(C_Ify(args));
+
+	name = "xxxxx";
+	key = "xxxxxx";
+
+	// Verify
+	REQUIRE(cmdArgsI.HasParam("--name"));
+	REQUIRE(cmdArgsI["--name"].GetStringView() == "peter");
+	REQUIRE(cmdArgsI["--name"].GetString() == "peter");
+
+	return;
+}
+
+// Tests that parameters created from abbreviations and default values survive clearing the registrations
+TEST_CASE(__FILE__"/Registrations_Can_Be_Cleared_After_Parsing", "[ZeroCopy]")
+{
+	// Setup
+	ArgList args({
+		"/my/fake/path/wahoo.out",
+		"-n",
+		"peter"
+	});
+
+	CmdArgsInterface cmdArgsI;
+	cmdArgsI.SetCrashOnFail(false);
+	cmdArgsI.SetBorrowArgv(true);
+	cmdArgsI.RegisterAbbreviation("-n", "--name");
+	cmdArgsI.RegisterConstraint("--fruit", ParamConstraint::Require({ "banana" }));
+
+	// Exercise
+	cmdArgsI.Parse(C_Ify(args));
+	cmdArgsI.ClearAbbreviations();
+	cmdArgsI.ClearConstraints();
+
+	// Verify
+	REQUIRE(cmdArgsI["--name"].GetStringView() == "peter");
+	REQUIRE(cmdArgsI["--fruit"].GetStringView() == "banana");
+
+	return;
+}
+
+// Tests that string values can be constructed owning, and referencing
+TEST_CASE(__FILE__"/StringValue_Ownership", "[ZeroCopy]")
+{
+	// Setup
+	const std::string str = "billybob";
+
+	// Exercise
+	StringValue owning(str);
+	StringValue referencing(std::string_view(str), false);
+	Value* copy = referencing.Deepcopy();
+
+	// Verify
+	REQUIRE(owning.IsOwning());
+	REQUIRE(owning.GetValueView().data() != str.data());
+	REQUIRE_FALSE(referencing.IsOwning());
+	REQUIRE(referencing.GetValueView().data() == str.data());
+
+	// Copies always own their string
+	REQUIRE(((StringValue*)copy)->IsOwning());
+	REQUIRE(copy->GetStringView().data() != str.data());
+	REQUIRE(copy->GetStringView() == "billybob");
+
+	delete copy;
+
+	return;
+}
+
+// Tests that GetValue() and Key() hand out std::strings, that stay the same until the next parse
+TEST_CASE(__FILE__"/String_References", "[ZeroCopy]")
+{
+	// Setup
+	ArgList args({ "/my/fake/path/wahoo.out", "--name", "a-name-too-long-to-be-stored-inline", "--lazy", "peter" });
+	ArgList other({ "/my/fake/path/wahoo.out", "--name", "bob" });
+
+	Schema schema;
+	schema.RegisterConstraint("--lazy", ParamConstraint::TypeSafety(DATA_TYPE::STRING));
+
+	ParseResult result(schema);
+	result.SetLazyConversion(true);
+
+	std::vector<const std::string*> keys;
+	result.SetParameterCallback([&](const Parameter& param)
+		{
+			keys.push_back(&param.Key());
+			return;
+		});
+
+	// Exercise
+	result.Parse(C_Ify(args));
+
+	const std::string& name = ((const StringValue&)result["--name"]).GetValue();
+	const std::string& lazy = ((const StringValue&)result["--lazy"]).GetValue();
+
+	// Verify
+	REQUIRE(name == "a-name-too-long-to-be-stored-inline");
+	REQUIRE(lazy == "peter");
+	REQUIRE(&((const StringValue&)result["--name"]).GetValue() == &name);
+	REQUIRE(((const StringValue&)result["--name"]).GetValueView().data() == result["--name"].GetStringView().data());
+
+	REQUIRE(keys.size() == 2);
+	REQUIRE(*keys[0] == "--name");
+	REQUIRE(*keys[1] == "--lazy");
+
+	// Exercise
+	StringValue standalone(std::string_view("billybob"), false);
+	Parameter param("--standalone", &standalone);
+
+	// Verify
+	REQUIRE(standalone.GetValue() == "billybob");
+	REQUIRE(&standalone.GetValue() == &standalone.GetValue());
+	REQUIRE(param.Key() == "--standalone");
+	REQUIRE(param.KeyView() == "--standalone");
+
+	// Exercise
+	result.Parse(C_Ify(other));
+
+	// Verify
+	REQUIRE(((const StringValue&)result["--name"]).GetValue() == "bob");
+	REQUIRE(*keys[2] == "--name");
+
+	return;
+}
@@ -1,6 +1,56 @@
 #pragma once
 #include <vector>
+#include <string>
+#include <memory_resource>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 
 #define C_Ify(vector) vector.size(), vector.data()
 
 typedef std::vector<const char*> ArgList;
+
+// Will write a file into the temporary directory of the tests, and return its path. name may contain directories.
+inline std::string WriteTestFile(const std::string& name, const std::string& contents)
+{
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "hazelnupp_tests" / name;
+	std::filesystem::create_directories(path.parent_path());
+
+	std::ofstream(path, std::ios::binary) << contents;
+
+	return path.string();
+}
+
+inline std::string ReadTestFile(const std::string& path)
+{
+	std::stringstream ss;
+	ss << std::ifstream(path, std::ios::binary).rdbuf();
+	return ss.str();
+}
+
+// Memory resource keeping track of what is currently allocated from it
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+	std::size_t numAllocations = 0;
+	std::size_t bytesInUse = 0;
+
+protected:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		numAllocations++;
+		bytesInUse += bytes;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+	{
+		bytesInUse -= bytes;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+};